@@ -0,0 +1,23 @@
+#!/bin/bash
+# Compares the parsing time, the time to free the AST and the peak memory usage of two compiler builds (e.g. before and
+# after a change to how the AST is allocated), on a large generated input.
+# Usage: benchmarks/ast_allocation.sh <baseline compiler binary> [compiler binary] [number of functions]
+set -e
+
+BASELINE=${1:?"Usage: $0 <baseline compiler binary> [compiler binary] [number of functions]"}
+COMPILER=${2:-./compiler/cmake-build/compiler}
+NUM_FUNCTIONS=${3:-20000}
+
+INPUT=$(mktemp --suffix=.crs)
+trap 'rm -f "$INPUT" output.o' EXIT
+
+"$(dirname "$0")/generate_functions.sh" "$NUM_FUNCTIONS" > "$INPUT"
+
+echo "Input: $NUM_FUNCTIONS functions, $(wc -l < "$INPUT") lines"
+
+for binary in "$BASELINE" "$COMPILER"; do
+    echo
+    echo "$binary"
+    /usr/bin/time -f "Max resident set size: %M KB" "$binary" -ftime-report "$INPUT" 2>&1 >/dev/null |
+        grep -E "Parsing|Binding|Type checking|Flow checking|Freeing the AST|Total|Max resident"
+done
@@ -0,0 +1,25 @@
+#!/bin/bash
+# Writes a large input for the benchmarks to stdout: functions with deeply nested and chained assignment expressions,
+# which are the slowest to predict for the ANTLR parser
+# Usage: benchmarks/generate_functions.sh <number of functions>
+set -e
+
+NUM_FUNCTIONS=${1:?"Usage: $0 <number of functions>"}
+
+# Note: The functions are not named f<i>, as f32 and f64 are type keywords
+for ((i = 0; i < NUM_FUNCTIONS; i++)); do
+    cat << CRS
+fn fun$i(a : i32, b : i32) i32 {
+    var x : i32 = a * (b + 3) - (a - b) * 2;
+    var y : i32 = x;
+    x = y = x + ((a * b) + (a - (b * (x + y))));
+    x += y * (a + b) - ((x - y) * (a + 1));
+    if x > y {
+        y = x * 2 + a;
+    } else {
+        y = y - (x + b);
+    }
+    return x + y;
+}
+CRS
+done
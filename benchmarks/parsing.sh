@@ -0,0 +1,26 @@
+#!/bin/bash
+# Compares the parsing time of the hand-written parser with the ANTLR parser, both in two-stage (SLL, then LL on
+# failure) and LL-only modes, on a large generated input.
+# Usage: benchmarks/parsing.sh [number of functions] [compiler binary]
+set -e
+
+NUM_FUNCTIONS=${1:-5000}
+COMPILER=${2:-./compiler/cmake-build/compiler}
+
+INPUT=$(mktemp --suffix=.crs)
+trap 'rm -f "$INPUT" output.o' EXIT
+
+"$(dirname "$0")/generate_functions.sh" "$NUM_FUNCTIONS" > "$INPUT"
+
+echo "Input: $NUM_FUNCTIONS functions, $(wc -l < "$INPUT") lines"
+
+echo
+echo "hand-written parser"
+"$COMPILER" -ftime-report "$INPUT" 2>&1 >/dev/null | grep -E "Lexing|Parsing|Total"
+
+for mode in true false; do
+    echo
+    echo "-fantlr-parser -ftwo-stage-parse=$mode"
+    "$COMPILER" -ftime-report -fantlr-parser -ftwo-stage-parse=$mode "$INPUT" 2>&1 >/dev/null |
+        grep -E "Lexing|Parsing|AST generation|Total"
+done
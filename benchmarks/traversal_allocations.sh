@@ -0,0 +1,22 @@
+#!/bin/bash
+# Compares the number of heap allocations of two compiler builds (e.g. before and after a change to how the AST is
+# traversed) when compiling a large generated input. Requires valgrind.
+# Usage: benchmarks/traversal_allocations.sh <baseline compiler binary> [compiler binary] [number of functions]
+set -e
+
+BASELINE=${1:?"Usage: $0 <baseline compiler binary> [compiler binary] [number of functions]"}
+COMPILER=${2:-./compiler/cmake-build/compiler}
+NUM_FUNCTIONS=${3:-5000}
+
+INPUT=$(mktemp --suffix=.crs)
+trap 'rm -f "$INPUT" output.o' EXIT
+
+"$(dirname "$0")/generate_functions.sh" "$NUM_FUNCTIONS" > "$INPUT"
+
+echo "Input: $NUM_FUNCTIONS functions, $(wc -l < "$INPUT") lines"
+
+for binary in "$BASELINE" "$COMPILER"; do
+    echo
+    echo "$binary"
+    valgrind --tool=memcheck --leak-check=no "$binary" "$INPUT" 2>&1 | grep -E "total heap usage"
+done
@@ -0,0 +1,14 @@
+#include "ASTArena.h"
+
+namespace Ceres::AST {
+
+ASTArena::~ASTArena()
+{
+    // Note: The nodes may still own heap memory (identifiers, vectors of children...), so the destructors have to be
+    // run before the allocator releases the slabs
+    for (auto* node : nodes) {
+        node->destroy();
+    }
+}
+
+} // namespace Ceres::AST
@@ -0,0 +1,39 @@
+#ifndef COMPILER_ASTARENA_H
+#define COMPILER_ASTARENA_H
+
+#include "nodes/Node.h"
+#include <llvm/Support/Allocator.h>
+#include <utility>
+#include <vector>
+
+namespace Ceres::AST {
+
+// Bump allocator holding all the nodes of a compilation unit. Nodes are never freed individually, and they refer to
+// their children with plain pointers: destroying the arena runs the destructors of all the nodes in a single pass and
+// releases the memory slab by slab, instead of walking the tree and freeing each node
+class ASTArena {
+    llvm::BumpPtrAllocator allocator;
+    std::vector<Node*> nodes;
+
+public:
+    ASTArena() = default;
+    ~ASTArena();
+
+    ASTArena(ASTArena const&) = delete;
+    ASTArena& operator=(ASTArena const&) = delete;
+
+    template<typename T, typename... Args> T* create(Args&&... args)
+    {
+        static_assert(std::is_base_of_v<Node, T>, "Only AST nodes can be allocated in the arena");
+        auto* node = new (allocator.Allocate<T>()) T(std::forward<Args>(args)...);
+        nodes.push_back(node);
+        return node;
+    }
+
+    size_t getNumNodes() const { return nodes.size(); }
+    size_t getBytesAllocated() const { return allocator.getBytesAllocated(); }
+};
+
+} // namespace Ceres::AST
+
+#endif // COMPILER_ASTARENA_H
@@ -5,7 +5,7 @@
 #include <iterator>
 
 namespace Ceres::AST {
-std::string ASTStringifierVisitor::doVisitAssignmentExpression(AssignmentExpression& expr)
+std::string ASTStringifierVisitor::visitAssignmentExpression(AssignmentExpression& expr)
 {
     std::string opStr;
 
@@ -52,7 +52,7 @@ std::string ASTStringifierVisitor::doVisitAssignmentExpression(AssignmentExpress
         visit(*expr.expressionRHS));
 }
 
-std::string ASTStringifierVisitor::doVisitBinaryOperationExpression(BinaryOperationExpression& expr)
+std::string ASTStringifierVisitor::visitBinaryOperationExpression(BinaryOperationExpression& expr)
 {
     std::string opStr;
 
@@ -119,7 +119,7 @@ std::string ASTStringifierVisitor::doVisitBinaryOperationExpression(BinaryOperat
     return fmt::format("(BinaryExpression BinOp='{}' lhs='{}' rhs={})", opStr, visit(*expr.left), visit(*expr.right));
 }
 
-std::string ASTStringifierVisitor::doVisitBlockStatement(BlockStatement& block)
+std::string ASTStringifierVisitor::visitBlockStatement(BlockStatement& block)
 {
     std::string res;
     bool first = true;
@@ -136,16 +136,16 @@ std::string ASTStringifierVisitor::doVisitBlockStatement(BlockStatement& block)
     return fmt::format("(BlockStatement '{}')", res);
 }
 
-std::string ASTStringifierVisitor::doVisitBoolLiteral(BoolLiteralExpression& lit)
+std::string ASTStringifierVisitor::visitBoolLiteralExpression(BoolLiteralExpression& lit)
 {
     return fmt::format("(BoolLiteralExpression {})", BoolLiteralExpression::toStringBoolLiteralValue(lit.value));
 }
 
-std::string ASTStringifierVisitor::doVisitCommaExpression(CommaExpression& expr)
+std::string ASTStringifierVisitor::visitCommaExpression(CommaExpression& expr)
 {
     std::string res = "(CommaExpression ";
     bool first = true;
-    for (auto& childPtr : expr.getChildren()) {
+    for (auto* childPtr : expr.getChildren()) {
         if (first) {
             first = false;
         } else {
@@ -156,11 +156,11 @@ std::string ASTStringifierVisitor::doVisitCommaExpression(CommaExpression& expr)
     return res + ")";
 }
 
-std::string ASTStringifierVisitor::doVisitCompilationUnit(CompilationUnit& unit)
+std::string ASTStringifierVisitor::visitCompilationUnit(CompilationUnit& unit)
 {
     std::string res;
     bool first = true;
-    for (auto& childPtr : unit.getChildren()) {
+    for (auto* childPtr : unit.getChildren()) {
         if (first) {
             first = false;
         } else {
@@ -171,12 +171,12 @@ std::string ASTStringifierVisitor::doVisitCompilationUnit(CompilationUnit& unit)
     return fmt::format("(CompilationUnit '{}')", res);
 }
 
-std::string ASTStringifierVisitor::doVisitExpressionStatement(ExpressionStatement& stm)
+std::string ASTStringifierVisitor::visitExpressionStatement(ExpressionStatement& stm)
 {
     return fmt::format("(ExpressionStatement '{}')", visit(*stm.expression));
 }
 
-std::string ASTStringifierVisitor::doVisitFloatLiteralExpression(FloatLiteralExpression& expr)
+std::string ASTStringifierVisitor::visitFloatLiteralExpression(FloatLiteralExpression& expr)
 {
     std::string baseString;
     switch (expr.base) {
@@ -193,7 +193,7 @@ std::string ASTStringifierVisitor::doVisitFloatLiteralExpression(FloatLiteralExp
     return fmt::format("(FloatLiteral base='{}' str='{}')", baseString, expr.str);
 }
 
-std::string ASTStringifierVisitor::doVisitForStatement(ForStatement& stm)
+std::string ASTStringifierVisitor::visitForStatement(ForStatement& stm)
 {
     std::string res;
 
@@ -221,10 +221,14 @@ std::string ASTStringifierVisitor::doVisitForStatement(ForStatement& stm)
         res += "'";
     }
 
+    if (!stm.hints.empty()) {
+        res += fmt::format(" hints='{}'", stm.hints.toString());
+    }
+
     return fmt::format("(ForStatement{} body='{}')", res, visit(*stm.body));
 }
 
-std::string ASTStringifierVisitor::doVisitFunctionCallExpression(FunctionCallExpression& expr)
+std::string ASTStringifierVisitor::visitFunctionCallExpression(FunctionCallExpression& expr)
 {
     std::string args;
     bool first = true;
@@ -240,7 +244,7 @@ std::string ASTStringifierVisitor::doVisitFunctionCallExpression(FunctionCallExp
     return fmt::format("(FunctionCallExpression id='{}' args='{}')", expr.identifier->identifier, args);
 }
 
-std::string ASTStringifierVisitor::doVisitFunctionDefinition(FunctionDefinition& def)
+std::string ASTStringifierVisitor::visitFunctionDefinition(FunctionDefinition& def)
 {
     std::string paramsString;
     bool first = true;
@@ -255,10 +259,13 @@ std::string ASTStringifierVisitor::doVisitFunctionDefinition(FunctionDefinition&
         paramsString += paramString;
     }
 
-    return fmt::format("(FunctionDefinition id='{}', params='{}' body='{}')", def.id, paramsString, visit(*def.block));
+    std::string attributes
+        = def.attributes.empty() ? "" : fmt::format(" attributes='{}'", def.attributes.toString());
+    return fmt::format("(FunctionDefinition id='{}', params='{}'{} body='{}')", def.id, paramsString, attributes,
+        visit(*def.block));
 }
 
-std::string ASTStringifierVisitor::doVisitFunctionDeclaration(FunctionDeclaration& dec)
+std::string ASTStringifierVisitor::visitFunctionDeclaration(FunctionDeclaration& dec)
 {
     std::string paramsString;
     bool first = true;
@@ -276,12 +283,12 @@ std::string ASTStringifierVisitor::doVisitFunctionDeclaration(FunctionDeclaratio
     return fmt::format("(FunctionDeclaration id='{}', params='{}')", dec.functionName, paramsString);
 }
 
-std::string ASTStringifierVisitor::doVisitIdentifierExpression(IdentifierExpression& expr)
+std::string ASTStringifierVisitor::visitIdentifierExpression(IdentifierExpression& expr)
 {
     return fmt::format("(IdentifierExpression id='{}')", expr.identifier);
 }
 
-std::string ASTStringifierVisitor::doVisitIfStatement(IfStatement& stm)
+std::string ASTStringifierVisitor::visitIfStatement(IfStatement& stm)
 {
     if (stm.maybeElseStatement != nullptr) {
         return fmt::format("(IfStatement cond='{}' body='{}' else='{}')", visit(*stm.condition), visit(*stm.thenBlock),
@@ -291,7 +298,7 @@ std::string ASTStringifierVisitor::doVisitIfStatement(IfStatement& stm)
     return fmt::format("(IfStatement cond='{}' body='{}')", visit(*stm.condition), visit(*stm.thenBlock));
 }
 
-std::string ASTStringifierVisitor::doVisitIntLiteralExpression(IntLiteralExpression& expr)
+std::string ASTStringifierVisitor::visitIntLiteralExpression(IntLiteralExpression& expr)
 {
     std::string baseString;
 
@@ -317,19 +324,19 @@ std::string ASTStringifierVisitor::doVisitIntLiteralExpression(IntLiteralExpress
     return fmt::format("(IntLiteralExpression base='{}' text='{}' type='{}')", baseString, expr.str, typeString);
 }
 
-std::string ASTStringifierVisitor::doVisitPostfixExpression(PostfixExpression& expr)
+std::string ASTStringifierVisitor::visitPostfixExpression(PostfixExpression& expr)
 {
     std::string opStr = postfixOpToString(expr.op);
     return fmt::format("(PostfixExpression op='{}' expr='{}')", opStr, visit(*expr.expr));
 }
 
-std::string ASTStringifierVisitor::doVisitPrefixExpression(PrefixExpression& expr)
+std::string ASTStringifierVisitor::visitPrefixExpression(PrefixExpression& expr)
 {
     std::string opStr = prefixOpToString(expr.op);
     return fmt::format("(PrefixExpression op='{}' expr='{}')", opStr, visit(*expr.expr));
 }
 
-std::string ASTStringifierVisitor::doVisitReturnStatement(ReturnStatement& stm)
+std::string ASTStringifierVisitor::visitReturnStatement(ReturnStatement& stm)
 {
     std::string expr;
     if (stm.expr != nullptr) {
@@ -339,7 +346,7 @@ std::string ASTStringifierVisitor::doVisitReturnStatement(ReturnStatement& stm)
     return fmt::format("(ReturnStatement expr='{}')", expr);
 }
 
-std::string ASTStringifierVisitor::doVisitVariableDeclaration(VariableDeclaration& decl)
+std::string ASTStringifierVisitor::visitVariableDeclaration(VariableDeclaration& decl)
 {
     std::string vis = decl.visibility.kind == Typing::VariableVisibility::Private ? "private" : "public";
     std::string scope = decl.scope == VariableScope::Local ? "local" : "global";
@@ -356,12 +363,13 @@ std::string ASTStringifierVisitor::doVisitVariableDeclaration(VariableDeclaratio
         vis, scope, constn, decl.type->toString(), decl.id);
 }
 
-std::string ASTStringifierVisitor::doVisitWhileStatement(WhileStatement& stm)
+std::string ASTStringifierVisitor::visitWhileStatement(WhileStatement& stm)
 {
-    return fmt::format("(WhileStatement cond='{}' body='{}')", visit(*stm.condition), visit(*stm.body));
+    std::string hints = stm.hints.empty() ? "" : fmt::format(" hints='{}'", stm.hints.toString());
+    return fmt::format("(WhileStatement cond='{}'{} body='{}')", visit(*stm.condition), hints, visit(*stm.body));
 }
 
-std::string ASTStringifierVisitor::doVisitCastExpression(CastExpression& expr)
+std::string ASTStringifierVisitor::visitCastExpression(CastExpression& expr)
 {
     return fmt::format("(CastExpression destType='{}' expr='{}')", expr.destinationType->toString(), visit(*expr.expr));
 }
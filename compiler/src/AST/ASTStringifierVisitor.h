@@ -1,38 +1,39 @@
 #ifndef COMPILER_ASTSTRINGIFIERVISITOR_H
 #define COMPILER_ASTSTRINGIFIERVISITOR_H
 
-#include "AbstractReturningASTVisitor.hpp"
+#include "StaticASTVisitor.hpp"
 #include <string>
 
 namespace Ceres::AST {
 
-class ASTStringifierVisitor : public AbstractReturningASTVisitor<std::string> {
-
-    std::string doVisitAssignmentExpression(AssignmentExpression& expr) override;
-    std::string doVisitBinaryOperationExpression(BinaryOperationExpression& expr) override;
-    std::string doVisitBlockStatement(BlockStatement& stm) override;
-    std::string doVisitBoolLiteral(BoolLiteralExpression& lit) override;
-    std::string doVisitCommaExpression(CommaExpression& expr) override;
-    std::string doVisitCompilationUnit(CompilationUnit& unit) override;
-    std::string doVisitExpressionStatement(ExpressionStatement& stm) override;
-    std::string doVisitFloatLiteralExpression(FloatLiteralExpression& expr) override;
-    std::string doVisitForStatement(ForStatement& stm) override;
-    std::string doVisitFunctionCallExpression(FunctionCallExpression& expr) override;
-    std::string doVisitFunctionDefinition(FunctionDefinition& def) override;
-    std::string doVisitFunctionDeclaration(FunctionDeclaration& def) override;
+class ASTStringifierVisitor : public StaticASTVisitor<ASTStringifierVisitor, std::string> {
+    friend class StaticASTVisitor<ASTStringifierVisitor, std::string>;
+
+    std::string visitAssignmentExpression(AssignmentExpression& expr);
+    std::string visitBinaryOperationExpression(BinaryOperationExpression& expr);
+    std::string visitBlockStatement(BlockStatement& stm);
+    std::string visitBoolLiteralExpression(BoolLiteralExpression& lit);
+    std::string visitCommaExpression(CommaExpression& expr);
+    std::string visitCompilationUnit(CompilationUnit& unit);
+    std::string visitExpressionStatement(ExpressionStatement& stm);
+    std::string visitFloatLiteralExpression(FloatLiteralExpression& expr);
+    std::string visitForStatement(ForStatement& stm);
+    std::string visitFunctionCallExpression(FunctionCallExpression& expr);
+    std::string visitFunctionDefinition(FunctionDefinition& def);
+    std::string visitFunctionDeclaration(FunctionDeclaration& def);
 
 public:
-    std::string doVisitCastExpression(CastExpression& expr) override;
+    std::string visitCastExpression(CastExpression& expr);
 
 private:
-    std::string doVisitIdentifierExpression(IdentifierExpression& expr) override;
-    std::string doVisitIfStatement(IfStatement& stm) override;
-    std::string doVisitIntLiteralExpression(IntLiteralExpression& expr) override;
-    std::string doVisitPostfixExpression(PostfixExpression& expr) override;
-    std::string doVisitPrefixExpression(PrefixExpression& expr) override;
-    std::string doVisitReturnStatement(ReturnStatement& stm) override;
-    std::string doVisitVariableDeclaration(VariableDeclaration& decl) override;
-    std::string doVisitWhileStatement(WhileStatement& stm) override;
+    std::string visitIdentifierExpression(IdentifierExpression& expr);
+    std::string visitIfStatement(IfStatement& stm);
+    std::string visitIntLiteralExpression(IntLiteralExpression& expr);
+    std::string visitPostfixExpression(PostfixExpression& expr);
+    std::string visitPrefixExpression(PrefixExpression& expr);
+    std::string visitReturnStatement(ReturnStatement& stm);
+    std::string visitVariableDeclaration(VariableDeclaration& decl);
+    std::string visitWhileStatement(WhileStatement& stm);
 };
 
 } // namespace Ceres::AST
@@ -2,6 +2,8 @@
 #include "../Diagnostics/Diagnostics.h"
 #include "../Typing/BinaryOperation.h"
 #include "../Typing/Type.h"
+#include "../utils/SourceManager.h"
+#include "../utils/Symbol.h"
 #include "../utils/log.hpp"
 #include "CeresLexer.h"
 #include "CeresParser.h"
@@ -26,6 +28,7 @@
 #include "nodes/Statements/ReturnStatement.h"
 #include "nodes/Statements/VariableDeclaration.h"
 #include "nodes/Statements/WhileStatement.h"
+#include <llvm/Support/Casting.h>
 #include <memory>
 #include <optional>
 
@@ -43,7 +46,9 @@ public:
 };
 
 AntlrASTGeneratorVisitor::AntlrASTGeneratorVisitor(unsigned int fileId)
-    : fileId(fileId)
+    : arena(std::make_unique<ASTArena>())
+    , fileStartOffset(SourceManager::get().getFileStartOffset(fileId))
+    , fileId(fileId)
 {
 }
 
@@ -116,35 +121,53 @@ SourceSpan AntlrASTGeneratorVisitor::getSourceSpan(
 
 SourceSpan AntlrASTGeneratorVisitor::getSourceSpan(antlr4::Token const* tok) const
 {
-    return { fileId, tok->getStartIndex(), tok->getStopIndex() };
+    return { fileStartOffset + (uint32_t)tok->getStartIndex(), fileStartOffset + (uint32_t)tok->getStopIndex() };
 }
 
 SourceSpan AntlrASTGeneratorVisitor::getSourceSpan(antlr4::Token const* startToken, antlr4::Token const* endToken) const
 {
-    return { fileId, startToken->getStartIndex(), endToken->getStopIndex() };
+    return { fileStartOffset + (uint32_t)startToken->getStartIndex(),
+        fileStartOffset + (uint32_t)endToken->getStopIndex() };
+}
+
+template<class T> T AntlrASTGeneratorVisitor::createAttributes(CeresParser::AttributesContext* ctx)
+{
+    ASSERT(ctx != nullptr);
+    checkException(*ctx);
+
+    T attributes;
+    for (auto* attributeContext : ctx->attribute()) {
+        checkException(*attributeContext);
+        ASSERT(attributeContext->name != nullptr);
+        ASSERT(attributeContext->argument != nullptr);
+
+        attributes.add(attributeContext->name->getText(), getSourceSpan(attributeContext->name),
+            attributeContext->argument->getText(), getSourceSpan(attributeContext->argument));
+    }
+    return attributes;
 }
 
 std::any AntlrASTGeneratorVisitor::visitCompilationUnit(CeresParser::CompilationUnitContext* ctx)
 {
     ASSERT(ctx != nullptr);
     if (ctx->exception != nullptr) {
-        return new CompilationUnit(getSourceSpan(*ctx));
+        return new CompilationUnit(getSourceSpan(*ctx), std::move(arena));
     }
 
-    std::vector<std::unique_ptr<FunctionDefinition>> functionDefinitions;
-    std::vector<std::unique_ptr<FunctionDeclaration>> functionDeclarations;
-    std::vector<std::unique_ptr<VariableDeclaration>> variableDeclarations;
+    std::vector<FunctionDefinition*> functionDefinitions;
+    std::vector<FunctionDeclaration*> functionDeclarations;
+    std::vector<VariableDeclaration*> variableDeclarations;
 
     functionDefinitions.reserve(ctx->globalFunctionDefinition().size());
 
     for (auto* funDefinitionContextPtr : ctx->globalFunctionDefinition()) {
         try {
             auto res = visit(funDefinitionContextPtr);
-            auto funDef = std::unique_ptr<FunctionDefinition>(std::any_cast<FunctionDefinition*>(res));
+            auto funDef = std::any_cast<FunctionDefinition*>(res);
 
             ASSERT(funDef != nullptr);
 
-            functionDefinitions.push_back(std::move(funDef));
+            functionDefinitions.push_back(funDef);
         } catch (ParseException&) {
             // Log::debug("Parse exception in function definition caught");
         }
@@ -155,11 +178,11 @@ std::any AntlrASTGeneratorVisitor::visitCompilationUnit(CeresParser::Compilation
     for (auto* funDeclarationCtxPtr : ctx->externFunDeclaration()) {
         try {
             auto res = visit(funDeclarationCtxPtr);
-            auto funDec = std::unique_ptr<FunctionDeclaration>(std::any_cast<FunctionDeclaration*>(res));
+            auto funDec = std::any_cast<FunctionDeclaration*>(res);
 
             ASSERT(funDec != nullptr);
 
-            functionDeclarations.push_back(std::move(funDec));
+            functionDeclarations.push_back(funDec);
         } catch (ParseException&) {
             // Log::debug("Parse exception in function definition caught");
         }
@@ -170,18 +193,18 @@ std::any AntlrASTGeneratorVisitor::visitCompilationUnit(CeresParser::Compilation
     for (auto* varDefinitionContextPtr : ctx->globalVarDeclaration()) {
         try {
             auto res = visit(varDefinitionContextPtr);
-            auto varDef = std::unique_ptr<VariableDeclaration>(std::any_cast<VariableDeclaration*>(res));
+            auto varDef = std::any_cast<VariableDeclaration*>(res);
 
             ASSERT(varDef != nullptr);
 
-            variableDeclarations.push_back(std::move(varDef));
+            variableDeclarations.push_back(varDef);
         } catch (ParseException&) {
             // Log::debug("Parse exception in variable definition caught");
         }
     }
 
-    return new CompilationUnit(getSourceSpan(*ctx), std::move(functionDefinitions), std::move(functionDeclarations),
-        std::move(variableDeclarations));
+    return new CompilationUnit(getSourceSpan(*ctx), std::move(arena), std::move(functionDefinitions),
+        std::move(functionDeclarations), std::move(variableDeclarations));
 }
 
 std::any AntlrASTGeneratorVisitor::visitGlobalVarDeclaration(CeresParser::GlobalVarDeclarationContext* ctx)
@@ -211,6 +234,10 @@ std::any AntlrASTGeneratorVisitor::visitGlobalFunctionDefinition(CeresParser::Gl
     checkException(*ctx);
 
     auto* functionDefinition = std::any_cast<FunctionDefinition*>(visit(ctx->functionDefinition()));
+    if (ctx->attributes() != nullptr) {
+        functionDefinition->attributes = createAttributes<FunctionAttributes>(ctx->attributes());
+    }
+
     if (ctx->PUB() != nullptr) {
         functionDefinition->visibility = FunctionVisibility::Public;
     } else {
@@ -231,7 +258,7 @@ std::any AntlrASTGeneratorVisitor::visitFunctionDefinition(CeresParser::Function
     SourceSpan identifierSourceSpan = getSourceSpan(*ctx->IDENTIFIER());
     SourceSpan returnTypeSourceSpan = SourceSpan::createInvalidSpan();
 
-    auto function_name = std::any_cast<std::string>(visit(ctx->IDENTIFIER()));
+    auto function_name = Symbol::get(std::any_cast<std::string>(visit(ctx->IDENTIFIER())));
     Type* returnType;
 
     if (ctx->type() != nullptr) {
@@ -249,13 +276,10 @@ std::any AntlrASTGeneratorVisitor::visitFunctionDefinition(CeresParser::Function
 
     auto* statement = std::any_cast<Statement*>(visit(ctx->block()));
 
-    // TODO: Remove all dynamic_cast by using an LLVM-like RTTI. Maybe check
-    // casts only in debug, as they
-    //          should always be correct.
-    auto block = std::unique_ptr<Ceres::AST::BlockStatement>(dynamic_cast<Ceres::AST::BlockStatement*>(statement));
+    auto* block = llvm::cast<BlockStatement>(statement);
 
-    return new FunctionDefinition(getSourceSpan(*ctx), FunctionVisibility::Private, function_name,
-        std::move(parameters), returnType, std::move(block), returnTypeSourceSpan, identifierSourceSpan);
+    return arena->create<FunctionDefinition>(getSourceSpan(*ctx), FunctionVisibility::Private, function_name,
+        std::move(parameters), returnType, block, returnTypeSourceSpan, identifierSourceSpan);
 }
 
 std::any AntlrASTGeneratorVisitor::visitExternFunDeclaration(CeresParser::ExternFunDeclarationContext* ctx)
@@ -267,7 +291,7 @@ std::any AntlrASTGeneratorVisitor::visitExternFunDeclaration(CeresParser::Extern
     SourceSpan identifierSourceSpan = getSourceSpan(*ctx->IDENTIFIER());
     SourceSpan returnTypeSourceSpan = SourceSpan::createInvalidSpan();
 
-    auto function_name = std::any_cast<std::string>(visit(ctx->IDENTIFIER()));
+    auto function_name = Symbol::get(std::any_cast<std::string>(visit(ctx->IDENTIFIER())));
     Type* returnType;
 
     if (ctx->type() != nullptr) {
@@ -283,7 +307,7 @@ std::any AntlrASTGeneratorVisitor::visitExternFunDeclaration(CeresParser::Extern
         parameters = std::any_cast<std::vector<FunctionParameter>>(visit(ctx->formalParameters()));
     }
 
-    return new FunctionDeclaration(getSourceSpan(*ctx), FunctionVisibility::Extern, function_name,
+    return arena->create<FunctionDeclaration>(getSourceSpan(*ctx), FunctionVisibility::Extern, function_name,
         std::move(parameters), returnType, returnTypeSourceSpan, identifierSourceSpan);
 }
 
@@ -326,7 +350,7 @@ std::any AntlrASTGeneratorVisitor::visitParameter(CeresParser::ParameterContext*
     SourceSpan typeSourceSpan = getSourceSpan(*ctx->type());
     SourceSpan nameSourceSpan = getSourceSpan(*ctx->IDENTIFIER());
 
-    auto parameterName = std::any_cast<std::string>(visit(ctx->IDENTIFIER()));
+    auto parameterName = Symbol::get(std::any_cast<std::string>(visit(ctx->IDENTIFIER())));
     return FunctionParameter { type, parameterName, constness, typeSourceSpan, nameSourceSpan };
 }
 
@@ -335,22 +359,22 @@ std::any AntlrASTGeneratorVisitor::visitBlock(CeresParser::BlockContext* ctx)
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    std::vector<std::unique_ptr<Statement>> statements;
+    std::vector<Statement*> statements;
 
     for (auto* statementContextPtr : ctx->statement()) {
         try {
-            auto res = std::unique_ptr<Statement>(std::any_cast<Statement*>(visit(statementContextPtr)));
+            auto res = std::any_cast<Statement*>(visit(statementContextPtr));
             if (res != nullptr) {
                 // Note: the statement can be a nullptr, for empty statements
                 // such as ';;'
-                statements.push_back(std::move(res));
+                statements.push_back(res);
             }
         } catch (ParseException&) {
             // Log::debug("Parse exception in block caught");
         }
     }
 
-    return static_cast<Statement*>(new BlockStatement(getSourceSpan(*ctx), std::move(statements)));
+    return static_cast<Statement*>(arena->create<BlockStatement>(getSourceSpan(*ctx), std::move(statements)));
 }
 
 std::any AntlrASTGeneratorVisitor::visitType(CeresParser::TypeContext* ctx)
@@ -407,9 +431,9 @@ std::any AntlrASTGeneratorVisitor::visitVarDeclaration(CeresParser::VarDeclarati
 
     ASSERT(ctx->IDENTIFIER() != nullptr);
 
-    std::unique_ptr<Expression> initializer_expression = nullptr;
+    Expression* initializer_expression = nullptr;
     if (ctx->expression() != nullptr) {
-        initializer_expression.reset(std::any_cast<Expression*>(visit(ctx->expression())));
+        initializer_expression = std::any_cast<Expression*>(visit(ctx->expression()));
     }
 
     Typing::Constness constness;
@@ -430,9 +454,9 @@ std::any AntlrASTGeneratorVisitor::visitVarDeclaration(CeresParser::VarDeclarati
         type = NotYetInferredType::get(NotYetInferredKind::VariableDeclaration);
     }
 
-    auto var_name = std::any_cast<std::string>(visit(ctx->IDENTIFIER()));
+    auto var_name = Symbol::get(std::any_cast<std::string>(visit(ctx->IDENTIFIER())));
 
-    return new VariableDeclaration(getSourceSpan(*ctx), std::move(initializer_expression),
+    return arena->create<VariableDeclaration>(getSourceSpan(*ctx), initializer_expression,
         Typing::VariableVisibility::Private, constness, VariableScope::Local, type, var_name, typeSourceSpan,
         getSourceSpan(*ctx->IDENTIFIER()));
 }
@@ -446,7 +470,7 @@ std::any AntlrASTGeneratorVisitor::visitReturnStatement(CeresParser::ReturnState
     if (ctx->expression() != nullptr) {
         expr = std::any_cast<Expression*>(visit(ctx->expression()));
     }
-    return static_cast<Statement*>(new ReturnStatement(getSourceSpan(*ctx), std::unique_ptr<Expression>(expr)));
+    return static_cast<Statement*>(arena->create<ReturnStatement>(getSourceSpan(*ctx), expr));
 }
 
 std::any AntlrASTGeneratorVisitor::visitIfStatement(CeresParser::IfStatementContext* ctx)
@@ -454,22 +478,21 @@ std::any AntlrASTGeneratorVisitor::visitIfStatement(CeresParser::IfStatementCont
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    auto condition = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->expression())));
-    auto thenBlock = std::unique_ptr<BlockStatement>(
-        dynamic_cast<BlockStatement*>(std::any_cast<Statement*>(visit(ctx->block(0)))));
+    auto condition = std::any_cast<Expression*>(visit(ctx->expression()));
+    auto* thenBlock = llvm::cast<BlockStatement>(std::any_cast<Statement*>(visit(ctx->block(0))));
 
-    std::unique_ptr<Statement> elseStatement = nullptr;
+    Statement* elseStatement = nullptr;
     if (ctx->else_block != nullptr) {
-        elseStatement.reset(std::any_cast<Statement*>(visit(ctx->else_block)));
+        elseStatement = std::any_cast<Statement*>(visit(ctx->else_block));
     } else if (ctx->else_if != nullptr) {
-        elseStatement.reset(std::any_cast<Statement*>(visit(ctx->else_if)));
+        elseStatement = std::any_cast<Statement*>(visit(ctx->else_if));
     }
 
     ASSERT(condition != nullptr);
     ASSERT(thenBlock != nullptr);
 
     return static_cast<Statement*>(
-        new IfStatement(getSourceSpan(*ctx), std::move(condition), std::move(thenBlock), std::move(elseStatement)));
+        arena->create<IfStatement>(getSourceSpan(*ctx), condition, thenBlock, elseStatement));
 }
 
 std::any AntlrASTGeneratorVisitor::visitWhileStatement(CeresParser::WhileStatementContext* ctx)
@@ -477,14 +500,17 @@ std::any AntlrASTGeneratorVisitor::visitWhileStatement(CeresParser::WhileStateme
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    auto condition = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->expression())));
-    auto body = std::unique_ptr<BlockStatement>(
-        dynamic_cast<BlockStatement*>(std::any_cast<Statement*>(visit(ctx->block()))));
+    auto condition = std::any_cast<Expression*>(visit(ctx->expression()));
+    auto* body = llvm::cast<BlockStatement>(std::any_cast<Statement*>(visit(ctx->block())));
 
     ASSERT(condition != nullptr);
     ASSERT(body != nullptr);
 
-    return static_cast<Statement*>(new WhileStatement(getSourceSpan(*ctx), std::move(condition), std::move(body)));
+    auto* whileStatement = arena->create<WhileStatement>(getSourceSpan(*ctx), condition, body);
+    if (ctx->attributes() != nullptr) {
+        whileStatement->hints = createAttributes<LoopHints>(ctx->attributes());
+    }
+    return static_cast<Statement*>(whileStatement);
 }
 
 std::any AntlrASTGeneratorVisitor::visitForStatement(CeresParser::ForStatementContext* ctx)
@@ -492,34 +518,45 @@ std::any AntlrASTGeneratorVisitor::visitForStatement(CeresParser::ForStatementCo
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    std::unique_ptr<VariableDeclaration> varDecl = nullptr;
-    std::unique_ptr<Expression> declExpr = nullptr;
-    std::unique_ptr<Expression> condExpr = nullptr;
-    std::unique_ptr<Expression> updateExpr = nullptr;
+    VariableDeclaration* varDecl = nullptr;
+    Expression* declExpr = nullptr;
+    Expression* condExpr = nullptr;
+    Expression* updateExpr = nullptr;
 
-    auto body = std::unique_ptr<BlockStatement>(
-        dynamic_cast<BlockStatement*>(std::any_cast<Statement*>(visit(ctx->block()))));
+    auto* body = llvm::cast<BlockStatement>(std::any_cast<Statement*>(visit(ctx->block())));
 
     if (ctx->varDeclaration() != nullptr) {
-        varDecl.reset(std::any_cast<VariableDeclaration*>(visit(ctx->varDeclaration())));
+        varDecl = std::any_cast<VariableDeclaration*>(visit(ctx->varDeclaration()));
     } else if (ctx->decl_expr != nullptr) {
-        declExpr.reset(std::any_cast<Expression*>(visit(ctx->decl_expr)));
+        declExpr = std::any_cast<Expression*>(visit(ctx->decl_expr));
     }
 
     if (ctx->cond_expr != nullptr) {
-        condExpr.reset(std::any_cast<Expression*>(visit(ctx->cond_expr)));
+        condExpr = std::any_cast<Expression*>(visit(ctx->cond_expr));
     }
 
     if (ctx->update_expr != nullptr) {
-        updateExpr.reset(std::any_cast<Expression*>(visit(ctx->update_expr)));
+        updateExpr = std::any_cast<Expression*>(visit(ctx->update_expr));
     }
 
     ASSERT(body != nullptr);
 
-    return static_cast<Statement*>(new ForStatement(getSourceSpan(*ctx), std::move(varDecl), std::move(declExpr),
-        std::move(condExpr), std::move(updateExpr), std::move(body)));
+    auto* forStatement
+        = arena->create<ForStatement>(getSourceSpan(*ctx), varDecl, declExpr, condExpr, updateExpr, body);
+    if (ctx->attributes() != nullptr) {
+        forStatement->hints = createAttributes<LoopHints>(ctx->attributes());
+    }
+    return static_cast<Statement*>(forStatement);
+}
+
+std::any AntlrASTGeneratorVisitor::visitAttributes(CeresParser::AttributesContext* ctx)
+{
+    // Note: Which attributes are valid depends on what they are attached to, so they are built by createAttributes
+    ASSERT_NOT_REACHED();
 }
 
+std::any AntlrASTGeneratorVisitor::visitAttribute(CeresParser::AttributeContext* ctx) { ASSERT_NOT_REACHED(); }
+
 std::any AntlrASTGeneratorVisitor::visitAssignment_expr(CeresParser::Assignment_exprContext* ctx)
 {
     ASSERT(ctx != nullptr);
@@ -530,8 +567,8 @@ std::any AntlrASTGeneratorVisitor::visitAssignment_expr(CeresParser::Assignment_
     ASSERT(binaryOpToken != nullptr);
     ASSERT(ctx->assignmentExpression().size() == 2);
 
-    auto LHS_expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->assignmentExpression()[0])));
-    auto RHS_expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->assignmentExpression()[1])));
+    auto LHS_expr = std::any_cast<Expression*>(visit(ctx->assignmentExpression()[0]));
+    auto RHS_expr = std::any_cast<Expression*>(visit(ctx->assignmentExpression()[1]));
 
     std::optional<Typing::BinaryOperation> binaryOp {};
     switch (binaryOpToken->getType()) {
@@ -574,8 +611,8 @@ std::any AntlrASTGeneratorVisitor::visitAssignment_expr(CeresParser::Assignment_
         break;
     }
 
-    return static_cast<Expression*>(new AssignmentExpression(
-        getSourceSpan(*ctx), binaryOp, std::move(LHS_expr), std::move(RHS_expr), getSourceSpan(binaryOpToken)));
+    return static_cast<Expression*>(arena->create<AssignmentExpression>(
+        getSourceSpan(*ctx), binaryOp, LHS_expr, RHS_expr, getSourceSpan(binaryOpToken)));
 }
 
 std::any AntlrASTGeneratorVisitor::visitPostfix_expr(CeresParser::Postfix_exprContext* ctx)
@@ -583,7 +620,7 @@ std::any AntlrASTGeneratorVisitor::visitPostfix_expr(CeresParser::Postfix_exprCo
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    auto expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->assignmentExpression())));
+    auto expr = std::any_cast<Expression*>(visit(ctx->assignmentExpression()));
 
     PostfixOp op;
     ASSERT(ctx->postfix != nullptr);
@@ -600,7 +637,7 @@ std::any AntlrASTGeneratorVisitor::visitPostfix_expr(CeresParser::Postfix_exprCo
     }
 
     return static_cast<Expression*>(
-        new PostfixExpression(getSourceSpan(*ctx), op, std::move(expr), getSourceSpan(ctx->postfix)));
+        arena->create<PostfixExpression>(getSourceSpan(*ctx), op, expr, getSourceSpan(ctx->postfix)));
 }
 
 std::any AntlrASTGeneratorVisitor::visitPrefix_expr(CeresParser::Prefix_exprContext* ctx)
@@ -608,7 +645,7 @@ std::any AntlrASTGeneratorVisitor::visitPrefix_expr(CeresParser::Prefix_exprCont
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    auto expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->assignmentExpression())));
+    auto expr = std::any_cast<Expression*>(visit(ctx->assignmentExpression()));
 
     PrefixOp op;
     ASSERT(ctx->prefix != nullptr);
@@ -638,7 +675,7 @@ std::any AntlrASTGeneratorVisitor::visitPrefix_expr(CeresParser::Prefix_exprCont
     }
 
     return static_cast<Expression*>(
-        new PrefixExpression(getSourceSpan(*ctx), op, std::move(expr), getSourceSpan(ctx->prefix)));
+        arena->create<PrefixExpression>(getSourceSpan(*ctx), op, expr, getSourceSpan(ctx->prefix)));
 }
 
 std::any AntlrASTGeneratorVisitor::visitFunction_call_expr(CeresParser::Function_call_exprContext* ctx)
@@ -733,11 +770,11 @@ std::any AntlrASTGeneratorVisitor::visitBinary_op_expr(CeresParser::Binary_op_ex
         }
     }
 
-    auto left = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->assignmentExpression(0))));
-    auto right = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->assignmentExpression(1))));
+    auto left = std::any_cast<Expression*>(visit(ctx->assignmentExpression(0)));
+    auto right = std::any_cast<Expression*>(visit(ctx->assignmentExpression(1)));
 
     return static_cast<Expression*>(
-        new BinaryOperationExpression(getSourceSpan(*ctx), std::move(left), std::move(right), op, opSpan));
+        arena->create<BinaryOperationExpression>(getSourceSpan(*ctx), left, right, op, opSpan));
 }
 
 std::any AntlrASTGeneratorVisitor::visitExpression(CeresParser::ExpressionContext* ctx)
@@ -754,16 +791,16 @@ std::any AntlrASTGeneratorVisitor::visitExpression(CeresParser::ExpressionContex
         return visit(ctx->assignmentExpression()[0]);
     } else {
         // Create a comma expression node and return it
-        std::vector<std::unique_ptr<Expression>> expressions;
+        std::vector<Expression*> expressions;
 
         for (auto exprCtx : ctx->assignmentExpression()) {
-            auto expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(exprCtx)));
+            auto expr = std::any_cast<Expression*>(visit(exprCtx));
             ASSERT(expr != nullptr);
 
-            expressions.push_back(std::move(expr));
+            expressions.push_back(expr);
         }
 
-        return static_cast<Expression*>(new CommaExpression(getSourceSpan(*ctx), std::move(expressions)));
+        return static_cast<Expression*>(arena->create<CommaExpression>(getSourceSpan(*ctx), std::move(expressions)));
     }
 }
 
@@ -781,6 +818,10 @@ std::any AntlrASTGeneratorVisitor::visitFn_def_statement(CeresParser::Fn_def_sta
     checkException(*ctx);
 
     auto* functionDefinition = std::any_cast<FunctionDefinition*>(visit(ctx->functionDefinition()));
+    if (ctx->attributes() != nullptr) {
+        functionDefinition->attributes = createAttributes<FunctionAttributes>(ctx->attributes());
+        functionDefinition->sourceSpan = getSourceSpan(*ctx);
+    }
     return static_cast<Statement*>(functionDefinition);
 }
 
@@ -791,9 +832,9 @@ std::any AntlrASTGeneratorVisitor::visitId_expr(CeresParser::Id_exprContext* ctx
 
     ASSERT(ctx->IDENTIFIER() != nullptr);
 
-    auto id = std::any_cast<std::string>(visit(ctx->IDENTIFIER()));
+    auto id = Symbol::get(std::any_cast<std::string>(visit(ctx->IDENTIFIER())));
 
-    return static_cast<Expression*>(new IdentifierExpression(getSourceSpan(*ctx), id));
+    return static_cast<Expression*>(arena->create<IdentifierExpression>(getSourceSpan(*ctx), id));
 }
 
 std::any AntlrASTGeneratorVisitor::visitInt_literal_expr(CeresParser::Int_literal_exprContext* ctx)
@@ -830,7 +871,7 @@ std::any AntlrASTGeneratorVisitor::visitBool_literal_expr(CeresParser::Bool_lite
         Log::panic("Bool literal has a value different that 'true' or 'false': {}", text_literal);
     }
 
-    return static_cast<Expression*>(new BoolLiteralExpression(getSourceSpan(*ctx), value));
+    return static_cast<Expression*>(arena->create<BoolLiteralExpression>(getSourceSpan(*ctx), value));
 }
 
 std::any AntlrASTGeneratorVisitor::visitIntLiteral(CeresParser::IntLiteralContext* ctx)
@@ -865,7 +906,7 @@ std::any AntlrASTGeneratorVisitor::visitIntLiteral(CeresParser::IntLiteralContex
         NOT_IMPLEMENTED();
     }
 
-    return static_cast<Expression*>(new IntLiteralExpression(getSourceSpan(*ctx), base, type, str));
+    return static_cast<Expression*>(arena->create<IntLiteralExpression>(getSourceSpan(*ctx), base, type, str));
 }
 
 std::any AntlrASTGeneratorVisitor::visitFloatLiteral(CeresParser::FloatLiteralContext* ctx)
@@ -897,7 +938,7 @@ std::any AntlrASTGeneratorVisitor::visitFloatLiteral(CeresParser::FloatLiteralCo
         NOT_IMPLEMENTED();
     }
 
-    return static_cast<Expression*>(new FloatLiteralExpression(getSourceSpan(*ctx), base, type, str));
+    return static_cast<Expression*>(arena->create<FloatLiteralExpression>(getSourceSpan(*ctx), base, type, str));
 }
 
 std::any AntlrASTGeneratorVisitor::visitFunctionCall(CeresParser::FunctionCallContext* ctx)
@@ -907,22 +948,25 @@ std::any AntlrASTGeneratorVisitor::visitFunctionCall(CeresParser::FunctionCallCo
 
     ASSERT(ctx->IDENTIFIER() != nullptr);
 
-    std::vector<std::unique_ptr<Expression>> args;
+    std::vector<Expression*> args;
     args.reserve(ctx->assignmentExpression().size());
 
     for (auto assignmentExpressionContextPtr : ctx->assignmentExpression()) {
         auto res = visit(assignmentExpressionContextPtr);
-        auto arg = std::unique_ptr<Expression>(std::any_cast<Expression*>(res));
+        auto arg = std::any_cast<Expression*>(res);
 
         ASSERT(arg != nullptr);
 
-        args.push_back(std::move(arg));
+        args.push_back(arg);
     }
 
-    auto function_identifier = std::any_cast<std::string>(visit(ctx->IDENTIFIER()));
+    auto function_identifier = Symbol::get(std::any_cast<std::string>(visit(ctx->IDENTIFIER())));
 
-    return static_cast<Expression*>(new FunctionCallExpression(
-        getSourceSpan(*ctx), function_identifier, std::move(args), getSourceSpan(*ctx->IDENTIFIER())));
+    auto* identifier
+        = arena->create<IdentifierExpression>(getSourceSpan(*ctx->IDENTIFIER()), function_identifier);
+
+    return static_cast<Expression*>(
+        arena->create<FunctionCallExpression>(getSourceSpan(*ctx), identifier, std::move(args)));
 }
 
 std::any AntlrASTGeneratorVisitor::visitVar_decl_statement(CeresParser::Var_decl_statementContext* ctx)
@@ -948,9 +992,9 @@ std::any AntlrASTGeneratorVisitor::visitExpr_statement(CeresParser::Expr_stateme
     ASSERT(ctx != nullptr);
     checkException(*ctx);
 
-    auto expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->expression())));
+    auto expr = std::any_cast<Expression*>(visit(ctx->expression()));
 
-    return static_cast<Statement*>(new ExpressionStatement(getSourceSpan(*ctx), std::move(expr)));
+    return static_cast<Statement*>(arena->create<ExpressionStatement>(getSourceSpan(*ctx), expr));
 }
 
 std::any AntlrASTGeneratorVisitor::visitIf_statement(CeresParser::If_statementContext* ctx)
@@ -999,9 +1043,9 @@ std::any AntlrASTGeneratorVisitor::visitCast_expr(CeresParser::Cast_exprContext*
     checkException(*ctx);
 
     Type* destinationType = std::any_cast<Type*>(visit(ctx->type()));
-    auto expr = std::unique_ptr<Expression>(std::any_cast<Expression*>(visit(ctx->expression())));
+    auto expr = std::any_cast<Expression*>(visit(ctx->expression()));
 
-    return static_cast<Expression*>(new CastExpression(getSourceSpan(*ctx), std::move(expr), destinationType));
+    return static_cast<Expression*>(arena->create<CastExpression>(getSourceSpan(*ctx), expr, destinationType));
 }
 
 // TODO: When adding a new AST node, don't forget to call checkExceptions
@@ -2,7 +2,9 @@
 #define COMPILER_ANTLRASTGENERATORVISITOR_H
 
 #include "../utils/SourceSpan.h"
+#include "ASTArena.h"
 #include "CeresParserBaseVisitor.h"
+#include <memory>
 
 namespace Ceres::AST {
 
@@ -17,6 +19,15 @@ private:
 
     SourceSpan getSourceSpan(antlr4::tree::TerminalNode const& context);
 
+    // Arena in which the nodes are allocated, moved to the CompilationUnit once it is built
+    std::unique_ptr<ASTArena> arena;
+
+    // Global offset of the source, added to the token indices to build the source spans
+    uint32_t fileStartOffset;
+
+    // Builds the LoopHints or FunctionAttributes from the attributes written before a loop or function
+    template<class T> T createAttributes(antlrgenerated::CeresParser::AttributesContext* ctx);
+
 protected:
     std::any defaultResult() override;
 
@@ -56,6 +67,10 @@ public:
 
     std::any visitForStatement(antlrgenerated::CeresParser::ForStatementContext* ctx) override;
 
+    std::any visitAttributes(antlrgenerated::CeresParser::AttributesContext* ctx) override;
+
+    std::any visitAttribute(antlrgenerated::CeresParser::AttributeContext* ctx) override;
+
     std::any visitAssignment_expr(antlrgenerated::CeresParser::Assignment_exprContext* ctx) override;
 
     std::any visitPostfix_expr(antlrgenerated::CeresParser::Postfix_exprContext* ctx) override;
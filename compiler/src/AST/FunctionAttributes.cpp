@@ -0,0 +1,73 @@
+#include "FunctionAttributes.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "../utils/log.hpp"
+
+namespace Ceres::AST {
+
+void FunctionAttributes::add(
+    llvm::StringRef name, SourceSpan nameSpan, llvm::StringRef argument, SourceSpan argumentSpan)
+{
+    if (name == "fast_math") {
+        if (fastMath.has_value()) {
+            Diagnostics::report(nameSpan, Diag::duplicate_function_attribute, name.str());
+        } else if (argument == "on" || argument == "off") {
+            fastMath = argument == "on";
+        } else {
+            Diagnostics::report(
+                argumentSpan, Diag::invalid_function_attribute_argument, argument.str(), name.str(), "'on' or 'off'");
+        }
+        return;
+    }
+
+    if (name != "overflow") {
+        Diagnostics::report(nameSpan, Diag::unknown_function_attribute, name.str());
+        return;
+    }
+
+    if (overflowMode.has_value()) {
+        Diagnostics::report(nameSpan, Diag::duplicate_function_attribute, name.str());
+        return;
+    }
+
+    if (argument == "wrap") {
+        overflowMode = OverflowMode::Wrap;
+    } else if (argument == "trap") {
+        overflowMode = OverflowMode::Trap;
+    } else if (argument == "undefined") {
+        overflowMode = OverflowMode::Undefined;
+    } else {
+        Diagnostics::report(argumentSpan, Diag::invalid_function_attribute_argument, argument.str(), name.str(),
+            "'wrap', 'trap' or 'undefined'");
+    }
+}
+
+static char const* getOverflowModeName(OverflowMode mode)
+{
+    switch (mode) {
+    case OverflowMode::Wrap:
+        return "wrap";
+    case OverflowMode::Trap:
+        return "trap";
+    case OverflowMode::Undefined:
+        return "undefined";
+    }
+    ASSERT_NOT_REACHED();
+}
+
+std::string FunctionAttributes::toString() const
+{
+    std::string res;
+    if (overflowMode.has_value()) {
+        res += fmt::format("overflow({})", getOverflowModeName(*overflowMode));
+    }
+
+    if (fastMath.has_value()) {
+        if (!res.empty()) {
+            res += ", ";
+        }
+        res += fmt::format("fast_math({})", *fastMath ? "on" : "off");
+    }
+    return res;
+}
+
+} // namespace Ceres::AST
@@ -0,0 +1,37 @@
+#ifndef COMPILER_FUNCTIONATTRIBUTES_H
+#define COMPILER_FUNCTIONATTRIBUTES_H
+
+#include "../utils/SourceSpan.h"
+#include <llvm/ADT/StringRef.h>
+#include <optional>
+#include <string>
+
+namespace Ceres::AST {
+
+// What happens when the result of an integer addition, subtraction or multiplication doesn't fit in its type
+enum class OverflowMode {
+    Wrap,     // The result wraps around, in two's complement
+    Trap,     // The program is aborted
+    Undefined // The program is wrong, the optimizer can assume it never happens
+};
+
+// Attributes written before a function definition, as in `#[overflow(trap), fast_math(on)] fn f() {}`
+struct FunctionAttributes {
+    // Overrides the overflow mode given in the command line
+    std::optional<OverflowMode> overflowMode;
+    // If true, enables every floating point optimization that can change the results, as with -ffast-math. If false,
+    // disables them, including fusing multiplications and additions, regardless of the command line
+    std::optional<bool> fastMath;
+
+    bool empty() const { return !overflowMode.has_value() && !fastMath.has_value(); }
+
+    // Adds the attribute `name(argument)`. If it's not a valid attribute, reports an error and ignores it
+    void add(llvm::StringRef name, SourceSpan nameSpan, llvm::StringRef argument, SourceSpan argumentSpan);
+
+    // Attributes in the same syntax as in the source, without the brackets
+    std::string toString() const;
+};
+
+} // namespace Ceres::AST
+
+#endif // COMPILER_FUNCTIONATTRIBUTES_H
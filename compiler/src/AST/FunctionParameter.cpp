@@ -3,10 +3,10 @@
 #include <utility>
 
 namespace Ceres::AST {
-FunctionParameter::FunctionParameter(Type* type, std::string name, Typing::Constness constness,
+FunctionParameter::FunctionParameter(Type* type, Symbol name, Typing::Constness constness,
     SourceSpan typeSourceSpan, SourceSpan parameterNameSourceSpan)
     : type(type)
-    , id(std::move(name))
+    , id(name)
     , constness(constness)
     , typeSourceSpan(typeSourceSpan)
     , parameterNameSourceSpan(parameterNameSourceSpan)
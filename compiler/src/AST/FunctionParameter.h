@@ -2,6 +2,7 @@
 #define COMPILER_FUNCTIONPARAMETER_H
 
 #include "../Typing/Type.h"
+#include "../utils/Symbol.h"
 #include "nodes/Statements/VariableDeclaration.h"
 #include <llvm/IR/Instructions.h>
 #include <memory>
@@ -10,7 +11,7 @@ namespace Ceres::AST {
 
 struct FunctionParameter {
     Type* type;
-    std::string id;
+    Symbol id;
     Typing::Constness constness;
 
     SourceSpan typeSourceSpan;
@@ -18,7 +19,7 @@ struct FunctionParameter {
 
     llvm::AllocaInst* llvmAlloca = nullptr;
 
-    FunctionParameter(Type* type, std::string name, Typing::Constness constness, SourceSpan typeSourceSpan,
+    FunctionParameter(Type* type, Symbol name, Typing::Constness constness, SourceSpan typeSourceSpan,
         SourceSpan parameterNameSourceSpan);
 };
 
@@ -0,0 +1,66 @@
+#include "LoopHints.h"
+#include "../Diagnostics/Diagnostics.h"
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MathExtras.h>
+
+namespace Ceres::AST {
+
+void LoopHints::add(llvm::StringRef name, SourceSpan nameSpan, llvm::StringRef argument, SourceSpan argumentSpan)
+{
+    std::optional<unsigned>* hint;
+    char const* expected;
+    if (name == "unroll") {
+        hint = &unrollCount;
+        expected = "a positive integer or 'disable'";
+    } else if (name == "vectorize") {
+        hint = &vectorizeWidth;
+        expected = "a power of two or 'disable'";
+    } else {
+        Diagnostics::report(nameSpan, Diag::unknown_loop_hint, name.str());
+        return;
+    }
+
+    if (hint->has_value()) {
+        Diagnostics::report(nameSpan, Diag::duplicate_loop_hint, name.str());
+        return;
+    }
+
+    unsigned value = 0;
+    if (argument == "disable") {
+        value = 1;
+    } else {
+        // Note: The argument is a DEC_LITERAL, which can have digit separators
+        std::string digits = argument.str();
+        llvm::erase_value(digits, '_');
+        if (llvm::StringRef(digits).getAsInteger(10, value)) {
+            value = 0;
+        }
+    }
+
+    if (value == 0 || (hint == &vectorizeWidth && !llvm::isPowerOf2_32(value))) {
+        Diagnostics::report(argumentSpan, Diag::invalid_loop_hint_argument, argument.str(), name.str(), expected);
+        return;
+    }
+
+    *hint = value;
+}
+
+std::string LoopHints::toString() const
+{
+    std::string res;
+    auto addHint = [&](char const* name, std::optional<unsigned> value) {
+        if (!value.has_value()) {
+            return;
+        }
+        if (!res.empty()) {
+            res += ", ";
+        }
+        res += fmt::format("{}({})", name, *value == 1 ? "disable" : std::to_string(*value));
+    };
+
+    addHint("unroll", unrollCount);
+    addHint("vectorize", vectorizeWidth);
+    return res;
+}
+
+} // namespace Ceres::AST
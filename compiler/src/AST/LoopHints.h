@@ -0,0 +1,30 @@
+#ifndef COMPILER_LOOPHINTS_H
+#define COMPILER_LOOPHINTS_H
+
+#include "../utils/SourceSpan.h"
+#include <llvm/ADT/StringRef.h>
+#include <optional>
+#include <string>
+
+namespace Ceres::AST {
+
+// Optimization hints written before a loop, as in `#[unroll(4), vectorize(disable)] while cond {}`. They are passed
+// to the LLVM loop passes in the llvm.loop metadata of the loop
+struct LoopHints {
+    // Times the body is replicated by unrolling. 1 disables unrolling
+    std::optional<unsigned> unrollCount;
+    // Number of iterations executed together by vectorizing. 1 disables vectorization
+    std::optional<unsigned> vectorizeWidth;
+
+    bool empty() const { return !unrollCount.has_value() && !vectorizeWidth.has_value(); }
+
+    // Adds the hint `name(argument)`. If it's not a valid hint, reports an error and ignores it
+    void add(llvm::StringRef name, SourceSpan nameSpan, llvm::StringRef argument, SourceSpan argumentSpan);
+
+    // Hints in the same syntax as in the source, without the brackets
+    std::string toString() const;
+};
+
+} // namespace Ceres::AST
+
+#endif // COMPILER_LOOPHINTS_H
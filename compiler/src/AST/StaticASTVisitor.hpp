@@ -0,0 +1,82 @@
+#ifndef COMPILER_STATICASTVISITOR_HPP
+#define COMPILER_STATICASTVISITOR_HPP
+
+#include "../utils/log.hpp"
+#include "nodes/CompilationUnit.h"
+#include "nodes/Expressions/AssignmentExpression.h"
+#include "nodes/Expressions/BinaryOperationExpression.h"
+#include "nodes/Expressions/BoolLiteralExpression.h"
+#include "nodes/Expressions/CastExpression.h"
+#include "nodes/Expressions/CommaExpression.h"
+#include "nodes/Expressions/FloatLiteralExpression.h"
+#include "nodes/Expressions/FunctionCallExpression.h"
+#include "nodes/Expressions/IdentifierExpression.h"
+#include "nodes/Expressions/IntLiteralExpression.h"
+#include "nodes/Expressions/PostfixExpression.h"
+#include "nodes/Expressions/PrefixExpression.h"
+#include "nodes/FunctionDeclaration.h"
+#include "nodes/Node.h"
+#include "nodes/Statements/BlockStatement.h"
+#include "nodes/Statements/ExpressionStatement.h"
+#include "nodes/Statements/ForStatement.h"
+#include "nodes/Statements/FunctionDefinition.h"
+#include "nodes/Statements/IfStatement.h"
+#include "nodes/Statements/ReturnStatement.h"
+#include "nodes/Statements/VariableDeclaration.h"
+#include "nodes/Statements/WhileStatement.h"
+#include <type_traits>
+
+namespace Ceres::AST {
+
+// Visitor that dispatches on the kind of the node with a switch, instead of with virtual calls, so the visit functions
+// can be inlined. Derived is the visitor class itself (CRTP), and T is the return type of each visit, which can be void.
+// Derived hides the visit functions of the nodes it handles. The ones it doesn't hide visit the children of the node
+template<class Derived, class T = void> class StaticASTVisitor {
+    Derived& derived() { return *static_cast<Derived*>(this); }
+
+public:
+    T visit(Node& node)
+    {
+        switch (node.getKind()) {
+#define NODE(className) \
+    case NodeKind::className: \
+        return derived().visit##className(static_cast<className&>(node));
+#include "nodes/ASTNodes.def"
+        }
+        ASSERT_NOT_REACHED();
+    }
+
+    // Visits the children in order. If T is not void, the results are combined with Derived::aggregateValues()
+    T visitChildren(Node& node)
+    {
+        if constexpr (std::is_void_v<T>) {
+            for (auto* child : node.getChildren()) {
+                ASSERT(child != nullptr);
+                derived().visit(*child);
+            }
+        } else {
+            T accumulator = derived().defaultValue();
+            for (auto* child : node.getChildren()) {
+                ASSERT(child != nullptr);
+                accumulator = derived().aggregateValues(accumulator, derived().visit(*child));
+            }
+            return accumulator;
+        }
+    }
+
+    // This function should construct the first initialization for the accumulator when visiting children
+    template<class U = T> U defaultValue() { return U {}; }
+
+    // This function should return a way to aggregate the values when calling visitChildren() to multiple children. By
+    // default, only the last value is preserved and returned to the parent
+    template<class U = T> U aggregateValues(U const& accumulator, U const& next) { return next; }
+
+    // Default implementation for visiting children
+#define NODE(className) \
+    T visit##className(className& node) { return derived().visitChildren(node); }
+#include "nodes/ASTNodes.def"
+};
+
+} // namespace Ceres::AST
+
+#endif // COMPILER_STATICASTVISITOR_HPP
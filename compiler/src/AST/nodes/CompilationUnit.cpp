@@ -1,41 +1,42 @@
 #include "CompilationUnit.h"
-#include "../AbstractASTVisitor.h"
+#include "../../utils/log.hpp"
 
 namespace Ceres::AST {
-CompilationUnit::CompilationUnit(SourceSpan const& sourceSpan,
-    std::vector<std::unique_ptr<FunctionDefinition>>&& functionDefinitions,
-    std::vector<std::unique_ptr<FunctionDeclaration>>&& functionDeclarations,
-    std::vector<std::unique_ptr<VariableDeclaration>>&& globalVariableDeclarations)
-    : Node(sourceSpan)
+CompilationUnit::CompilationUnit(SourceSpan const& sourceSpan, std::unique_ptr<ASTArena>&& arena,
+    std::vector<FunctionDefinition*>&& functionDefinitions, std::vector<FunctionDeclaration*>&& functionDeclarations,
+    std::vector<VariableDeclaration*>&& globalVariableDeclarations)
+    : Node(NodeKind::CompilationUnit, sourceSpan)
+    , arena(std::move(arena))
     , functionDefinitions(std::move(functionDefinitions))
     , functionDeclarations(std::move(functionDeclarations))
     , globalVariableDeclarations(std::move(globalVariableDeclarations))
 {
 }
 
-void CompilationUnit::accept(AbstractASTVisitor& visitor) { visitor.visitCompilationUnit(*this); }
-
-std::vector<Node*> CompilationUnit::getChildren() const
+size_t CompilationUnit::getNumChildren() const
 {
-    std::vector<Node*> v;
-    v.reserve(functionDefinitions.size() + functionDeclarations.size() + globalVariableDeclarations.size());
+    return functionDefinitions.size() + functionDeclarations.size() + globalVariableDeclarations.size();
+}
 
-    for (auto const& ptr : functionDefinitions) {
-        v.push_back(ptr.get());
+Node* CompilationUnit::getChild(size_t index) const
+{
+    if (index < functionDefinitions.size()) {
+        return functionDefinitions[index];
     }
+    index -= functionDefinitions.size();
 
-    for (auto const& ptr : functionDeclarations) {
-        v.push_back(ptr.get());
+    if (index < functionDeclarations.size()) {
+        return functionDeclarations[index];
     }
+    index -= functionDeclarations.size();
 
-    for (auto const& ptr : globalVariableDeclarations) {
-        v.push_back(ptr.get());
-    }
-    return v;
+    ASSERT(index < globalVariableDeclarations.size());
+    return globalVariableDeclarations[index];
 }
 
-CompilationUnit::CompilationUnit(SourceSpan const& sourceSpan)
-    : Node(sourceSpan)
+CompilationUnit::CompilationUnit(SourceSpan const& sourceSpan, std::unique_ptr<ASTArena>&& arena)
+    : Node(NodeKind::CompilationUnit, sourceSpan)
+    , arena(std::move(arena))
 {
 }
 } // namespace Ceres::AST
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef COMPILER_COMPILATIONUNIT_H
 #define COMPILER_COMPILATIONUNIT_H
 
+#include "../ASTArena.h"
 #include "FunctionDeclaration.h"
 #include "Node.h"
 #include "Statements/FunctionDefinition.h"
@@ -10,23 +11,28 @@
 
 namespace Ceres::AST {
 
+// Root of the AST of a file. It owns the arena in which all the other nodes are allocated
 class CompilationUnit : public Node {
 public:
-    std::vector<std::unique_ptr<FunctionDefinition>> functionDefinitions;
-    std::vector<std::unique_ptr<FunctionDeclaration>> functionDeclarations;
-    std::vector<std::unique_ptr<VariableDeclaration>> globalVariableDeclarations;
-    std::optional<Binding::SymbolTableScope> scope;
+    std::unique_ptr<ASTArena> arena;
 
-    CompilationUnit(SourceSpan const& sourceSpan,
-        std::vector<std::unique_ptr<FunctionDefinition>>&& functionDefinitions,
-        std::vector<std::unique_ptr<FunctionDeclaration>>&& functionDeclarations,
-        std::vector<std::unique_ptr<VariableDeclaration>>&& globalVariableDeclarations);
+    std::vector<FunctionDefinition*> functionDefinitions;
+    std::vector<FunctionDeclaration*> functionDeclarations;
+    std::vector<VariableDeclaration*> globalVariableDeclarations;
+    // Global declarations of the unit, collected by the binder
+    std::optional<Binding::SymbolTable> scope;
 
-    CompilationUnit(SourceSpan const& sourceSpan);
+    CompilationUnit(SourceSpan const& sourceSpan, std::unique_ptr<ASTArena>&& arena,
+        std::vector<FunctionDefinition*>&& functionDefinitions,
+        std::vector<FunctionDeclaration*>&& functionDeclarations,
+        std::vector<VariableDeclaration*>&& globalVariableDeclarations);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    CompilationUnit(SourceSpan const& sourceSpan, std::unique_ptr<ASTArena>&& arena);
 
-    std::vector<Node*> getChildren() const override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::CompilationUnit; }
+
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
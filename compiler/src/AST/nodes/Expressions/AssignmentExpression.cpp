@@ -1,22 +1,31 @@
 #include "AssignmentExpression.h"
 #include "../../../Typing/BinaryOperation.h"
 #include "../../../utils/log.hpp"
-#include "../../AbstractASTVisitor.h"
 #include <utility>
 
 namespace Ceres::AST {
 AssignmentExpression::AssignmentExpression(SourceSpan const& sourceSpan,
-    std::optional<Typing::BinaryOperation> const& binaryOp, std::unique_ptr<Expression>&& expressionLhs,
-    std::unique_ptr<Expression>&& expressionRhs, SourceSpan opSourceSpan)
-    : Expression(sourceSpan)
+    std::optional<Typing::BinaryOperation> const& binaryOp, Expression* expressionLhs, Expression* expressionRhs,
+    SourceSpan opSourceSpan)
+    : Expression(NodeKind::AssignmentExpression, sourceSpan)
     , binaryOp(binaryOp)
-    , expressionLHS(std::move(expressionLhs))
-    , expressionRHS(std::move(expressionRhs))
+    , expressionLHS(expressionLhs)
+    , expressionRHS(expressionRhs)
     , opSourceSpan(opSourceSpan)
 {
 }
 
-void AssignmentExpression::accept(AbstractASTVisitor& visitor) { visitor.visitAssignmentExpression(*this); }
+size_t AssignmentExpression::getNumChildren() const { return 2; }
 
-std::vector<Node*> AssignmentExpression::getChildren() const { return { expressionLHS.get(), expressionRHS.get() }; }
+Node* AssignmentExpression::getChild(size_t index) const
+{
+    switch (index) {
+    case 0:
+        return expressionLHS;
+    case 1:
+        return expressionRHS;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
 } // namespace Ceres::AST
\ No newline at end of file
@@ -18,21 +18,21 @@ public:
     std::optional<Typing::BinaryOperation> binaryOp;
 
     // Identifier of the variable that is being assigned.  Not nullable.
-    std::unique_ptr<Expression> expressionLHS;
+    Expression* expressionLHS;
 
     // Expression that is being assigned (possibly after performing a binary
     // operation). Not nullable.
-    std::unique_ptr<Expression> expressionRHS;
+    Expression* expressionRHS;
 
     SourceSpan opSourceSpan;
 
     AssignmentExpression(SourceSpan const& sourceSpan, std::optional<Typing::BinaryOperation> const& binaryOp,
-        std::unique_ptr<Expression>&& expressionLhs, std::unique_ptr<Expression>&& expressionRhs,
-        SourceSpan opSourceSpan);
+        Expression* expressionLhs, Expression* expressionRhs, SourceSpan opSourceSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::AssignmentExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
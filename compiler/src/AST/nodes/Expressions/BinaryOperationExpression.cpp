@@ -1,20 +1,29 @@
 #include "BinaryOperationExpression.h"
 #include "../../../Typing/BinaryOperation.h"
 #include "../../../utils/log.hpp"
-#include "../../AbstractASTVisitor.h"
 
 namespace Ceres::AST {
-BinaryOperationExpression::BinaryOperationExpression(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& left,
-    std::unique_ptr<Expression>&& right, Typing::BinaryOperation op, SourceSpan opSpan)
-    : Expression(sourceSpan)
-    , left(std::move(left))
-    , right(std::move(right))
+BinaryOperationExpression::BinaryOperationExpression(
+    SourceSpan const& sourceSpan, Expression* left, Expression* right, Typing::BinaryOperation op, SourceSpan opSpan)
+    : Expression(NodeKind::BinaryOperationExpression, sourceSpan)
+    , left(left)
+    , right(right)
     , op(op)
     , opSpan(opSpan)
 {
 }
 
-void BinaryOperationExpression::accept(AbstractASTVisitor& visitor) { visitor.visitBinaryOperationExpression(*this); }
+size_t BinaryOperationExpression::getNumChildren() const { return 2; }
 
-std::vector<Node*> BinaryOperationExpression::getChildren() const { return { left.get(), right.get() }; }
+Node* BinaryOperationExpression::getChild(size_t index) const
+{
+    switch (index) {
+    case 0:
+        return left;
+    case 1:
+        return right;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
 } // namespace Ceres::AST
@@ -3,23 +3,24 @@
 
 #include "../../../Typing/BinaryOperation.h"
 #include "Expression.h"
-#include <memory>
 
 namespace Ceres::AST {
 
 class BinaryOperationExpression : public Expression {
 public:
-    std::unique_ptr<Expression> left, right;
+    Expression* left;
+    Expression* right;
     Typing::BinaryOperation op;
 
     SourceSpan opSpan;
 
-    BinaryOperationExpression(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& left,
-        std::unique_ptr<Expression>&& right, Typing::BinaryOperation op, SourceSpan opSpan);
+    BinaryOperationExpression(SourceSpan const& sourceSpan, Expression* left, Expression* right,
+        Typing::BinaryOperation op, SourceSpan opSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::BinaryOperationExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
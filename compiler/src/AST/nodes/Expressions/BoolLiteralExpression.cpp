@@ -1,16 +1,16 @@
 #include "BoolLiteralExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
 BoolLiteralExpression::BoolLiteralExpression(SourceSpan const& sourceSpan, BoolLiteralValue value)
-    : Expression(sourceSpan, BoolType::get())
+    : Expression(NodeKind::BoolLiteralExpression, sourceSpan, BoolType::get())
     , value(value)
 {
 }
 
-void BoolLiteralExpression::accept(AbstractASTVisitor& visitor) { visitor.visitBoolLiteral(*this); }
+size_t BoolLiteralExpression::getNumChildren() const { return 0; }
 
-std::vector<Node*> BoolLiteralExpression::getChildren() const { return {}; }
+Node* BoolLiteralExpression::getChild(size_t index) const { ASSERT_NOT_REACHED(); }
 
 std::string BoolLiteralExpression::toStringBoolLiteralValue(BoolLiteralValue value)
 {
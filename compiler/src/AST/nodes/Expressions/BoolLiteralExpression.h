@@ -14,9 +14,10 @@ public:
 
     BoolLiteralExpression(SourceSpan const& sourceSpan, BoolLiteralValue value);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::BoolLiteralExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 
     static std::string toStringBoolLiteralValue(BoolLiteralValue value);
     bool getLiteralBool() const;
@@ -1,16 +1,21 @@
 #include "CastExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
 
-CastExpression::CastExpression(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& expr, Type* castToType)
-    : Expression(sourceSpan)
-    , expr(std::move(expr))
+CastExpression::CastExpression(SourceSpan const& sourceSpan, Expression* expr, Type* castToType)
+    : Expression(NodeKind::CastExpression, sourceSpan)
+    , expr(expr)
     , destinationType(castToType)
 {
 }
-void CastExpression::accept(AbstractASTVisitor& visitor) { visitor.visitCastExpression(*this); }
 
-std::vector<Node*> CastExpression::getChildren() const { return { expr.get() }; }
+size_t CastExpression::getNumChildren() const { return 1; }
+
+Node* CastExpression::getChild(size_t index) const
+{
+    ASSERT(index == 0);
+    return expr;
+}
 
 } // AST
\ No newline at end of file
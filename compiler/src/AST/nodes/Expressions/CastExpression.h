@@ -3,21 +3,21 @@
 
 #include "../../../Typing/Type.h"
 #include "Expression.h"
-#include <memory>
 
 namespace Ceres::AST {
 
 class CastExpression : public Expression {
 public:
-    std::unique_ptr<Expression> expr;
+    Expression* expr;
 
     // Type to cast to
     Type* destinationType;
 
-    CastExpression(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& expr, Type* castToType);
+    CastExpression(SourceSpan const& sourceSpan, Expression* expr, Type* castToType);
 
-    void accept(AbstractASTVisitor& visitor) override;
-    std::vector<Node*> getChildren() const override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::CastExpression; }
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // AST
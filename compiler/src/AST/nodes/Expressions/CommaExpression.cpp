@@ -1,23 +1,18 @@
 #include "CommaExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
-CommaExpression::CommaExpression(SourceSpan const& sourceSpan, std::vector<std::unique_ptr<Expression>>&& expressions)
-    : Expression(sourceSpan)
+CommaExpression::CommaExpression(SourceSpan const& sourceSpan, std::vector<Expression*>&& expressions)
+    : Expression(NodeKind::CommaExpression, sourceSpan)
     , expressions(std::move(expressions))
 {
 }
 
-void CommaExpression::accept(AbstractASTVisitor& visitor) { visitor.visitCommaExpression(*this); }
+size_t CommaExpression::getNumChildren() const { return expressions.size(); }
 
-std::vector<Node*> CommaExpression::getChildren() const
+Node* CommaExpression::getChild(size_t index) const
 {
-    std::vector<Node*> v;
-    v.reserve(expressions.size());
-
-    for (auto& a : expressions) {
-        v.push_back(a.get());
-    }
-    return v;
+    ASSERT(index < expressions.size());
+    return expressions[index];
 }
 } // namespace Ceres::AST
\ No newline at end of file
@@ -2,20 +2,20 @@
 #define COMPILER_COMMAEXPRESSION_H
 
 #include "Expression.h"
-#include <memory>
 #include <vector>
 
 namespace Ceres::AST {
 
 class CommaExpression : public Expression {
 public:
-    std::vector<std::unique_ptr<Expression>> expressions;
+    std::vector<Expression*> expressions;
 
-    CommaExpression(SourceSpan const& sourceSpan, std::vector<std::unique_ptr<Expression>>&& expressions);
+    CommaExpression(SourceSpan const& sourceSpan, std::vector<Expression*>&& expressions);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::CommaExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
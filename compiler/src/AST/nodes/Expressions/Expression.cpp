@@ -1,14 +1,14 @@
 #include "Expression.h"
 
 namespace Ceres::AST {
-Expression::Expression(SourceSpan const& sourceSpan)
-    : Node(sourceSpan)
+Expression::Expression(NodeKind kind, SourceSpan const& sourceSpan)
+    : Node(kind, sourceSpan)
     , type(NotYetInferredType::get(NotYetInferredKind::Expression))
 {
 }
 
-Expression::Expression(SourceSpan const& sourceSpan, Type* type)
-    : Node(sourceSpan)
+Expression::Expression(NodeKind kind, SourceSpan const& sourceSpan, Type* type)
+    : Node(kind, sourceSpan)
     , type(type)
 {
 }
@@ -3,17 +3,38 @@
 
 #include "../../../Typing/Type.h"
 #include "../Node.h"
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/APInt.h>
+#include <optional>
+#include <variant>
 
 namespace Ceres::AST {
+
+// Value of an expression known at compile time. Integers and bools are held as APInt, bools with a single bit
+using ConstantValue = std::variant<llvm::APInt, llvm::APFloat>;
+
 class Expression : public Node {
 public:
     Type* type;
 
-    explicit Expression(SourceSpan const& sourceSpan);
+    // Set by the constant evaluation pass if the value of the expression is known at compile time
+    std::optional<ConstantValue> constantValue;
+
+    Expression(NodeKind kind, SourceSpan const& sourceSpan);
 
-    explicit Expression(SourceSpan const& sourceSpan, Type* type);
+    Expression(NodeKind kind, SourceSpan const& sourceSpan, Type* type);
 
-    virtual ~Expression() = default;
+    static bool classof(Node const* node)
+    {
+        switch (node->getKind()) {
+#define NODE(className)
+#define EXPRESSION(className) case NodeKind::className:
+#include "../ASTNodes.def"
+            return true;
+        default:
+            return false;
+        }
+    }
 };
 
 } // namespace Ceres::AST
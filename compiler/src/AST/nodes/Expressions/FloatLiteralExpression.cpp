@@ -1,6 +1,6 @@
 #include "FloatLiteralExpression.h"
 
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include <llvm/ADT/APFloat.h>
 #include <utility>
 
@@ -8,15 +8,15 @@ namespace Ceres::AST {
 
 FloatLiteralExpression::FloatLiteralExpression(
     SourceSpan const& sourceSpan, FloatLiteralBase base, Type* type, std::string str)
-    : Expression(sourceSpan, type)
+    : Expression(NodeKind::FloatLiteralExpression, sourceSpan, type)
     , base(base)
     , str(std::move(str))
 {
 }
 
-void FloatLiteralExpression::accept(AbstractASTVisitor& visitor) { visitor.visitFloatLiteralExpression(*this); }
+size_t FloatLiteralExpression::getNumChildren() const { return 0; }
 
-std::vector<Node*> FloatLiteralExpression::getChildren() const { return {}; }
+Node* FloatLiteralExpression::getChild(size_t index) const { ASSERT_NOT_REACHED(); }
 
 llvm::APFloat FloatLiteralExpression::getLLVMAPFloat()
 {
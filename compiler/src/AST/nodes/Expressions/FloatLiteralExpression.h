@@ -22,9 +22,10 @@ public:
 
     FloatLiteralExpression(SourceSpan const& sourceSpan, FloatLiteralBase base, Type* type, std::string str);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::FloatLiteralExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
     llvm::APFloat getLLVMAPFloat();
 };
 
@@ -1,31 +1,29 @@
 #include "FunctionCallExpression.h"
 
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include "IdentifierExpression.h"
 #include <utility>
 
 namespace Ceres::AST {
-FunctionCallExpression::FunctionCallExpression(SourceSpan const& sourceSpan, std::string functionIdentifier,
-    std::vector<std::unique_ptr<Expression>>&& arguments, SourceSpan functionIdentifierSourceSpan)
-    : Expression(sourceSpan)
-    , identifier(new IdentifierExpression(functionIdentifierSourceSpan, std::move(functionIdentifier)))
+FunctionCallExpression::FunctionCallExpression(
+    SourceSpan const& sourceSpan, IdentifierExpression* identifier, std::vector<Expression*>&& arguments)
+    : Expression(NodeKind::FunctionCallExpression, sourceSpan)
     , arguments(std::move(arguments))
+    , identifier(identifier)
 {
 }
 
-void FunctionCallExpression::accept(AbstractASTVisitor& visitor) { visitor.visitFunctionCallExpression(*this); }
+// TODO: In the future, when we add support for function calls to pointers,
+// we need to add the expression
+//          resolving to the function pointer to the children
+size_t FunctionCallExpression::getNumChildren() const { return arguments.size() + 1; }
 
-std::vector<Node*> FunctionCallExpression::getChildren() const
+Node* FunctionCallExpression::getChild(size_t index) const
 {
-    // TODO: In the future, when we add support for function calls to pointers,
-    // we need to add the expression
-    //          resolving to the function pointer to the children
-    std::vector<Node*> v;
-    v.reserve(arguments.size() + 1);
-    v.push_back(identifier.get());
-    for (auto& a : arguments) {
-        v.push_back(a.get());
+    if (index == 0) {
+        return identifier;
     }
-    return v;
+    ASSERT(index <= arguments.size());
+    return arguments[index - 1];
 }
 } // namespace Ceres::AST
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include "../../../Binding/SymbolDeclaration.h"
 #include "Expression.h"
 #include "IdentifierExpression.h"
-#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -15,15 +14,16 @@ class FunctionCallExpression : public Expression {
 public:
     // TODO: maybe it can be something else
     // std::string functionIdentifier;
-    std::vector<std::unique_ptr<Expression>> arguments;
-    std::unique_ptr<IdentifierExpression> identifier;
+    std::vector<Expression*> arguments;
+    IdentifierExpression* identifier;
 
-    FunctionCallExpression(SourceSpan const& sourceSpan, std::string functionIdentifier,
-        std::vector<std::unique_ptr<Expression>>&& arguments, SourceSpan functionIdentifierSourceSpan);
+    FunctionCallExpression(
+        SourceSpan const& sourceSpan, IdentifierExpression* identifier, std::vector<Expression*>&& arguments);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::FunctionCallExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
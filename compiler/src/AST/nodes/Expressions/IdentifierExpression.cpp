@@ -1,14 +1,14 @@
 #include "IdentifierExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
-IdentifierExpression::IdentifierExpression(SourceSpan const& sourceSpan, std::string identifier)
-    : Expression(sourceSpan)
-    , identifier(std::move(identifier))
+IdentifierExpression::IdentifierExpression(SourceSpan const& sourceSpan, Symbol identifier)
+    : Expression(NodeKind::IdentifierExpression, sourceSpan)
+    , identifier(identifier)
 {
 }
 
-void IdentifierExpression::accept(AbstractASTVisitor& visitor) { visitor.visitIdentifierExpression(*this); }
+size_t IdentifierExpression::getNumChildren() const { return 0; }
 
-std::vector<Node*> IdentifierExpression::getChildren() const { return {}; }
+Node* IdentifierExpression::getChild(size_t index) const { ASSERT_NOT_REACHED(); }
 } // namespace Ceres::AST
\ No newline at end of file
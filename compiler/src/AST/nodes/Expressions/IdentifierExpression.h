@@ -2,21 +2,22 @@
 #define COMPILER_IDENTIFIEREXPRESSION_H
 
 #include "../../../Binding/SymbolDeclaration.h"
+#include "../../../utils/Symbol.h"
 #include "Expression.h"
-#include <string>
 
 namespace Ceres::AST {
 
 class IdentifierExpression : public Expression {
 public:
-    std::string identifier;
+    Symbol identifier;
     std::optional<Binding::SymbolDeclaration> decl;
 
-    IdentifierExpression(SourceSpan const& sourceSpan, std::string identifier);
+    IdentifierExpression(SourceSpan const& sourceSpan, Symbol identifier);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::IdentifierExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
@@ -1,76 +1,32 @@
 #include "IntLiteralExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include <cstddef>
-#include <cstdlib>
 #include <llvm/ADT/APInt.h>
-#include <unordered_map>
 
 namespace Ceres::AST {
 
 IntLiteralExpression::IntLiteralExpression(
     SourceSpan const& sourceSpan, IntLiteralBase base, Type* type, std::string str)
-    : Expression(sourceSpan, type)
+    : Expression(NodeKind::IntLiteralExpression, sourceSpan, type)
     , base(base)
     , str(std::move(str))
 {
 }
 
-void IntLiteralExpression::accept(AbstractASTVisitor& visitor) { visitor.visitIntLiteralExpression(*this); }
+size_t IntLiteralExpression::getNumChildren() const { return 0; }
 
-std::vector<Node*> IntLiteralExpression::getChildren() const { return {}; }
+Node* IntLiteralExpression::getChild(size_t index) const { ASSERT_NOT_REACHED(); }
 
 bool IntLiteralExpression::doesLiteralFitInsideType()
 {
-    // TODO: Call this function where appropriate in TypingVisitor
-
-    // TODO: This function is not accurate enough. Only checks for some condition. We should improve it
     auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type);
     ASSERT(intType != nullptr);
-    auto base = getRadix();
-
-    // TODO: should be correct or caught in parser
-    char* end = nullptr;
-
-    if (intType->isSigned()) {
-        auto res = std::strtoll(str.c_str(), &end, base);
-
-        if (errno == ERANGE) {
-            errno = 0;
-            return false;
-        }
-
-        // check bits fit
-        auto width = intType->getNumBits();
-        long long mask = ~0 << width;
-        long long last_bit = 1 << (width - 1);
-
-        // assume 2 complement
-        if ((res & last_bit) == 0 && (res & mask) != 0) {
-            return false;
-        }
-
-        if ((res & last_bit) == 1 && (res | ~mask) != ~0) {
-            return false;
-        }
-    } else {
-        auto res = std::strtoull(str.c_str(), &end, base);
-
-        if (errno == ERANGE) {
-            errno = 0;
-            return false;
-        }
-
-        // check bits fit
-        auto width = intType->getNumBits();
-
-        unsigned long long mask = ~0 << width;
-
-        if ((res & mask) != 0) {
-            return false;
-        }
-    }
 
-    return true;
+    // Note: The literal has no sign, the sign bit of a signed type can't be used to hold it
+    auto radix = getRadix();
+    llvm::APInt value(llvm::APInt::getBitsNeeded(str, radix), str, radix);
+    unsigned availableBits = intType->isSigned() ? intType->getNumBits() - 1 : intType->getNumBits();
+    return value.getActiveBits() <= availableBits;
 }
 
 llvm::APInt IntLiteralExpression::getLLVMAPInt()
@@ -23,9 +23,10 @@ public:
 
     llvm::APInt getLLVMAPInt();
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::IntLiteralExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
     bool doesLiteralFitInsideType();
     uint8_t getRadix() const;
 };
@@ -1,19 +1,23 @@
 #include "PostfixExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
 PostfixExpression::PostfixExpression(
-    SourceSpan const& sourceSpan, PostfixOp op, std::unique_ptr<Expression>&& expr, SourceSpan opSourceSpan)
-    : Expression(sourceSpan)
+    SourceSpan const& sourceSpan, PostfixOp op, Expression* expr, SourceSpan opSourceSpan)
+    : Expression(NodeKind::PostfixExpression, sourceSpan)
     , op(op)
-    , expr(std::move(expr))
+    , expr(expr)
     , opSourceSpan(opSourceSpan)
 {
 }
 
-void PostfixExpression::accept(AbstractASTVisitor& visitor) { visitor.visitPostfixExpression(*this); }
+size_t PostfixExpression::getNumChildren() const { return 1; }
 
-std::vector<Node*> PostfixExpression::getChildren() const { return { expr.get() }; }
+Node* PostfixExpression::getChild(size_t index) const
+{
+    ASSERT(index == 0);
+    return expr;
+}
 
 std::string postfixOpToString(PostfixOp op)
 {
@@ -2,7 +2,6 @@
 #define COMPILER_POSTFIXEXPRESSION_H
 
 #include "Expression.h"
-#include <memory>
 
 namespace Ceres::AST {
 enum class PostfixOp { PostfixIncrement, PostfixDecrement };
@@ -12,16 +11,17 @@ std::string postfixOpToString(PostfixOp op);
 class PostfixExpression : public Expression {
 public:
     PostfixOp op;
-    std::unique_ptr<Expression> expr;
+    Expression* expr;
 
     SourceSpan opSourceSpan;
 
     PostfixExpression(
-        SourceSpan const& sourceSpan, PostfixOp op, std::unique_ptr<Expression>&& expr, SourceSpan opSourceSpan);
+        SourceSpan const& sourceSpan, PostfixOp op, Expression* expr, SourceSpan opSourceSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::PostfixExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
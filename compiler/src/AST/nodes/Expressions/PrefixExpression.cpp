@@ -1,20 +1,24 @@
 #include "PrefixExpression.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
 
 PrefixExpression::PrefixExpression(
-    SourceSpan const& sourceSpan, PrefixOp op, std::unique_ptr<Expression>&& expr, SourceSpan const& opSourceSpan)
-    : Expression(sourceSpan)
+    SourceSpan const& sourceSpan, PrefixOp op, Expression* expr, SourceSpan const& opSourceSpan)
+    : Expression(NodeKind::PrefixExpression, sourceSpan)
     , op(op)
-    , expr(std::move(expr))
+    , expr(expr)
     , opSourceSpan(opSourceSpan)
 {
 }
 
-void PrefixExpression::accept(AbstractASTVisitor& visitor) { visitor.visitPrefixExpression(*this); }
+size_t PrefixExpression::getNumChildren() const { return 1; }
 
-std::vector<Node*> PrefixExpression::getChildren() const { return { expr.get() }; }
+Node* PrefixExpression::getChild(size_t index) const
+{
+    ASSERT(index == 0);
+    return expr;
+}
 
 std::string prefixOpToString(PrefixOp op)
 {
@@ -2,7 +2,6 @@
 #define COMPILER_PREFIXEXPRESSION_H
 
 #include "Expression.h"
-#include <memory>
 
 namespace Ceres::AST {
 
@@ -13,16 +12,17 @@ std::string prefixOpToString(PrefixOp op);
 class PrefixExpression : public Expression {
 public:
     PrefixOp op;
-    std::unique_ptr<Expression> expr;
+    Expression* expr;
 
     SourceSpan opSourceSpan;
 
     PrefixExpression(
-        SourceSpan const& sourceSpan, PrefixOp op, std::unique_ptr<Expression>&& expr, SourceSpan const& opSourceSpan);
+        SourceSpan const& sourceSpan, PrefixOp op, Expression* expr, SourceSpan const& opSourceSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::PrefixExpression; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
@@ -1,14 +1,14 @@
 #include "FunctionDeclaration.h"
-#include "../AbstractASTVisitor.h"
+#include "../../utils/log.hpp"
 
 namespace Ceres::AST {
 
 FunctionDeclaration::FunctionDeclaration(SourceSpan const& sourceSpan, FunctionVisibility visibility,
-    std::string functionName, std::vector<FunctionParameter>&& parameters, Type* returnType,
+    Symbol functionName, std::vector<FunctionParameter>&& parameters, Type* returnType,
     SourceSpan const& returnTypeSpan, SourceSpan const& functionNameSpan)
-    : Node(sourceSpan)
+    : Node(NodeKind::FunctionDeclaration, sourceSpan)
     , visibility(visibility)
-    , functionName(std::move(functionName))
+    , functionName(functionName)
     , parameters(std::move(parameters))
     , returnType(returnType)
     , returnTypeSpan(returnTypeSpan)
@@ -16,8 +16,8 @@ FunctionDeclaration::FunctionDeclaration(SourceSpan const& sourceSpan, FunctionV
 {
 }
 
-std::vector<Node*> FunctionDeclaration::getChildren() const { return {}; }
+size_t FunctionDeclaration::getNumChildren() const { return 0; }
 
-void FunctionDeclaration::accept(AbstractASTVisitor& visitor) { visitor.visitFunctionDeclaration(*this); }
+Node* FunctionDeclaration::getChild(size_t index) const { ASSERT_NOT_REACHED(); }
 
 } // AST
\ No newline at end of file
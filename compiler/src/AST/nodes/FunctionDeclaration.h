@@ -2,14 +2,14 @@
 #define COMPILER_FUNCTIONDECLARATION_H
 
 #include "Node.h"
+#include "../../utils/Symbol.h"
 #include "Statements/FunctionDefinition.h"
-#include <string>
 
 namespace Ceres::AST {
 class FunctionDeclaration : public Node {
 public:
     FunctionVisibility visibility;
-    std::string functionName;
+    Symbol functionName;
     std::vector<FunctionParameter> parameters;
     Type* returnType;
 
@@ -18,13 +18,14 @@ public:
     SourceSpan returnTypeSpan;
     SourceSpan functionNameSpan;
 
-    FunctionDeclaration(SourceSpan const& sourceSpan, FunctionVisibility visibility, std::string functionName,
+    FunctionDeclaration(SourceSpan const& sourceSpan, FunctionVisibility visibility, Symbol functionName,
         std::vector<FunctionParameter>&& parameters, Type* returnType, SourceSpan const& returnTypeSpan,
         SourceSpan const& functionNameSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::FunctionDeclaration; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
     llvm::Value* llvmFunction = nullptr;
 };
 }
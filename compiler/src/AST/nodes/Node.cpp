@@ -1,9 +1,66 @@
 #include "Node.h"
+#include "../../utils/log.hpp"
+#include "CompilationUnit.h"
+#include "Expressions/AssignmentExpression.h"
+#include "Expressions/BinaryOperationExpression.h"
+#include "Expressions/BoolLiteralExpression.h"
+#include "Expressions/CastExpression.h"
+#include "Expressions/CommaExpression.h"
+#include "Expressions/FloatLiteralExpression.h"
+#include "Expressions/FunctionCallExpression.h"
+#include "Expressions/IdentifierExpression.h"
+#include "Expressions/IntLiteralExpression.h"
+#include "Expressions/PostfixExpression.h"
+#include "Expressions/PrefixExpression.h"
+#include "FunctionDeclaration.h"
+#include "Statements/BlockStatement.h"
+#include "Statements/ExpressionStatement.h"
+#include "Statements/ForStatement.h"
+#include "Statements/FunctionDefinition.h"
+#include "Statements/IfStatement.h"
+#include "Statements/ReturnStatement.h"
+#include "Statements/VariableDeclaration.h"
+#include "Statements/WhileStatement.h"
 
 namespace Ceres::AST {
 
-Node::Node(SourceSpan const& sourceSpan)
-    : sourceSpan(sourceSpan)
+Node::Node(NodeKind kind, SourceSpan const& sourceSpan)
+    : kind(kind)
+    , sourceSpan(sourceSpan)
 {
 }
-} // namespace Ceres::AST
\ No newline at end of file
+
+size_t Node::getNumChildren() const
+{
+    switch (kind) {
+#define NODE(className) \
+    case NodeKind::className: \
+        return static_cast<className const*>(this)->getNumChildren();
+#include "ASTNodes.def"
+    }
+    ASSERT_NOT_REACHED();
+}
+
+Node* Node::getChild(size_t index) const
+{
+    switch (kind) {
+#define NODE(className) \
+    case NodeKind::className: \
+        return static_cast<className const*>(this)->getChild(index);
+#include "ASTNodes.def"
+    }
+    ASSERT_NOT_REACHED();
+}
+
+void Node::destroy()
+{
+    switch (kind) {
+#define NODE(className) \
+    case NodeKind::className: \
+        static_cast<className*>(this)->~className(); \
+        return;
+#include "ASTNodes.def"
+    }
+    ASSERT_NOT_REACHED();
+}
+} // namespace Ceres::AST
@@ -2,25 +2,90 @@
 #define COMPILER_NODE_H
 
 #include "../../utils/SourceSpan.h"
-#include <vector>
+#include <llvm/ADT/iterator_range.h>
+#include <cstddef>
+#include <iterator>
 
 namespace Ceres::AST {
 
-class AbstractASTVisitor;
+class Node;
 
+/// Discriminator for LLVM-style RTTI (isa<>, dyn_cast<> et al.) and for the dispatch of StaticASTVisitor
+enum class NodeKind {
+#define NODE(className) className,
+#include "ASTNodes.def"
+};
+
+// Iterates the children of a node by index, so walking the tree doesn't allocate
+class ChildIterator {
+    Node const* node;
+    size_t index;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Node*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Node* const*;
+    using reference = Node*;
+
+    ChildIterator(Node const* node, size_t index)
+        : node(node)
+        , index(index)
+    {
+    }
+
+    Node* operator*() const;
+
+    ChildIterator& operator++()
+    {
+        ++index;
+        return *this;
+    }
+
+    ChildIterator operator++(int)
+    {
+        auto copy = *this;
+        ++index;
+        return copy;
+    }
+
+    bool operator==(ChildIterator const& other) const { return node == other.node && index == other.index; }
+    bool operator!=(ChildIterator const& other) const { return !(*this == other); }
+};
+
+using ChildRange = llvm::iterator_range<ChildIterator>;
+
+// Nodes have no virtual functions, which keeps them small and lets their functions be inlined. The functions whose
+// implementation depends on the concrete class are hidden by each concrete class, and dispatched on the node kind by
+// Node. For the same reason, nodes can't be deleted through a base class pointer: see destroy()
 class Node {
+private:
+    const NodeKind kind;
+
+protected:
+    ~Node() = default;
+
 public:
     // Members
     SourceSpan sourceSpan;
 
     // Methods
-    explicit Node(SourceSpan const& sourceSpan);
+    Node(NodeKind kind, SourceSpan const& sourceSpan);
+
+    NodeKind getKind() const { return kind; }
 
-    virtual void accept(AbstractASTVisitor& visitor) = 0;
-    virtual std::vector<Node*> getChildren() const = 0;
+    // Children that are not present (e.g. a missing else branch) are not counted, so the children are always the
+    // indices in [0, getNumChildren())
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 
-    virtual ~Node() = default;
+    ChildRange getChildren() const { return { ChildIterator(this, 0), ChildIterator(this, getNumChildren()) }; }
+
+    // Runs the destructor of the concrete class of the node
+    void destroy();
 };
 
+inline Node* ChildIterator::operator*() const { return node->getChild(index); }
+
 } // namespace Ceres::AST
 #endif // COMPILER_NODE_H
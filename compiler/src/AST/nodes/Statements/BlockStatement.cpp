@@ -1,23 +1,19 @@
 #include "BlockStatement.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
 
-BlockStatement::BlockStatement(SourceSpan const& sourceSpan, std::vector<std::unique_ptr<Statement>>&& statements)
-    : Statement(sourceSpan)
+BlockStatement::BlockStatement(SourceSpan const& sourceSpan, std::vector<Statement*>&& statements)
+    : Statement(NodeKind::BlockStatement, sourceSpan)
     , statements(std::move(statements))
 {
 }
 
-void BlockStatement::accept(AbstractASTVisitor& visitor) { visitor.visitBlockStatement(*this); }
+size_t BlockStatement::getNumChildren() const { return statements.size(); }
 
-std::vector<Node*> BlockStatement::getChildren() const
+Node* BlockStatement::getChild(size_t index) const
 {
-    std::vector<Node*> v;
-    v.reserve(statements.size());
-    for (auto& a : statements) {
-        v.push_back(a.get());
-    }
-    return v;
+    ASSERT(index < statements.size());
+    return statements[index];
 }
 } // namespace Ceres::AST
\ No newline at end of file
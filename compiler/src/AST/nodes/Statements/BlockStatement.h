@@ -3,7 +3,6 @@
 
 #include "../../../Binding/Scope.h"
 #include "Statement.h"
-#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -12,13 +11,14 @@ namespace Ceres::AST {
 class BlockStatement : public Statement {
 
 public:
-    std::vector<std::unique_ptr<Statement>> statements;
+    std::vector<Statement*> statements;
 
-    BlockStatement(SourceSpan const& sourceSpan, std::vector<std::unique_ptr<Statement>>&& statements);
+    BlockStatement(SourceSpan const& sourceSpan, std::vector<Statement*>&& statements);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::BlockStatement; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 } // namespace Ceres::AST
 
@@ -1,14 +1,18 @@
 #include "ExpressionStatement.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
-ExpressionStatement::ExpressionStatement(SourceSpan&& sourceSpan, std::unique_ptr<Expression>&& expression)
-    : Statement(sourceSpan)
-    , expression(std::move(expression))
+ExpressionStatement::ExpressionStatement(SourceSpan&& sourceSpan, Expression* expression)
+    : Statement(NodeKind::ExpressionStatement, sourceSpan)
+    , expression(expression)
 {
 }
 
-void ExpressionStatement::accept(AbstractASTVisitor& visitor) { visitor.visitExpressionStatement(*this); }
+size_t ExpressionStatement::getNumChildren() const { return 1; }
 
-std::vector<Node*> ExpressionStatement::getChildren() const { return { expression.get() }; }
+Node* ExpressionStatement::getChild(size_t index) const
+{
+    ASSERT(index == 0);
+    return expression;
+}
 } // namespace Ceres::AST
\ No newline at end of file
@@ -3,19 +3,19 @@
 
 #include "../Expressions/Expression.h"
 #include "Statement.h"
-#include <memory>
 
 namespace Ceres::AST {
 
 class ExpressionStatement : public Statement {
 public:
-    std::unique_ptr<Expression> expression;
+    Expression* expression;
 
-    ExpressionStatement(SourceSpan&& sourceSpan, std::unique_ptr<Expression>&& expression);
+    ExpressionStatement(SourceSpan&& sourceSpan, Expression* expression);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::ExpressionStatement; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
@@ -1,44 +1,35 @@
 #include "ForStatement.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include "BlockStatement.h"
 
 namespace Ceres::AST {
-ForStatement::ForStatement(SourceSpan const& sourceSpan, std::unique_ptr<VariableDeclaration>&& maybeInitDeclaration,
-    std::unique_ptr<Expression>&& maybeInitExpression, std::unique_ptr<Expression>&& conditionExpr,
-    std::unique_ptr<Expression>&& updateExpr, std::unique_ptr<BlockStatement>&& body)
-    : Statement(sourceSpan)
-    , maybeInitDeclaration(std::move(maybeInitDeclaration))
-    , maybeInitExpression(std::move(maybeInitExpression))
-    , maybeConditionExpr(std::move(conditionExpr))
-    , maybeUpdateExpr(std::move(updateExpr))
-    , body(std::move(body))
+ForStatement::ForStatement(SourceSpan const& sourceSpan, VariableDeclaration* maybeInitDeclaration,
+    Expression* maybeInitExpression, Expression* conditionExpr, Expression* updateExpr, BlockStatement* body)
+    : Statement(NodeKind::ForStatement, sourceSpan)
+    , maybeInitDeclaration(maybeInitDeclaration)
+    , maybeInitExpression(maybeInitExpression)
+    , maybeConditionExpr(conditionExpr)
+    , maybeUpdateExpr(updateExpr)
+    , body(body)
 {
 }
 
-void ForStatement::accept(AbstractASTVisitor& visitor) { visitor.visitForStatement(*this); }
-
-std::vector<Node*> ForStatement::getChildren() const
+size_t ForStatement::getNumChildren() const
 {
-    std::vector<Node*> v;
-
-    if (maybeInitDeclaration != nullptr) {
-        v.push_back(maybeInitDeclaration.get());
-    }
-
-    if (maybeInitExpression != nullptr) {
-        v.push_back(maybeInitExpression.get());
-    }
-
-    if (maybeConditionExpr != nullptr) {
-        v.push_back(maybeConditionExpr.get());
-    }
+    return (maybeInitDeclaration != nullptr) + (maybeInitExpression != nullptr) + (maybeConditionExpr != nullptr)
+        + (maybeUpdateExpr != nullptr) + 1;
+}
 
-    if (maybeUpdateExpr != nullptr) {
-        v.push_back(maybeUpdateExpr.get());
+Node* ForStatement::getChild(size_t index) const
+{
+    // Note: The missing parts of the header are skipped
+    for (Node* child : { static_cast<Node*>(maybeInitDeclaration), static_cast<Node*>(maybeInitExpression),
+             static_cast<Node*>(maybeConditionExpr), static_cast<Node*>(maybeUpdateExpr),
+             static_cast<Node*>(body) }) {
+        if (child != nullptr && index-- == 0) {
+            return child;
+        }
     }
-
-    v.push_back(body.get());
-
-    return v;
+    ASSERT_NOT_REACHED();
 }
 } // namespace Ceres::AST
\ No newline at end of file
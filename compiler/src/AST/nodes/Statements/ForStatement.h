@@ -1,11 +1,11 @@
 #ifndef COMPILER_FORSTATEMENT_H
 #define COMPILER_FORSTATEMENT_H
 
+#include "../../LoopHints.h"
 #include "../Expressions/Expression.h"
 #include "BlockStatement.h"
 #include "Statement.h"
 #include "VariableDeclaration.h"
-#include <memory>
 
 namespace Ceres::AST {
 
@@ -16,21 +16,24 @@ public:
     // declaration or an expression: It may have a declaration (for(let i =
     // 0;;){}) or an expression (let i : i32; for(i = 0;;){}). At most one of
     // them will be a non nullptr, but both may be nullptr.
-    std::unique_ptr<VariableDeclaration> maybeInitDeclaration;
-    std::unique_ptr<Expression> maybeInitExpression;
+    VariableDeclaration* maybeInitDeclaration;
+    Expression* maybeInitExpression;
 
-    std::unique_ptr<Expression> maybeConditionExpr;
-    std::unique_ptr<Expression> maybeUpdateExpr;
+    Expression* maybeConditionExpr;
+    Expression* maybeUpdateExpr;
 
-    std::unique_ptr<Ceres::AST::BlockStatement> body;
+    Ceres::AST::BlockStatement* body;
 
-    ForStatement(SourceSpan const& sourceSpan, std::unique_ptr<VariableDeclaration>&& maybeInitDeclaration,
-        std::unique_ptr<Expression>&& maybeInitExpression, std::unique_ptr<Expression>&& conditionExpr,
-        std::unique_ptr<Expression>&& updateExpr, std::unique_ptr<Ceres::AST::BlockStatement>&& body);
+    LoopHints hints;
 
-    void accept(AbstractASTVisitor& visitor) override;
+    ForStatement(SourceSpan const& sourceSpan, VariableDeclaration* maybeInitDeclaration,
+        Expression* maybeInitExpression, Expression* conditionExpr, Expression* updateExpr,
+        Ceres::AST::BlockStatement* body);
 
-    std::vector<Node*> getChildren() const override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::ForStatement; }
+
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
@@ -1,24 +1,36 @@
 #include "FunctionDefinition.h"
 
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include <utility>
 
 namespace Ceres::AST {
 FunctionDefinition::FunctionDefinition(SourceSpan const& sourceSpan, FunctionVisibility visibility,
-    std::string functionName, std::vector<FunctionParameter>&& parameters, Type* returnType,
-    std::unique_ptr<BlockStatement>&& block, SourceSpan const& returnTypeSpan, SourceSpan const& functionNameSpan)
-    : Statement(sourceSpan)
+    Symbol functionName, std::vector<FunctionParameter>&& parameters, Type* returnType, BlockStatement* block,
+    SourceSpan const& returnTypeSpan, SourceSpan const& functionNameSpan)
+    : Statement(NodeKind::FunctionDefinition, sourceSpan)
     , visibility(visibility)
-    , id(std::move(functionName))
+    , id(functionName)
     , parameters(std::move(parameters))
     , returnType(returnType)
-    , block(std::move(block))
+    , block(block)
     , returnTypeSpan(returnTypeSpan)
     , functionNameSpan(functionNameSpan)
 {
 }
 
-void FunctionDefinition::accept(AbstractASTVisitor& visitor) { visitor.visitFunctionDefinition(*this); }
+size_t FunctionDefinition::getNumChildren() const { return 1; }
 
-std::vector<Node*> FunctionDefinition::getChildren() const { return { block.get() }; }
+Node* FunctionDefinition::getChild(size_t index) const
+{
+    ASSERT(index == 0);
+    return block;
+}
+
+bool FunctionDefinition::isExported() const
+{
+    if (parentFunction != nullptr) {
+        return false;
+    }
+    return visibility != FunctionVisibility::Private || id.getText() == "main" || id.getText() == "testMain";
+}
 } // namespace Ceres::AST
\ No newline at end of file
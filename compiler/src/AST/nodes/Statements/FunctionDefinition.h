@@ -2,12 +2,12 @@
 #define COMPILER_FUNCTIONDEFINITION_H
 
 #include "../../../Typing/Type.h"
+#include "../../../utils/Symbol.h"
+#include "../../FunctionAttributes.h"
 #include "../../FunctionParameter.h"
 #include "../Expressions/Expression.h"
 #include "BlockStatement.h"
 #include <llvm/IR/Function.h>
-#include <memory>
-#include <string>
 #include <vector>
 
 namespace Ceres::AST {
@@ -17,10 +17,11 @@ enum class FunctionVisibility { Public, Private, Extern };
 class FunctionDefinition : public Statement {
 public:
     FunctionVisibility visibility;
-    std::string id;
+    Symbol id;
     std::vector<FunctionParameter> parameters;
     Type* returnType;
-    std::unique_ptr<BlockStatement> block;
+    BlockStatement* block;
+    FunctionAttributes attributes;
 
     Type* functionType = nullptr;
 
@@ -30,16 +31,26 @@ public:
 
     llvm::Function* llvmFunction = nullptr;
 
+    // Set before codegen by the FunctionReachabilityVisitor. Functions that can't be reached from the exported ones are
+    // not generated, and the ones whose address is never taken can use any calling convention
+    bool isReachable = true;
+    bool isAddressTaken = false;
+
     SourceSpan returnTypeSpan;
     SourceSpan functionNameSpan;
 
-    FunctionDefinition(SourceSpan const& sourceSpan, FunctionVisibility visibility, std::string functionName,
-        std::vector<FunctionParameter>&& parameters, Type* returnType, std::unique_ptr<BlockStatement>&& block,
+    FunctionDefinition(SourceSpan const& sourceSpan, FunctionVisibility visibility, Symbol functionName,
+        std::vector<FunctionParameter>&& parameters, Type* returnType, BlockStatement* block,
         SourceSpan const& returnTypeSpan, SourceSpan const& functionNameSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::FunctionDefinition; }
+
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 
-    std::vector<Node*> getChildren() const override;
+    // True if the function can be called from outside of the compilation unit: it's pub, or it's the entry point of
+    // the program, which is main or, in test programs, testMain
+    bool isExported() const;
 };
 
 } // namespace Ceres::AST
@@ -1,28 +1,32 @@
 #include "IfStatement.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include "BlockStatement.h"
 
 namespace Ceres::AST {
-IfStatement::IfStatement(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& condition,
-    std::unique_ptr<BlockStatement>&& thenBlock, std::unique_ptr<Statement>&& elseStatement)
-    : Statement(sourceSpan)
-    , condition(std::move(condition))
-    , thenBlock(std::move(thenBlock))
-    , maybeElseStatement(std::move(elseStatement))
+IfStatement::IfStatement(
+    SourceSpan const& sourceSpan, Expression* condition, BlockStatement* thenBlock, Statement* elseStatement)
+    : Statement(NodeKind::IfStatement, sourceSpan)
+    , condition(condition)
+    , thenBlock(thenBlock)
+    , maybeElseStatement(elseStatement)
 {
 }
 
-void IfStatement::accept(AbstractASTVisitor& visitor) { visitor.visitIfStatement(*this); }
+size_t IfStatement::getNumChildren() const { return maybeElseStatement != nullptr ? 3 : 2; }
 
-std::vector<Node*> IfStatement::getChildren() const
+Node* IfStatement::getChild(size_t index) const
 {
-    std::vector<Node*> v;
-    v.push_back(condition.get());
-    v.push_back(thenBlock.get());
-    if (maybeElseStatement != nullptr) {
-        v.push_back(maybeElseStatement.get());
+    switch (index) {
+    case 0:
+        return condition;
+    case 1:
+        return thenBlock;
+    case 2:
+        ASSERT(maybeElseStatement != nullptr);
+        return maybeElseStatement;
+    default:
+        ASSERT_NOT_REACHED();
     }
-    return v;
 }
 
 } // namespace Ceres::AST
\ No newline at end of file
@@ -4,25 +4,25 @@
 #include "../Expressions/Expression.h"
 #include "BlockStatement.h"
 #include "Statement.h"
-#include <memory>
 
 namespace Ceres::AST {
 
 class IfStatement : public Statement {
 public:
-    std::unique_ptr<Expression> condition;
-    std::unique_ptr<Ceres::AST::BlockStatement> thenBlock;
+    Expression* condition;
+    Ceres::AST::BlockStatement* thenBlock;
 
     // Currently: the else statement can only be a BlockStatement, another
     // IfStatement or a nullptr Note: maybeElseStatement can be a nullptr
-    std::unique_ptr<Statement> maybeElseStatement;
+    Statement* maybeElseStatement;
 
-    IfStatement(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& condition,
-        std::unique_ptr<Ceres::AST::BlockStatement>&& thenBlock, std::unique_ptr<Statement>&& elseStatement);
+    IfStatement(SourceSpan const& sourceSpan, Expression* condition, Ceres::AST::BlockStatement* thenBlock,
+        Statement* elseStatement);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::IfStatement; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
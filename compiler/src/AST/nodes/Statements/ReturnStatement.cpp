@@ -1,22 +1,19 @@
 #include "ReturnStatement.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 
 namespace Ceres::AST {
-ReturnStatement::ReturnStatement(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& expr)
-    : Statement(sourceSpan)
-    , expr(std::move(expr))
+ReturnStatement::ReturnStatement(SourceSpan const& sourceSpan, Expression* expr)
+    : Statement(NodeKind::ReturnStatement, sourceSpan)
+    , expr(expr)
 {
 }
 
-void ReturnStatement::accept(AbstractASTVisitor& visitor) { visitor.visitReturnStatement(*this); }
+size_t ReturnStatement::getNumChildren() const { return expr != nullptr ? 1 : 0; }
 
-std::vector<Node*> ReturnStatement::getChildren() const
+Node* ReturnStatement::getChild(size_t index) const
 {
-    if (expr == nullptr) {
-        return {};
-    }
-    return { expr.get() };
+    ASSERT(index == 0 && expr != nullptr);
+    return expr;
 }
-bool ReturnStatement::isTerminator() const { return true; }
 
 } // namespace Ceres::AST
\ No newline at end of file
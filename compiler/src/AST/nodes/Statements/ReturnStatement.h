@@ -4,7 +4,6 @@
 #include "../../../Binding/SymbolDeclaration.h"
 #include "../Expressions/Expression.h"
 #include "Statement.h"
-#include <memory>
 #include <optional>
 
 namespace Ceres::AST {
@@ -12,16 +11,15 @@ namespace Ceres::AST {
 class ReturnStatement : public Statement {
 public:
     // May be null if no expression has been provided
-    std::unique_ptr<Expression> expr;
+    Expression* expr;
     std::optional<Binding::SymbolDeclaration> decl;
 
-    ReturnStatement(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& expr);
+    ReturnStatement(SourceSpan const& sourceSpan, Expression* expr);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::ReturnStatement; }
 
-    bool isTerminator() const override;
-
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
@@ -1,9 +1,8 @@
 #include "Statement.h"
 
 namespace Ceres::AST {
-Statement::Statement(SourceSpan const& sourceSpan)
-    : Node(sourceSpan)
+Statement::Statement(NodeKind kind, SourceSpan const& sourceSpan)
+    : Node(kind, sourceSpan)
 {
 }
-bool Statement::isTerminator() const { return false; }
 } // namespace Ceres::AST
\ No newline at end of file
@@ -7,11 +7,21 @@
 namespace Ceres::AST {
 class Statement : public Node {
 public:
-    explicit Statement(SourceSpan const& sourceSpan);
+    Statement(NodeKind kind, SourceSpan const& sourceSpan);
 
-    virtual bool isTerminator() const;
+    static bool classof(Node const* node)
+    {
+        switch (node->getKind()) {
+#define NODE(className)
+#define STATEMENT(className) case NodeKind::className:
+#include "../ASTNodes.def"
+            return true;
+        default:
+            return false;
+        }
+    }
 
-    virtual ~Statement() = default;
+    bool isTerminator() const { return getKind() == NodeKind::ReturnStatement; }
 };
 
 } // namespace Ceres::AST
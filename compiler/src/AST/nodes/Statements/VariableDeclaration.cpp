@@ -2,33 +2,36 @@
 
 #include <utility>
 
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include <utility>
 
 namespace Ceres::AST {
-VariableDeclaration::VariableDeclaration(Ceres::SourceSpan const& sourceSpan,
-    std::unique_ptr<Expression>&& initializerExpression, Typing::VariableVisibility visibility,
-    Typing::Constness constness, VariableScope scope, Type* type, std::string identifier,
-    SourceSpan const& typeSourceSpan, SourceSpan const& identifierSourceSpan)
-    : Statement(sourceSpan)
-    , initializerExpression(std::move(initializerExpression))
+VariableDeclaration::VariableDeclaration(Ceres::SourceSpan const& sourceSpan, Expression* initializerExpression,
+    Typing::VariableVisibility visibility, Typing::Constness constness, VariableScope scope, Type* type,
+    Symbol identifier, SourceSpan const& typeSourceSpan, SourceSpan const& identifierSourceSpan)
+    : Statement(NodeKind::VariableDeclaration, sourceSpan)
+    , initializerExpression(initializerExpression)
     , visibility(visibility)
     , constness(constness)
     , type(type)
-    , id(std::move(std::move(identifier)))
+    , id(identifier)
     , typeSourceSpan(typeSourceSpan)
     , identifierSourceSpan(identifierSourceSpan)
     , scope(scope)
 {
 }
 
-void VariableDeclaration::accept(AbstractASTVisitor& visitor) { visitor.visitVariableDeclaration(*this); }
+size_t VariableDeclaration::getNumChildren() const { return initializerExpression != nullptr ? 1 : 0; }
 
-std::vector<Node*> VariableDeclaration::getChildren() const
+Node* VariableDeclaration::getChild(size_t index) const
 {
-    if (initializerExpression != nullptr) {
-        return { initializerExpression.get() };
-    }
-    return {};
+    ASSERT(index == 0 && initializerExpression != nullptr);
+    return initializerExpression;
+}
+
+bool VariableDeclaration::isCompileTimeConstant() const
+{
+    return constness.kind == Typing::Constness::Const && initializerExpression != nullptr
+        && initializerExpression->constantValue.has_value();
 }
 } // namespace Ceres::AST
@@ -4,11 +4,10 @@
 #include "../../../Typing/Constness.h"
 #include "../../../Typing/Type.h"
 #include "../../../Typing/Visibility.h"
+#include "../../../utils/Symbol.h"
 #include "../Expressions/Expression.h"
 #include "Statement.h"
 #include <llvm/IR/Instructions.h>
-#include <memory>
-#include <string>
 
 namespace Ceres::AST {
 
@@ -24,7 +23,7 @@ public:
     VariableScope scope;
 
     Type* type;
-    std::string id;
+    Symbol id;
 
     SourceSpan typeSourceSpan;
     SourceSpan identifierSourceSpan;
@@ -32,16 +31,20 @@ public:
     llvm::AllocaInst* allocaInst;
 
     // Can be nullptr if the variable doesn't have initializer expression
-    std::unique_ptr<Expression> initializerExpression;
+    Expression* initializerExpression;
 
 public:
-    VariableDeclaration(Ceres::SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& initializerExpression,
+    VariableDeclaration(Ceres::SourceSpan const& sourceSpan, Expression* initializerExpression,
         Typing::VariableVisibility visibility, Typing::Constness constness, VariableScope scope, Type* type,
-        std::string identifier, SourceSpan const& typeSourceSpan, SourceSpan const& identifierSourceSpan);
+        Symbol identifier, SourceSpan const& typeSourceSpan, SourceSpan const& identifierSourceSpan);
 
-    void accept(AbstractASTVisitor& visitor) override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::VariableDeclaration; }
 
-    std::vector<Node*> getChildren() const override;
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
+
+    // True if the variable is const and the constant evaluation pass folded its initializer, so it needs no storage
+    bool isCompileTimeConstant() const;
 };
 } // namespace Ceres::AST
 
@@ -1,17 +1,26 @@
 #include "WhileStatement.h"
-#include "../../AbstractASTVisitor.h"
+#include "../../../utils/log.hpp"
 #include "BlockStatement.h"
 
 namespace Ceres::AST {
-WhileStatement::WhileStatement(
-    SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& condition, std::unique_ptr<BlockStatement>&& body)
-    : Statement(sourceSpan)
-    , condition(std::move(condition))
-    , body(std::move(body))
+WhileStatement::WhileStatement(SourceSpan const& sourceSpan, Expression* condition, BlockStatement* body)
+    : Statement(NodeKind::WhileStatement, sourceSpan)
+    , condition(condition)
+    , body(body)
 {
 }
 
-void WhileStatement::accept(AbstractASTVisitor& visitor) { visitor.visitWhileStatement(*this); }
+size_t WhileStatement::getNumChildren() const { return 2; }
 
-std::vector<Node*> WhileStatement::getChildren() const { return { condition.get(), body.get() }; }
+Node* WhileStatement::getChild(size_t index) const
+{
+    switch (index) {
+    case 0:
+        return condition;
+    case 1:
+        return body;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
 } // namespace Ceres::AST
\ No newline at end of file
@@ -1,24 +1,26 @@
 #ifndef COMPILER_WHILESTATEMENT_H
 #define COMPILER_WHILESTATEMENT_H
 
+#include "../../LoopHints.h"
 #include "../Expressions/Expression.h"
 #include "BlockStatement.h"
 #include "Statement.h"
-#include <memory>
 
 namespace Ceres::AST {
 
 class WhileStatement : public Statement {
 public:
-    std::unique_ptr<Expression> condition;
-    std::unique_ptr<Ceres::AST::BlockStatement> body;
+    Expression* condition;
+    Ceres::AST::BlockStatement* body;
 
-    WhileStatement(SourceSpan const& sourceSpan, std::unique_ptr<Expression>&& condition,
-        std::unique_ptr<Ceres::AST::BlockStatement>&& body);
+    LoopHints hints;
 
-    void accept(AbstractASTVisitor& visitor) override;
+    WhileStatement(SourceSpan const& sourceSpan, Expression* condition, Ceres::AST::BlockStatement* body);
 
-    std::vector<Node*> getChildren() const override;
+    static bool classof(Node const* node) { return node->getKind() == NodeKind::WhileStatement; }
+
+    size_t getNumChildren() const;
+    Node* getChild(size_t index) const;
 };
 
 } // namespace Ceres::AST
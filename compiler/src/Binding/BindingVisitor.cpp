@@ -2,132 +2,143 @@
 #include "../Diagnostics/Diagnostics.h"
 #include "Scope.h"
 #include "SymbolDeclaration.h"
+#include <llvm/Support/Casting.h>
 #include <optional>
 #include <spdlog/fmt/bundled/core.h>
 
 namespace Ceres::Binding {
-void BindingVisitor::visitCompilationUnit(AST::CompilationUnit& unit)
+static FunctionType* getFunctionType(Type* returnType, std::vector<AST::FunctionParameter> const& parameters)
 {
-    // TODO: fix when we have multiple translation units, we need to add unresolved symbols to translation unit
-    ASSERT(currentScope == nullptr);
-
-    unit.scope = SymbolTableScope(nullptr);
-    currentScope = &unit.scope.value();
-    auto unresolved = SymbolTableScope(nullptr);
-
-    ASSERT(currentScope != nullptr);
+    std::vector<Type*> parameterTypes;
+    parameterTypes.reserve(parameters.size());
 
-    visitChildren(unit);
-
-    for (auto* const n : unresolvedScope) {
-        auto resolved = currentScope->resolve(n->identifier);
-
-        if (!resolved.has_value()) {
-            Diagnostics::report(n->sourceSpan, Diag::unresolved_identifier, n->identifier);
-            n->decl = {};
-        } else {
-            n->decl = resolved;
-        }
+    for (auto const& param : parameters) {
+        parameterTypes.push_back(param.type);
     }
 
-    // Now we set the types of the function definitions and declarations
-    for (auto& funDec : unit.functionDeclarations) {
-        std::vector<Type*> parameterTypes;
-        parameterTypes.reserve(funDec->parameters.size());
+    return FunctionType::get(returnType, parameterTypes);
+}
 
-        for (auto const& param : funDec->parameters) {
-            parameterTypes.push_back(param.type);
-        }
+void collectGlobalDeclarations(AST::CompilationUnit& unit, SymbolTable& globals)
+{
+    ASSERT(globals.getDepth() == 0);
 
-        funDec->functionType = FunctionType::get(funDec->returnType, parameterTypes);
+    // Same order as the children of the unit, so duplicate definitions are reported in the same order as the rest
+    for (auto* funDef : unit.functionDefinitions) {
+        funDef->functionType = getFunctionType(funDef->returnType, funDef->parameters);
+        globals.define(funDef->id, SymbolDeclaration(SymbolDeclarationKind::FunctionDefinition, funDef));
     }
 
-    for (auto& funDef : unit.functionDefinitions) {
-        std::vector<Type*> parameterTypes;
-        parameterTypes.reserve(funDef->parameters.size());
-
-        for (auto const& param : funDef->parameters) {
-            parameterTypes.push_back(param.type);
-        }
+    for (auto* funDec : unit.functionDeclarations) {
+        funDec->functionType = getFunctionType(funDec->returnType, funDec->parameters);
+        globals.define(funDec->functionName, SymbolDeclaration(SymbolDeclarationKind::FunctionDeclaration, funDec));
+    }
 
-        funDef->functionType = FunctionType::get(funDef->returnType, parameterTypes);
+    for (auto* varDecl : unit.globalVariableDeclarations) {
+        ASSERT(varDecl->scope == AST::VariableScope::Global);
+        globals.define(varDecl->id, SymbolDeclaration(SymbolDeclarationKind::GlobalVariableDeclaration, varDecl));
     }
 }
 
-void BindingVisitor::visitBlockStatement(AST::BlockStatement& stm)
+BindingVisitor::BindingVisitor(SymbolTable const& globals)
+    : globals(globals)
 {
-    auto s = SymbolTableScope(currentScope);
-    currentScope = &s;
-
-    ASSERT(currentScope != nullptr);
+}
 
-    visitChildren(stm);
+SymbolDeclaration const* BindingVisitor::resolve(Symbol name) const
+{
+    if (auto const* local = locals.resolve(name)) {
+        return local;
+    }
 
-    currentScope = currentScope->getEnclosingScope();
+    return globals.resolve(name);
 }
 
-void BindingVisitor::visitFunctionDefinition(AST::FunctionDefinition& def)
+void BindingVisitor::bindFunctionBody(AST::FunctionDefinition& def)
 {
     ASSERT(def.block != nullptr);
-    ASSERT(currentScope != nullptr);
 
     // Create link to parent function
     def.parentFunction = currentFunction;
-
-    // Define function
-    auto fsymbol = SymbolDeclaration(SymbolDeclarationKind::FunctionDefinition, &def);
-    currentScope->define(def.id, fsymbol);
     currentFunction = &def;
 
     // Create scope for function body
-    auto s = SymbolTableScope(currentScope);
-    currentScope = &s;
+    locals.enterScope();
 
     // Add all parameters
     for (auto param_idx = 0; param_idx < def.parameters.size(); ++param_idx) {
         SymbolDeclaration symbol = SymbolDeclaration(SymbolDeclarationKind::FunctionParamDeclaration, param_idx, &def);
-        currentScope->define(def.parameters[param_idx].id, symbol);
+        locals.define(def.parameters[param_idx].id, symbol);
     }
 
     visitChildren(*def.block);
 
+    locals.exitScope();
     currentFunction = def.parentFunction;
-    currentScope = currentScope->getEnclosingScope();
 }
 
-void BindingVisitor::visitFunctionDeclaration(AST::FunctionDeclaration& dec)
+void BindingVisitor::bindGlobalVariable(AST::VariableDeclaration& decl)
 {
-    ASSERT(currentScope != nullptr);
+    ASSERT(decl.scope == AST::VariableScope::Global);
 
-    // Define function
-    auto fsymbol = SymbolDeclaration(SymbolDeclarationKind::FunctionDeclaration, &dec);
-    currentScope->define(dec.functionName, fsymbol);
+    // The variable itself was defined when collecting the global declarations
+    visitChildren(decl);
 }
 
-void BindingVisitor::visitVariableDeclaration(AST::VariableDeclaration& decl)
+void BindingVisitor::visitCompilationUnit(AST::CompilationUnit& unit)
+{
+    ASSERT(currentFunction == nullptr);
+
+    for (auto* funDef : unit.functionDefinitions) {
+        bindFunctionBody(*funDef);
+    }
+
+    for (auto* varDecl : unit.globalVariableDeclarations) {
+        bindGlobalVariable(*varDecl);
+    }
+}
+
+void BindingVisitor::visitBlockStatement(AST::BlockStatement& stm)
+{
+    locals.enterScope();
+    visitChildren(stm);
+    locals.exitScope();
+}
+
+void BindingVisitor::visitFunctionDefinition(AST::FunctionDefinition& def)
 {
-    auto kind = decl.scope == AST::VariableScope::Global ? SymbolDeclarationKind::GlobalVariableDeclaration
-                                                         : SymbolDeclarationKind::LocalVariableDeclaration;
+    ASSERT(currentFunction != nullptr);
+
+    // Define inner function
+    auto fsymbol = SymbolDeclaration(SymbolDeclarationKind::FunctionDefinition, &def);
+    locals.define(def.id, fsymbol);
 
-    auto symbol = SymbolDeclaration(kind, &decl);
+    def.functionType = getFunctionType(def.returnType, def.parameters);
+    bindFunctionBody(def);
+}
 
-    ASSERT(currentScope != nullptr);
+void BindingVisitor::visitVariableDeclaration(AST::VariableDeclaration& decl)
+{
+    // Global variables are defined when collecting the global declarations
+    ASSERT(decl.scope == AST::VariableScope::Local);
+    ASSERT(locals.getDepth() > 0);
 
-    currentScope->define(decl.id, symbol);
+    auto symbol = SymbolDeclaration(SymbolDeclarationKind::LocalVariableDeclaration, &decl);
+    locals.define(decl.id, symbol);
 
     visitChildren(decl);
 }
 
 void BindingVisitor::visitIdentifierExpression(AST::IdentifierExpression& expr)
 {
+    // Every global declaration is already known, so anything not found here doesn't exist
+    auto const* resolved = resolve(expr.identifier);
 
-    auto resolved = currentScope->resolve(expr.identifier);
-
-    if (!resolved.has_value()) {
-        // TODO: can be global variable or function call
-        unresolvedScope.push_back(&expr);
+    if (resolved == nullptr) {
+        Diagnostics::report(expr.sourceSpan, Diag::unresolved_identifier, expr.identifier);
+        expr.decl = {};
     } else {
-        expr.decl = resolved;
+        expr.decl = *resolved;
     }
 
     visitChildren(expr);
@@ -136,30 +147,29 @@ void BindingVisitor::visitIdentifierExpression(AST::IdentifierExpression& expr)
 void BindingVisitor::visitAssignmentExpression(AST::AssignmentExpression& expr)
 {
     // TODO: check is LHS
-    auto* identifierExpr = dynamic_cast<AST::IdentifierExpression*>(expr.expressionLHS.get());
-    if (identifierExpr == nullptr) {
+    if (!llvm::isa<AST::IdentifierExpression>(expr.expressionLHS)) {
         Log::panic("LHS of expression is not an identifier");
     }
 
-    auto resolved = currentScope->resolve(identifierExpr->identifier);
-
-    if (!resolved.has_value()) {
-        unresolvedScope.push_back(identifierExpr);
-    } else {
-        identifierExpr->decl = resolved;
-    }
-
+    // The identifier on the LHS is resolved when visiting it
     visitChildren(expr);
 }
 
 void BindingVisitor::visitReturnStatement(AST::ReturnStatement& stm)
 {
-    auto resolved = currentScope->resolve(currentFunction->id);
-    ASSERT(resolved.has_value());
-    stm.decl = resolved;
+    ASSERT(currentFunction != nullptr);
+
+    // Refer to the function directly, as a local with the same name could shadow it
+    stm.decl = SymbolDeclaration(SymbolDeclarationKind::FunctionDefinition, currentFunction);
     visitChildren(stm);
 }
 
-void BindingVisitor::visitForStatement(AST::ForStatement& stm) { NOT_IMPLEMENTED(); }
+void BindingVisitor::visitForStatement(AST::ForStatement& stm)
+{
+    // The variable declared in the header is only visible inside the for
+    locals.enterScope();
+    visitChildren(stm);
+    locals.exitScope();
+}
 
 } // namespace Ceres::Binding
@@ -1,28 +1,41 @@
 #ifndef COMPILER_BINDINGVISITOR_H
 #define COMPILER_BINDINGVISITOR_H
 
-#include "../AST/ASTVisitor.h"
+#include "../AST/StaticASTVisitor.hpp"
 #include "Scope.h"
 
 namespace Ceres::Binding {
 
-class BindingVisitor : public AST::ASTVisitor {
-public:
-    std::vector<AST::IdentifierExpression*> unresolvedScope;
-    Scope* currentScope = nullptr;
+// First phase of binding: defines the functions, extern functions and global variables of the unit in globals, and
+// sets the types of the functions, so the bodies bound afterwards can use any of them regardless of their order
+void collectGlobalDeclarations(AST::CompilationUnit& unit, SymbolTable& globals);
+
+// Second phase of binding: resolves the identifiers in the bodies of the functions and in the initializers of the
+// global variables, once all the global declarations are known. globals is only read, so different functions can be
+// bound at the same time, each one by its own visitor
+class BindingVisitor : public AST::StaticASTVisitor<BindingVisitor> {
+private:
+    SymbolTable const& globals;
+    // Declarations inside function bodies, which shadow the global ones
+    SymbolTable locals;
     AST::FunctionDefinition* currentFunction = nullptr;
 
-    // Since we don't resolve anything in this pass we just have to add the
-    // defined names to the tables
-    void visitCompilationUnit(AST::CompilationUnit& unit) override;
-    void visitBlockStatement(AST::BlockStatement& stm) override;
-    void visitFunctionDefinition(AST::FunctionDefinition& def) override;
-    void visitVariableDeclaration(AST::VariableDeclaration& decl) override;
-    void visitIdentifierExpression(AST::IdentifierExpression& expr) override;
-    void visitAssignmentExpression(AST::AssignmentExpression& expr) override;
-    void visitReturnStatement(AST::ReturnStatement& stm) override;
-    void visitFunctionDeclaration(AST::FunctionDeclaration& dec) override;
-    void visitForStatement(AST::ForStatement& stm) override;
+    SymbolDeclaration const* resolve(Symbol name) const;
+
+public:
+    explicit BindingVisitor(SymbolTable const& globals);
+
+    void bindFunctionBody(AST::FunctionDefinition& def);
+    void bindGlobalVariable(AST::VariableDeclaration& decl);
+
+    void visitCompilationUnit(AST::CompilationUnit& unit);
+    void visitBlockStatement(AST::BlockStatement& stm);
+    void visitFunctionDefinition(AST::FunctionDefinition& def);
+    void visitVariableDeclaration(AST::VariableDeclaration& decl);
+    void visitIdentifierExpression(AST::IdentifierExpression& expr);
+    void visitAssignmentExpression(AST::AssignmentExpression& expr);
+    void visitReturnStatement(AST::ReturnStatement& stm);
+    void visitForStatement(AST::ForStatement& stm);
 };
 } // namespace Ceres::Binding
 
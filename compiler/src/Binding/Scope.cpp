@@ -2,36 +2,67 @@
 #include "../Diagnostics/Diagnostics.h"
 
 namespace Ceres::Binding {
-Scope::Scope(Scope* enclosingScope)
-    : enclosingScope(enclosingScope) {};
+void SymbolTable::enterScope() { scopeStarts.push_back(undoLog.size()); }
 
-Scope* Scope::getEnclosingScope() { return enclosingScope; };
+void SymbolTable::exitScope()
+{
+    ASSERT(!scopeStarts.empty());
+
+    auto start = scopeStarts.back();
+    scopeStarts.pop_back();
+
+    // Undo in reverse order, so the declarations visible before entering the scope are restored
+    while (undoLog.size() > start) {
+        auto& undo = undoLog.back();
+        auto it = map.find(undo.name);
+        ASSERT(it != map.end());
+
+        if (undo.shadowed.has_value()) {
+            it->second = *undo.shadowed;
+        } else {
+            map.erase(it);
+        }
+
+        undoLog.pop_back();
+    }
+}
 
-SymbolTableScope::SymbolTableScope(Scope* enclosingScope)
-    : Scope(enclosingScope) {};
+uint32_t SymbolTable::getDepth() const { return scopeStarts.size(); }
 
-void SymbolTableScope::define(std::string const& name, SymbolDeclaration const& symbol)
+void SymbolTable::define(Symbol name, SymbolDeclaration const& symbol)
 {
-    auto [it, inserted_new] = map.insert(std::make_pair(name, symbol));
-    if (!inserted_new) {
-        // An element with that scopeName already existed
+    auto depth = getDepth();
+    auto [it, inserted_new] = map.try_emplace(name, Entry { symbol, depth });
+
+    if (inserted_new) {
+        // The global scope is never exited, so there is nothing to undo
+        if (depth > 0) {
+            undoLog.push_back(UndoEntry { name, std::nullopt });
+        }
+        return;
+    }
+
+    if (it->second.depth == depth) {
+        // An element with that name already existed in this scope
         Diagnostics::report(symbol.getDeclarationNode()->sourceSpan, Diag::duplicate_symbol, name);
-        Diagnostics::report(it->second.getDeclarationNode()->sourceSpan, Diag::duplicate_symbol_note, name);
+        Diagnostics::report(it->second.declaration.getDeclarationNode()->sourceSpan, Diag::duplicate_symbol_note, name);
+        return;
     }
-};
 
-std::optional<SymbolDeclaration> SymbolTableScope::resolve(std::string const& name)
+    // Shadows a declaration of an enclosing scope
+    ASSERT(it->second.depth < depth);
+    undoLog.push_back(UndoEntry { name, it->second });
+    it->second = Entry { symbol, depth };
+}
+
+SymbolDeclaration const* SymbolTable::resolve(Symbol name) const
 {
     auto it = map.find(name);
-    if (it != map.end()) {
-        return it->second;
-    }
-
-    if (getEnclosingScope() == nullptr) {
-        return {};
+    if (it == map.end()) {
+        return nullptr;
     }
 
-    return getEnclosingScope()->resolve(name);
-};
+    return &it->second.declaration;
+}
 
-} // namespace Ceres::Binding
\ No newline at end of file
+} // namespace Ceres::Binding
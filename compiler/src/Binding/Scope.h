@@ -1,33 +1,44 @@
 #ifndef COMPILER_SCOPE_H
 #define COMPILER_SCOPE_H
 
+#include "../utils/Symbol.h"
 #include "SymbolDeclaration.h"
-#include <string>
-#include <unordered_map>
-#include <utility>
+#include <cstdint>
+#include <llvm/ADT/DenseMap.h>
+#include <optional>
+#include <vector>
 
 namespace Ceres::Binding {
-// Abstract class representing a scope
-class Scope {
-protected:
-    Scope* enclosingScope;
-    explicit Scope(Scope* enclosingScope);
-
-public:
-    Scope* getEnclosingScope();
+// Symbol table for all the nested scopes of a compilation unit. Instead of having one map per scope, a single map holds
+// the innermost visible declaration of each name, so resolving a name doesn't depend on how deep the nesting is.
+// Declarations shadowed by an inner scope are saved in an undo log and restored when that scope is exited
+class SymbolTable {
+private:
+    struct Entry {
+        SymbolDeclaration declaration;
+        uint32_t depth;
+    };
 
-    virtual void define(std::string const& name, SymbolDeclaration const& symbol) = 0;
-    virtual std::optional<SymbolDeclaration> resolve(std::string const& name) = 0;
-};
+    struct UndoEntry {
+        Symbol name;
+        // Declaration that was visible before name was defined in the scope, if any
+        std::optional<Entry> shadowed;
+    };
 
-class SymbolTableScope : public Scope {
-private:
-    std::unordered_map<std::string, SymbolDeclaration> map;
+    llvm::DenseMap<Symbol, Entry> map;
+    std::vector<UndoEntry> undoLog;
+    // Size of the undo log when each of the open scopes was entered
+    std::vector<size_t> scopeStarts;
 
 public:
-    explicit SymbolTableScope(Scope* enclosingScope);
-    void define(std::string const& name, SymbolDeclaration const& symbol) override;
-    std::optional<SymbolDeclaration> resolve(std::string const& name) override;
+    void enterScope();
+    void exitScope();
+    // Depth of the innermost open scope, the global scope has depth 0
+    uint32_t getDepth() const;
+
+    void define(Symbol name, SymbolDeclaration const& symbol);
+    // The returned pointer is invalidated by the next call to define() or exitScope()
+    SymbolDeclaration const* resolve(Symbol name) const;
 };
 } // namespace Ceres::Binding
 
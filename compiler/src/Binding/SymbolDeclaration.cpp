@@ -1,6 +1,7 @@
 #include "SymbolDeclaration.h"
 #include "../AST/nodes/FunctionDeclaration.h"
 #include "../AST/nodes/Statements/FunctionDefinition.h"
+#include <llvm/Support/Casting.h>
 
 namespace Ceres::Binding {
 
@@ -8,7 +9,7 @@ AST::FunctionParameter* SymbolDeclaration::getParam() const
 {
     ASSERT(getParamIdx().has_value());
 
-    auto* node = dynamic_cast<AST::FunctionDefinition*>(getDeclarationNode());
+    auto* node = llvm::dyn_cast<AST::FunctionDefinition>(getDeclarationNode());
     ASSERT(node != nullptr);
     ASSERT(getParamIdx().value() < node->parameters.size());
 
@@ -19,7 +20,7 @@ AST::FunctionParameter* SymbolDeclaration::getParam() const
 
 AST::VariableDeclaration* SymbolDeclaration::getVarDecl() const
 {
-    auto* node = dynamic_cast<AST::VariableDeclaration*>(getDeclarationNode());
+    auto* node = llvm::dyn_cast<AST::VariableDeclaration>(getDeclarationNode());
     ASSERT(node != nullptr);
 
     return node;
@@ -27,7 +28,7 @@ AST::VariableDeclaration* SymbolDeclaration::getVarDecl() const
 
 AST::FunctionDefinition* SymbolDeclaration::getFunDef() const
 {
-    auto* node = dynamic_cast<AST::FunctionDefinition*>(getDeclarationNode());
+    auto* node = llvm::dyn_cast<AST::FunctionDefinition>(getDeclarationNode());
     ASSERT(node != nullptr);
 
     return node;
@@ -35,7 +36,7 @@ AST::FunctionDefinition* SymbolDeclaration::getFunDef() const
 
 AST::FunctionDeclaration* SymbolDeclaration::getFunDec() const
 {
-    auto* node = dynamic_cast<AST::FunctionDeclaration*>(getDeclarationNode());
+    auto* node = llvm::dyn_cast<AST::FunctionDeclaration>(getDeclarationNode());
     ASSERT(node != nullptr);
 
     return node;
@@ -98,7 +99,7 @@ Typing::Constness SymbolDeclaration::getConstness() const
     }
 }
 
-std::string SymbolDeclaration::getId()
+Symbol SymbolDeclaration::getId()
 {
     switch (kind) {
 
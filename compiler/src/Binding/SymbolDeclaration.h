@@ -4,9 +4,9 @@
 #include "../AST/nodes/Node.h"
 #include "../AST/nodes/Statements/VariableDeclaration.h"
 #include "../Typing/Type.h"
+#include "../utils/Symbol.h"
 #include <cstddef>
 #include <optional>
-#include <string>
 
 // Forward declarations
 namespace Ceres::AST {
@@ -47,8 +47,7 @@ public:
     std::optional<size_t> getParamIdx() const;
     Typing::Constness getConstness() const;
     Type* getType() const;
-    // TODO: string view
-    std::string getId();
+    Symbol getId();
 
     Ceres::AST::FunctionParameter* getParam() const;
     Ceres::AST::VariableDeclaration* getVarDecl() const;
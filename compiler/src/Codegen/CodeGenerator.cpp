@@ -1,36 +1,42 @@
 #include "CodeGenerator.h"
 #include "../Diagnostics/Diagnostics.h"
+#include "JITRuntime.h"
+#include "TestRuntime.h"
 
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/PassTimingInfo.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
-#include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 
 namespace Ceres::Codegen {
 
-CodeGenerator::CodeGenerator(llvm::LLVMContext* context)
-    : visitor(context)
+CodeGenerator::CodeGenerator(
+    llvm::orc::ThreadSafeContext context, CodegenOptions const& options, llvm::TimerGroup* timerGroup)
+    : visitor(context.getContext(), options)
+    , options(options)
+    , context(std::move(context))
 {
     ASSERT(Diagnostics::getNumErrors() == 0);
+
+    if (timerGroup != nullptr) {
+        irGenerationTimer.init("irgen", "LLVM IR generation", *timerGroup);
+        optimizationTimer.init("opt", "LLVM IR optimization", *timerGroup);
+        emissionTimer.init("emit", "Object file emission", *timerGroup);
+    }
 }
 
-void CodeGenerator::generateCode(AST::CompilationUnit& compilationUnit)
+std::unique_ptr<llvm::TargetMachine> CodeGenerator::createTargetMachine() const
 {
-    visitor.visit(compilationUnit);
-    // TODO: Better printing of this
-    visitor.module->print(llvm::errs(), nullptr);
-
-    // TODO: Use parameters for output filename
     auto targetTriple = llvm::sys::getDefaultTargetTriple();
 
-    // Initialize all targets for emitting code
-    llvm::InitializeNativeTarget();
-    llvm::InitializeNativeTargetAsmParser();
-    llvm::InitializeNativeTargetAsmPrinter();
-
+    // Note: The native target is registered by InitCeres, before compiling any file
     std::string error;
     auto const* target = llvm::TargetRegistry::lookupTarget(targetTriple, error);
 
@@ -38,17 +44,39 @@ void CodeGenerator::generateCode(AST::CompilationUnit& compilationUnit)
         Log::panic("Target lookup failed: {}", error);
     }
 
-    // TODO: Pass all this options via command line parameters
-    auto const* CPU = "generic";
-    auto const* features = "";
-
     llvm::TargetOptions opt;
+    opt.AllowFPOpFusion = getFPOpFusion(options.fastMath.contract);
     auto relocationModel = llvm::Optional<llvm::Reloc::Model>();
-    auto* targetMachine = target->createTargetMachine(targetTriple, CPU, features, opt, relocationModel);
+    return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(targetTriple, options.targetCPU,
+        options.targetFeatures, opt, relocationModel, llvm::None, getLLVMCodeGenOptLevel(options.optimizationLevel)));
+}
+
+void CodeGenerator::generateModule(AST::CompilationUnit& compilationUnit, llvm::TargetMachine* targetMachine)
+{
+    {
+        llvm::TimeRegion region(getTimerIfEnabled(irGenerationTimer));
+        visitor.visit(compilationUnit);
+    }
+
+    if (options.dumpIR) {
+        visitor.module->print(llvm::outs(), nullptr);
+    }
+
     visitor.module->setDataLayout(targetMachine->createDataLayout());
-    visitor.module->setTargetTriple(targetTriple);
+    visitor.module->setTargetTriple(targetMachine->getTargetTriple().str());
+
+    llvm::TimeRegion region(getTimerIfEnabled(optimizationTimer));
+    optimizeModule(targetMachine);
+}
+
+void CodeGenerator::generateCode(AST::CompilationUnit& compilationUnit)
+{
+    auto targetMachine = createTargetMachine();
+    generateModule(compilationUnit, targetMachine.get());
+
+    llvm::TimeRegion region(getTimerIfEnabled(emissionTimer));
 
-    auto const* filename = "output.o";
+    auto const& filename = options.outputFilename;
     std::error_code error_code;
     llvm::raw_fd_ostream dest(filename, error_code, llvm::sys::fs::OF_None);
 
@@ -65,6 +93,194 @@ void CodeGenerator::generateCode(AST::CompilationUnit& compilationUnit)
 
     pass.run(*visitor.module);
     dest.flush();
+
+    if (llvm::TimePassesIsEnabled) {
+        // Note: The legacy pass manager used for code generation records its timings globally, so they are only
+        // enabled when a single file is compiled
+        llvm::reportAndResetTimings(&Diagnostics::getOutputStream());
+    }
+}
+
+int CodeGenerator::runJIT(AST::CompilationUnit& compilationUnit)
+{
+    auto targetMachine = createTargetMachine();
+    generateModule(compilationUnit, targetMachine.get());
+
+    // Test programs define testMain, while standalone programs define main, which may not return anything
+    bool isTest = true;
+    llvm::Function* entryFunction = visitor.module->getFunction("testMain");
+    if (entryFunction == nullptr) {
+        isTest = false;
+        entryFunction = visitor.module->getFunction("main");
+    }
+    if (entryFunction == nullptr) {
+        Log::panic("Could not find entry point: no testMain or main function");
+    }
+
+    // The entry point is called through a function pointer, which must have the same signature
+    bool returnsVoid = entryFunction->getReturnType()->isVoidTy();
+    if (!entryFunction->arg_empty() || !(entryFunction->getReturnType()->isIntegerTy(32) || (returnsVoid && !isTest))) {
+        for (auto* def : compilationUnit.functionDefinitions) {
+            if (def->llvmFunction == entryFunction) {
+                Diagnostics::report(def->functionNameSpan, Diag::invalid_entry_point, entryFunction->getName().str(),
+                    isTest ? "'i32'" : "'i32' or nothing");
+            }
+        }
+        Diagnostics::flush();
+        return 1;
+    }
+    std::string entryName = entryFunction->getName().str();
+
+    // Build the JIT for the same target the module has been optimized for
+    llvm::orc::JITTargetMachineBuilder machineBuilder(targetMachine->getTargetTriple());
+    machineBuilder.setCPU(options.targetCPU);
+    machineBuilder.getFeatures() = llvm::SubtargetFeatures(options.targetFeatures);
+    machineBuilder.setCodeGenOptLevel(getLLVMCodeGenOptLevel(options.optimizationLevel));
+    machineBuilder.getOptions().AllowFPOpFusion = getFPOpFusion(options.fastMath.contract);
+
+    auto maybeJIT = llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(machineBuilder)).create();
+    if (!maybeJIT) {
+        Log::panic("Could not create JIT: {}", llvm::toString(maybeJIT.takeError()));
+    }
+    auto& jit = *maybeJIT;
+
+    // Functions that are not part of the runtime (for example, from libc) are looked up in the compiler process
+    auto processSymbols
+        = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(jit->getDataLayout().getGlobalPrefix());
+    if (!processSymbols) {
+        Log::panic("Could not load process symbols: {}", llvm::toString(processSymbols.takeError()));
+    }
+    jit->getMainJITDylib().addGenerator(std::move(*processSymbols));
+    defineJITRuntimeSymbols(*jit);
+
+    if (auto error = jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(visitor.module), context))) {
+        Log::panic("Could not add module to the JIT: {}", llvm::toString(std::move(error)));
+    }
+
+    auto entryPoint = jit->lookup(entryName);
+    if (!entryPoint) {
+        Log::panic("Could not find entry point: {}", llvm::toString(entryPoint.takeError()));
+    }
+
+    if (returnsVoid) {
+        llvm::jitTargetAddressToFunction<void (*)()>(entryPoint->getAddress())();
+        return 0;
+    }
+
+    int32_t result = llvm::jitTargetAddressToFunction<int32_t (*)()>(entryPoint->getAddress())();
+    if (!isTest) {
+        return result;
+    }
+
+    // Behave like tests/codegen/test_driver.cpp
+    if (result != 0) {
+        TestRuntime::failed("testMain() returned non-zero value '" + std::to_string(result) + "'");
+    }
+
+    TestRuntime::passed();
+    return 0;
+}
+
+std::string CodeGenerator::getHostCPUName() { return llvm::sys::getHostCPUName().str(); }
+
+std::string CodeGenerator::getHostCPUFeatures()
+{
+    llvm::SubtargetFeatures features;
+    llvm::StringMap<bool> hostFeatures;
+
+    // Note: getHostCPUFeatures can fail on some platforms, in which case we just don't enable any feature
+    if (llvm::sys::getHostCPUFeatures(hostFeatures)) {
+        for (auto const& feature : hostFeatures) {
+            features.AddFeature(feature.getKey(), feature.getValue());
+        }
+    }
+
+    return features.getString();
+}
+
+void CodeGenerator::optimizeModule(llvm::TargetMachine* targetMachine)
+{
+    // Time each pass run by the pipeline. The report is printed when the handler is destroyed
+    llvm::PassInstrumentationCallbacks instrumentationCallbacks;
+    llvm::TimePassesHandler timePassesHandler(options.timePasses);
+    timePassesHandler.setOutStream(Diagnostics::getOutputStream());
+    timePassesHandler.registerCallbacks(instrumentationCallbacks);
+
+    // Analysis managers must be declared in this order so they are destroyed in the correct one
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cgsccAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+
+    // Passing the target machine lets the pipeline query target specific costs (TargetTransformInfo)
+    llvm::PassBuilder passBuilder(targetMachine, llvm::PipelineTuningOptions(), llvm::None, &instrumentationCallbacks);
+
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(
+        loopAnalysisManager, functionAnalysisManager, cgsccAnalysisManager, moduleAnalysisManager);
+
+    auto level = getLLVMOptimizationLevel(options.optimizationLevel);
+
+    llvm::ModulePassManager modulePassManager;
+    if (level == llvm::OptimizationLevel::O0) {
+        modulePassManager = passBuilder.buildO0DefaultPipeline(level);
+    } else {
+        modulePassManager = passBuilder.buildPerModuleDefaultPipeline(level);
+    }
+
+    modulePassManager.run(*visitor.module, moduleAnalysisManager);
+}
+
+llvm::OptimizationLevel CodeGenerator::getLLVMOptimizationLevel(OptimizationLevel level)
+{
+    switch (level) {
+    case OptimizationLevel::O0:
+        return llvm::OptimizationLevel::O0;
+    case OptimizationLevel::O1:
+        return llvm::OptimizationLevel::O1;
+    case OptimizationLevel::O2:
+        return llvm::OptimizationLevel::O2;
+    case OptimizationLevel::O3:
+        return llvm::OptimizationLevel::O3;
+    case OptimizationLevel::Os:
+        return llvm::OptimizationLevel::Os;
+    default:
+        NOT_IMPLEMENTED();
+    }
+}
+
+llvm::CodeGenOpt::Level CodeGenerator::getLLVMCodeGenOptLevel(OptimizationLevel level)
+{
+    switch (level) {
+    case OptimizationLevel::O0:
+        return llvm::CodeGenOpt::None;
+    case OptimizationLevel::O1:
+        return llvm::CodeGenOpt::Less;
+    case OptimizationLevel::O2:
+    case OptimizationLevel::Os:
+        return llvm::CodeGenOpt::Default;
+    case OptimizationLevel::O3:
+        return llvm::CodeGenOpt::Aggressive;
+    default:
+        NOT_IMPLEMENTED();
+    }
+}
+
+llvm::FPOpFusion::FPOpFusionMode CodeGenerator::getFPOpFusion(FPContractMode contract)
+{
+    switch (contract) {
+    case FPContractMode::Off:
+        return llvm::FPOpFusion::Strict;
+    case FPContractMode::On:
+    case FPContractMode::Fast:
+        // Note: Not Fast, which would fuse the operations of every function. With -ffp-contract=fast the operations
+        // that can be fused have the contract flag instead, so functions with fast_math(off) are left alone
+        return llvm::FPOpFusion::Standard;
+    }
+    ASSERT_NOT_REACHED();
 }
 
 } // Codegen
\ No newline at end of file
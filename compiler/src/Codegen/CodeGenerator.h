@@ -1,17 +1,58 @@
-
 #ifndef COMPILER_CODEGENERATOR_H
 #define COMPILER_CODEGENERATOR_H
 
+#include "CodegenOptions.h"
 #include "CodegenVisitor.h"
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Support/CodeGen.h>
+#include <llvm/Support/Timer.h>
+#include <llvm/Target/TargetMachine.h>
+
 namespace Ceres::Codegen {
 
 class CodeGenerator {
     CodegenVisitor visitor;
+    CodegenOptions options;
+    llvm::orc::ThreadSafeContext context;
+
+    // Note: Timers are only initialized if a timer group is given
+    llvm::Timer irGenerationTimer;
+    llvm::Timer optimizationTimer;
+    llvm::Timer emissionTimer;
+
+    static llvm::Timer* getTimerIfEnabled(llvm::Timer& timer) { return timer.isInitialized() ? &timer : nullptr; }
+
+    static llvm::OptimizationLevel getLLVMOptimizationLevel(OptimizationLevel level);
+    static llvm::CodeGenOpt::Level getLLVMCodeGenOptLevel(OptimizationLevel level);
+    static llvm::FPOpFusion::FPOpFusionMode getFPOpFusion(FPContractMode contract);
+
+    // Creates a target machine for the host triple, with the CPU, features and optimization level in the options
+    std::unique_ptr<llvm::TargetMachine> createTargetMachine() const;
+
+    // Lowers the AST to an LLVM module, targeting it to the given machine and optimizing it
+    void generateModule(AST::CompilationUnit& compilationUnit, llvm::TargetMachine* targetMachine);
+
+    // Runs the LLVM module pass pipeline corresponding to the selected optimization level
+    void optimizeModule(llvm::TargetMachine* targetMachine);
 
 public:
-    CodeGenerator(llvm::LLVMContext* context);
+    // If a timer group is given, the time spent in each code generation phase is recorded in it
+    CodeGenerator(llvm::orc::ThreadSafeContext context, CodegenOptions const& options = {},
+        llvm::TimerGroup* timerGroup = nullptr);
 
+    // Generates an object file for the compilation unit
     void generateCode(AST::CompilationUnit& compilationUnit);
+
+    // Compiles the compilation unit in memory and executes its testMain (or main) function in this process, without
+    // writing an object file or linking. Returns the exit code of the program
+    int runJIT(AST::CompilationUnit& compilationUnit);
+
+    // Returns the name of the host CPU, as used by -mcpu
+    static std::string getHostCPUName();
+
+    // Returns the subtarget features supported by the host CPU, as used by -mattr
+    static std::string getHostCPUFeatures();
 };
 
 } // Codegen
@@ -0,0 +1,70 @@
+#ifndef COMPILER_CODEGENOPTIONS_H
+#define COMPILER_CODEGENOPTIONS_H
+
+#include "../AST/FunctionAttributes.h"
+#include <string>
+
+namespace Ceres::Codegen {
+
+enum class OptimizationLevel {
+    O0, // No optimizations
+    O1, // Optimize quickly without destroying debuggability
+    O2, // Fast execution, default optimization level
+    O3, // Fast execution, enabling optimizations that increase code size
+    Os  // Optimize for code size
+};
+
+enum class FPContractMode {
+    Off,  // Never fuse a multiplication and an addition
+    On,   // Fuse them when they are in the same expression, as in `a * b + c`
+    Fast  // Fuse them anywhere, even across statements
+};
+
+// Floating point optimizations that can change the results of the program. Each of them is an LLVM fast-math flag
+struct FastMathOptions {
+    bool associativeMath = false; // reassoc: Reorder operations, for example to vectorize reductions
+    bool noNaNs = false;          // nnan: Assume that operands and results are never NaN
+    bool noInfinities = false;    // ninf: Assume that operands and results are never infinite
+    bool noSignedZeros = false;   // nsz: Ignore the sign of zeros
+    bool reciprocalMath = false;  // arcp: Allow `x / y` to be computed as `x * (1 / y)`
+    FPContractMode contract = FPContractMode::On;
+
+    // Everything enabled, as with -ffast-math
+    static FastMathOptions getFast() { return { true, true, true, true, true, FPContractMode::Fast }; }
+
+    // Strict IEEE 754 semantics, every operation is rounded on its own
+    static FastMathOptions getStrict() { return { false, false, false, false, false, FPContractMode::Off }; }
+};
+
+// Options that control how the generated LLVM-IR is optimized and lowered to an object file
+struct CodegenOptions {
+    OptimizationLevel optimizationLevel = OptimizationLevel::O0;
+
+    // Build SSA values and phi nodes directly for local variables that don't need to live in memory, instead of
+    // creating an alloca for each of them and relying on mem2reg/SROA to clean them up
+    bool directSSA = false;
+
+    // What integer overflow does in the functions that don't override it with the overflow attribute
+    AST::OverflowMode overflowMode = AST::OverflowMode::Wrap;
+
+    // Floating point semantics of the functions that don't override them with the fast_math attribute
+    FastMathOptions fastMath;
+
+    // CPU the generated code is tuned for, and subtarget features in LLVM's "+feature,-feature" syntax. They are both
+    // passed to the target machine and recorded as function attributes, so IR passes such as the vectorizer see them
+    std::string targetCPU = "generic";
+    std::string targetFeatures;
+
+    // Object file the generated code is written to
+    std::string outputFilename = "output.o";
+
+    // Report the time spent in each pass of the LLVM optimization pipeline
+    bool timePasses = false;
+
+    // Print the LLVM-IR of the module as it's generated, before optimizing it
+    bool dumpIR = false;
+};
+
+} // namespace Ceres::Codegen
+
+#endif // COMPILER_CODEGENOPTIONS_H
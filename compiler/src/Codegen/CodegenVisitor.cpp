@@ -1,25 +1,43 @@
 #include "CodegenVisitor.h"
+#include "FunctionReachability.h"
 #include "../utils/SourceManager.h"
+#include "llvm/IR/CFG.h"
 #include "llvm/IR/Verifier.h"
 
 namespace Ceres::Codegen {
 
-CodegenVisitor::CodegenVisitor(llvm::LLVMContext* context)
+CodegenVisitor::CodegenVisitor(llvm::LLVMContext* context, CodegenOptions const& options)
     : context(context)
+    , llvmTypes(*context)
+    , options(options)
+    , overflowMode(options.overflowMode)
 {
     builder = std::make_unique<llvm::IRBuilder<>>(*context);
 }
 
-llvm::Value* CodegenVisitor::doVisitCompilationUnit(AST::CompilationUnit& unit)
+llvm::Value* CodegenVisitor::visit(AST::Node& node)
+{
+    auto* expr = llvm::dyn_cast<AST::Expression>(&node);
+    if (expr != nullptr && expr->constantValue.has_value() && !LHSVisitingMode) {
+        return generateConstant(*expr);
+    }
+    return StaticASTVisitor::visit(node);
+}
+
+llvm::Value* CodegenVisitor::visitCompilationUnit(AST::CompilationUnit& unit)
 {
     // Create llvm::module
     // TODO: Change module name to something meaningful
     module = std::make_unique<llvm::Module>("CeresModule", *context);
 
+    FunctionReachabilityVisitor().run(unit);
+
     //  First visit all function declarations and definitions (before visiting children),
     //      to setup adequate pointers.
     for (auto& def : unit.functionDefinitions) {
-        generateFunctionDefinitionPrototype(*def);
+        if (def->isReachable) {
+            generateFunctionDefinitionPrototype(*def);
+        }
     }
 
     for (auto& dec : unit.functionDeclarations) {
@@ -37,37 +55,70 @@ llvm::Value* CodegenVisitor::doVisitCompilationUnit(AST::CompilationUnit& unit)
 void CodegenVisitor::generateFunctionDefinitionPrototype(AST::FunctionDefinition& def)
 {
     // Generate the function
-    llvm::FunctionType* functionType = llvm::cast<llvm::FunctionType>(def.functionType->getLLVMType());
+    llvm::FunctionType* functionType = llvm::cast<llvm::FunctionType>(llvmTypes.get(def.functionType));
 
-    // TODO: For now, all functions will be defined as external linkage
+    // Functions that are not exported are only visible inside the module, so LLVM can inline them and delete them, or
+    // change their signature. If they are only called directly, they also use the fast calling convention
     // TODO: Add function name mangling
-    llvm::Function* function
-        = llvm::Function::Create(functionType, llvm::Function::ExternalLinkage, def.id, module.get());
+    auto linkage = def.isExported() ? llvm::Function::ExternalLinkage : llvm::Function::InternalLinkage;
+    llvm::Function* function = llvm::Function::Create(functionType, linkage, def.id.getText(), module.get());
+    if (!def.isExported() && !def.isAddressTaken) {
+        function->setCallingConv(llvm::CallingConv::Fast);
+    }
 
     // Set readable name for all variables in prototype
     unsigned int index = 0;
     for (auto& arg : function->args()) {
-        arg.setName(def.parameters[index].id);
+        arg.setName(def.parameters[index].id.getText());
         index++;
     }
 
+    addTargetAttributes(function);
+
     def.llvmFunction = function;
 }
 
+void CodegenVisitor::setFastMath(FastMathOptions const& newFastMath)
+{
+    fastMath = newFastMath;
+
+    llvm::FastMathFlags flags;
+    flags.setAllowReassoc(fastMath.associativeMath);
+    flags.setNoNaNs(fastMath.noNaNs);
+    flags.setNoInfs(fastMath.noInfinities);
+    flags.setNoSignedZeros(fastMath.noSignedZeros);
+    flags.setAllowReciprocal(fastMath.reciprocalMath);
+    // Note: With -ffp-contract=on the fusions are chosen while generating the expressions, see
+    // getContractableMultiplication, so only -ffp-contract=fast lets LLVM fuse any operation
+    flags.setAllowContract(fastMath.contract == FPContractMode::Fast);
+    builder->setFastMathFlags(flags);
+}
+
+void CodegenVisitor::addTargetAttributes(llvm::Function* function) const
+{
+    if (!options.targetCPU.empty()) {
+        function->addFnAttr("target-cpu", options.targetCPU);
+    }
+
+    if (!options.targetFeatures.empty()) {
+        function->addFnAttr("target-features", options.targetFeatures);
+    }
+}
+
 void CodegenVisitor::generateFunctionDeclarationPrototype(AST::FunctionDeclaration& dec)
 {
     // Generate the function
-    llvm::FunctionType* functionType = llvm::cast<llvm::FunctionType>(dec.functionType->getLLVMType());
+    llvm::FunctionType* functionType = llvm::cast<llvm::FunctionType>(llvmTypes.get(dec.functionType));
 
     // TODO: For now, all functions will be defined as external linkage
     // TODO: Add function name mangling
-    llvm::Function* function
-        = llvm::Function::Create(functionType, llvm::Function::ExternalLinkage, dec.functionName, module.get());
+    llvm::Function* function = llvm::Function::Create(
+        functionType, llvm::Function::ExternalLinkage, dec.functionName.getText(), module.get());
 
     // Set readable name for all variables in prototype
     unsigned int index = 0;
     for (auto& arg : function->args()) {
-        arg.setName(dec.parameters[index].id);
+        arg.setName(dec.parameters[index].id.getText());
         index++;
     }
 
@@ -76,8 +127,12 @@ void CodegenVisitor::generateFunctionDeclarationPrototype(AST::FunctionDeclarati
 
 void CodegenVisitor::generateGlobalVariablePrototype(AST::VariableDeclaration& dec) { NOT_IMPLEMENTED(); }
 
-llvm::Value* CodegenVisitor::doVisitFunctionDefinition(AST::FunctionDefinition& def)
+llvm::Value* CodegenVisitor::visitFunctionDefinition(AST::FunctionDefinition& def)
 {
+    if (!def.isReachable) {
+        return nullptr;
+    }
+
     // TODO: Add support for nested functions
     ASSERT(def.parentFunction == nullptr);
     ASSERT(def.llvmFunction != nullptr);
@@ -87,29 +142,58 @@ llvm::Value* CodegenVisitor::doVisitFunctionDefinition(AST::FunctionDefinition&
     llvm::BasicBlock* basicBlock = llvm::BasicBlock::Create(*context, "entry", function);
     builder->SetInsertPoint(basicBlock);
 
+    // The entry block has no predecessors
+    sealBlock(basicBlock);
+
     // Create alloca for arguments
     for (auto& arg : def.parameters) {
-        arg.llvmAlloca = allocateLocalVariable(arg.type, arg.id, builder.get());
+        if (!isSSAVariable(&arg)) {
+            arg.llvmAlloca = allocateLocalVariable(arg.type, arg.id.getText(), builder.get());
+        }
     }
 
     // Create store for arguments
     unsigned paramIndex = 0;
     for (auto& llvmArg : def.llvmFunction->args()) {
         auto const& arg = def.parameters[paramIndex];
-        generateStore(arg.llvmAlloca, &llvmArg);
+        if (isSSAVariable(&arg)) {
+            writeSSAVariable(&arg, &llvmArg);
+        } else {
+            generateStore(arg.llvmAlloca, &llvmArg);
+        }
         paramIndex++;
     }
 
     auto* oldCurrentFunction = currentFunction;
     currentFunction = function;
+    overflowMode = def.attributes.overflowMode.value_or(options.overflowMode);
+    if (def.attributes.fastMath.has_value()) {
+        setFastMath(*def.attributes.fastMath ? FastMathOptions::getFast() : FastMathOptions::getStrict());
+    } else {
+        setFastMath(options.fastMath);
+    }
     visitChildren(def);
     currentFunction = oldCurrentFunction;
 
-    if (basicBlock->getTerminator() == nullptr) {
-        ASSERT(def.returnType == VoidType::get());
-        builder->CreateRetVoid();
+    // Note: The current block is not necessarily the entry block if there has been any control flow
+    if (builder->GetInsertBlock()->getTerminator() == nullptr) {
+        if (def.returnType == VoidType::get()) {
+            builder->CreateRetVoid();
+        } else {
+            // FlowCheckVisitor guarantees that every path of a non-void function returns, so this block can't be
+            // reached (for example, the continuation of an if statement whose branches both return)
+            builder->CreateUnreachable();
+        }
     }
 
+    if (overflowTrapBlock != nullptr) {
+        // Keep the cold block out of the way of the rest of the code
+        overflowTrapBlock->moveAfter(&function->back());
+        overflowTrapBlock = nullptr;
+    }
+
+    ssaBuilder.clear();
+
     if (llvm::verifyFunction(*function, &llvm::errs())) {
         Log::panic("Function verification error when verifying function '{}'", def.id);
     }
@@ -117,7 +201,7 @@ llvm::Value* CodegenVisitor::doVisitFunctionDefinition(AST::FunctionDefinition&
     return function;
 }
 
-llvm::Value* CodegenVisitor::doVisitFunctionDeclaration(AST::FunctionDeclaration& dec)
+llvm::Value* CodegenVisitor::visitFunctionDeclaration(AST::FunctionDeclaration& dec)
 {
     ASSERT(dec.llvmFunction != nullptr);
     return dec.llvmFunction;
@@ -125,7 +209,7 @@ llvm::Value* CodegenVisitor::doVisitFunctionDeclaration(AST::FunctionDeclaration
 
 /* Statements */
 
-llvm::Value* CodegenVisitor::doVisitBlockStatement(AST::BlockStatement& stm)
+llvm::Value* CodegenVisitor::visitBlockStatement(AST::BlockStatement& stm)
 {
     // TODO: Should block statement create a BasicBlock? For now we won't
 
@@ -142,15 +226,27 @@ llvm::Value* CodegenVisitor::doVisitBlockStatement(AST::BlockStatement& stm)
     return nullptr;
 }
 
-llvm::Value* CodegenVisitor::doVisitExpressionStatement(AST::ExpressionStatement& stm)
+llvm::Value* CodegenVisitor::visitExpressionStatement(AST::ExpressionStatement& stm)
 {
     visitChildren(stm);
     return nullptr;
 }
 
-llvm::Value* CodegenVisitor::doVisitForStatement(AST::ForStatement& stm) { TODO(); }
+llvm::Value* CodegenVisitor::visitForStatement(AST::ForStatement& stm)
+{
+    ASSERT(!shouldGenerateShortCircuitBooleanCode);
+
+    if (stm.maybeInitDeclaration != nullptr) {
+        visit(*stm.maybeInitDeclaration);
+    } else if (stm.maybeInitExpression != nullptr) {
+        visit(*stm.maybeInitExpression);
+    }
+
+    generateLoop(stm.maybeConditionExpr, *stm.body, stm.maybeUpdateExpr, stm.hints);
+    return nullptr;
+}
 
-llvm::Value* CodegenVisitor::doVisitIfStatement(AST::IfStatement& stm)
+llvm::Value* CodegenVisitor::visitIfStatement(AST::IfStatement& stm)
 {
     ASSERT(!shouldGenerateShortCircuitBooleanCode);
 
@@ -162,6 +258,13 @@ llvm::Value* CodegenVisitor::doVisitIfStatement(AST::IfStatement& stm)
 
     auto* contBasicBlock = llvm::BasicBlock::Create(*context, "ifcont", currentFunction);
 
+    // Branch to the continuation block, unless the current block already ends in a terminator (return)
+    auto generateBranchToCont = [&]() {
+        if (builder->GetInsertBlock()->getTerminator() == nullptr) {
+            builder->CreateBr(contBasicBlock);
+        }
+    };
+
     if (stm.maybeElseStatement != nullptr) {
         // There is an else statement
 
@@ -170,15 +273,18 @@ llvm::Value* CodegenVisitor::doVisitIfStatement(AST::IfStatement& stm)
         visit(*stm.condition);
         disableBooleanShortCircuit();
 
+        sealBlock(thenBasicBlock);
+        sealBlock(elseBasicBlock);
+
         /* Visit then block */
         builder->SetInsertPoint(thenBasicBlock);
         visit(*stm.thenBlock);
-        builder->CreateBr(contBasicBlock);
+        generateBranchToCont();
 
         /* Visit else block */
         builder->SetInsertPoint(elseBasicBlock);
         visit(*stm.maybeElseStatement);
-        builder->CreateBr(contBasicBlock);
+        generateBranchToCont();
 
     } else {
         // There is no else
@@ -188,12 +294,17 @@ llvm::Value* CodegenVisitor::doVisitIfStatement(AST::IfStatement& stm)
         visit(*stm.condition);
         disableBooleanShortCircuit();
 
+        sealBlock(thenBasicBlock);
+
         /*Visit then block*/
         builder->SetInsertPoint(thenBasicBlock);
         visit(*stm.thenBlock);
-        builder->CreateBr(contBasicBlock);
+        generateBranchToCont();
     }
 
+    // All the branches to the continuation block have been generated
+    sealBlock(contBasicBlock);
+
     builder->SetInsertPoint(contBasicBlock);
     return nullptr;
 }
@@ -214,7 +325,7 @@ void CodegenVisitor::disableBooleanShortCircuit()
     falseLabel = nullptr;
 }
 
-llvm::Value* CodegenVisitor::doVisitReturnStatement(AST::ReturnStatement& stm)
+llvm::Value* CodegenVisitor::visitReturnStatement(AST::ReturnStatement& stm)
 {
     if (stm.expr != nullptr) {
         auto* value = visit(*stm.expr);
@@ -227,54 +338,236 @@ llvm::Value* CodegenVisitor::doVisitReturnStatement(AST::ReturnStatement& stm)
     return nullptr;
 }
 
-llvm::Value* CodegenVisitor::doVisitWhileStatement(AST::WhileStatement& stm) { TODO(); }
+llvm::Value* CodegenVisitor::visitWhileStatement(AST::WhileStatement& stm)
+{
+    ASSERT(!shouldGenerateShortCircuitBooleanCode);
+
+    generateLoop(stm.condition, *stm.body, nullptr, stm.hints);
+    return nullptr;
+}
+
+void CodegenVisitor::generateLoop(
+    AST::Expression* condition, AST::BlockStatement& body, AST::Expression* update, AST::LoopHints const& hints)
+{
+    // The loop is laid out as:
+    //   (current block): if (condition) goto preheader else goto end
+    //   preheader: goto body
+    //   body: ...; goto latch
+    //   latch: update; if (condition) goto body else goto exit
+    //   exit: goto end
+    //   end:
+    // The body is the header of the loop and the latch is the only block with a back edge. Every edge leaving the loop
+    // goes to the exit block, whose only predecessor is in the loop
+    auto* preheaderBasicBlock = llvm::BasicBlock::Create(*context, "loop.preheader", currentFunction);
+    auto* bodyBasicBlock = llvm::BasicBlock::Create(*context, "loop.body", currentFunction);
+    auto* latchBasicBlock = llvm::BasicBlock::Create(*context, "loop.latch", currentFunction);
+    auto* exitBasicBlock = llvm::BasicBlock::Create(*context, "loop.exit", currentFunction);
+    auto* endBasicBlock = llvm::BasicBlock::Create(*context, "loop.end", currentFunction);
+
+    // Guard, the first check of the condition
+    generateConditionalBranch(condition, preheaderBasicBlock, endBasicBlock);
+    sealBlock(preheaderBasicBlock);
+
+    builder->SetInsertPoint(preheaderBasicBlock);
+    builder->CreateBr(bodyBasicBlock);
+
+    builder->SetInsertPoint(bodyBasicBlock);
+    visit(body);
+
+    if (builder->GetInsertBlock()->getTerminator() == nullptr) {
+        builder->CreateBr(latchBasicBlock);
+        sealBlock(latchBasicBlock);
+
+        builder->SetInsertPoint(latchBasicBlock);
+        if (update != nullptr) {
+            visit(*update);
+        }
+        generateConditionalBranch(condition, bodyBasicBlock, exitBasicBlock);
+        sealBlock(exitBasicBlock);
+
+        builder->SetInsertPoint(exitBasicBlock);
+        builder->CreateBr(endBasicBlock);
+
+        if (!hints.empty()) {
+            auto* loopID = createLoopMetadata(hints);
+            for (auto* predecessor : llvm::predecessors(bodyBasicBlock)) {
+                if (predecessor != preheaderBasicBlock) {
+                    predecessor->getTerminator()->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+                }
+            }
+        }
+    } else {
+        // The body always returns, so it's never repeated
+        latchBasicBlock->eraseFromParent();
+        exitBasicBlock->eraseFromParent();
+    }
+
+    // All the back edges and the branches to the end block have been generated
+    sealBlock(bodyBasicBlock);
+    sealBlock(endBasicBlock);
+
+    builder->SetInsertPoint(endBasicBlock);
+}
+
+void CodegenVisitor::generateConditionalBranch(
+    AST::Expression* condition, llvm::BasicBlock* trueBlock, llvm::BasicBlock* falseBlock)
+{
+    if (condition == nullptr) {
+        builder->CreateBr(trueBlock);
+        return;
+    }
+
+    enableBooleanShortCircuit(trueBlock, falseBlock);
+    visit(*condition);
+    disableBooleanShortCircuit();
+}
+
+llvm::MDNode* CodegenVisitor::createLoopMetadata(AST::LoopHints const& hints)
+{
+    auto* int1Type = llvm::Type::getInt1Ty(*context);
+    auto* int32Type = llvm::Type::getInt32Ty(*context);
+
+    // The first operand is the loop ID itself, which makes it distinct from the ID of any other loop
+    llvm::SmallVector<llvm::Metadata*, 4> operands { nullptr };
+    auto addProperty = [&](llvm::StringRef name, llvm::Constant* value = nullptr) {
+        llvm::SmallVector<llvm::Metadata*, 2> property { llvm::MDString::get(*context, name) };
+        if (value != nullptr) {
+            property.push_back(llvm::ConstantAsMetadata::get(value));
+        }
+        operands.push_back(llvm::MDNode::get(*context, property));
+    };
+
+    if (hints.unrollCount.has_value()) {
+        if (*hints.unrollCount == 1) {
+            addProperty("llvm.loop.unroll.disable");
+        } else {
+            addProperty("llvm.loop.unroll.count", llvm::ConstantInt::get(int32Type, *hints.unrollCount));
+        }
+    }
+
+    if (hints.vectorizeWidth.has_value()) {
+        if (*hints.vectorizeWidth == 1) {
+            addProperty("llvm.loop.vectorize.enable", llvm::ConstantInt::getFalse(int1Type));
+        } else {
+            addProperty("llvm.loop.vectorize.enable", llvm::ConstantInt::getTrue(int1Type));
+            addProperty("llvm.loop.vectorize.width", llvm::ConstantInt::get(int32Type, *hints.vectorizeWidth));
+        }
+    }
+
+    auto* loopID = llvm::MDNode::getDistinct(*context, operands);
+    loopID->replaceOperandWith(0, loopID);
+    return loopID;
+}
 
 /* Expressions */
 
-llvm::Value* CodegenVisitor::doVisitAssignmentExpression(AST::AssignmentExpression& expr)
+llvm::Value* CodegenVisitor::visitAssignmentExpression(AST::AssignmentExpression& expr)
 {
+    auto* identifier = llvm::dyn_cast<AST::IdentifierExpression>(expr.expressionLHS);
+    ASSERT(identifier != nullptr);
+    ASSERT(identifier->decl.has_value());
+
+    auto variable = getSSAVariable(*identifier->decl);
+    if (variable != nullptr && isSSAVariable(variable)) {
+        // No memory involved: the assignment just creates a new definition of the variable
+        llvm::Value* value = generateAssignedValue(expr, [&]() { return readSSAVariable(variable, expr.type); });
+        writeSSAVariable(variable, value);
+        return value;
+    }
+
     bool oldLHSVisitingMode = LHSVisitingMode;
     LHSVisitingMode = true;
 
     llvm::Value* ptr = visit(*expr.expressionLHS);
     LHSVisitingMode = false;
 
-    llvm::Value* right = visit(*expr.expressionRHS);
+    llvm::Value* value = generateAssignedValue(expr, [&]() { return generateLoad(expr.type, ptr); });
+    // TODO: Handle volatile
+    builder->CreateStore(value, ptr, false);
 
-    llvm::Value* returnVal = nullptr;
+    LHSVisitingMode = oldLHSVisitingMode;
+    return value;
+}
 
-    if (expr.binaryOp.has_value()) {
-        llvm::Value* left = generateLoad(expr.type, ptr);
-        llvm::Value* value = generateBinaryOperation(left, right, *expr.binaryOp, expr.type);
-        // TODO: Handle volatile
-        builder->CreateStore(value, ptr, false);
-        returnVal = value;
-    } else {
-        // TODO: Handle volatile
-        builder->CreateStore(right, ptr, false);
-        returnVal = right;
+llvm::Value* CodegenVisitor::generateAssignedValue(
+    AST::AssignmentExpression& expr, llvm::function_ref<llvm::Value*()> readVariable)
+{
+    if (!expr.binaryOp.has_value()) {
+        return visit(*expr.expressionRHS);
     }
 
-    LHSVisitingMode = oldLHSVisitingMode;
-    return returnVal;
+    if (auto* multiplication = getContractableMultiplication(*expr.expressionRHS, *expr.binaryOp)) {
+        // x += a * b is a * b + x, and x -= a * b is -a * b + x
+        llvm::Value* a = visit(*multiplication->left);
+        llvm::Value* b = visit(*multiplication->right);
+        if (expr.binaryOp->kind == Typing::BinaryOperation::Subtraction) {
+            a = builder->CreateFNeg(a, "fneg");
+        }
+        return generateMultiplyAdd(a, b, readVariable());
+    }
+
+    llvm::Value* right = visit(*expr.expressionRHS);
+    return generateBinaryOperation(readVariable(), right, *expr.binaryOp, expr.type);
 }
 
-llvm::Value* CodegenVisitor::doVisitBinaryOperationExpression(AST::BinaryOperationExpression& expr)
+llvm::Value* CodegenVisitor::visitBinaryOperationExpression(AST::BinaryOperationExpression& expr)
 {
     ASSERT(expr.left->type == expr.right->type);
     Type* type = expr.left->type;
 
+    if (auto* multiplication = getContractableMultiplication(*expr.left, expr.op)) {
+        // a * b + c, or a * b - c, which is a * b + (-c)
+        llvm::Value* a = visit(*multiplication->left);
+        llvm::Value* b = visit(*multiplication->right);
+        llvm::Value* c = visit(*expr.right);
+        if (expr.op.kind == Typing::BinaryOperation::Subtraction) {
+            c = builder->CreateFNeg(c, "fneg");
+        }
+        return generateMultiplyAdd(a, b, c);
+    }
+
+    if (auto* multiplication = getContractableMultiplication(*expr.right, expr.op)) {
+        // c + a * b, or c - a * b, which is -a * b + c
+        llvm::Value* c = visit(*expr.left);
+        llvm::Value* a = visit(*multiplication->left);
+        llvm::Value* b = visit(*multiplication->right);
+        if (expr.op.kind == Typing::BinaryOperation::Subtraction) {
+            a = builder->CreateFNeg(a, "fneg");
+        }
+        return generateMultiplyAdd(a, b, c);
+    }
+
     return generateBinaryOperation(visit(*expr.left), visit(*expr.right), expr.op, type);
 }
 
+AST::BinaryOperationExpression* CodegenVisitor::getContractableMultiplication(
+    AST::Expression& expr, Typing::BinaryOperation op)
+{
+    if (fastMath.contract != FPContractMode::On
+        || (op.kind != Typing::BinaryOperation::Sum && op.kind != Typing::BinaryOperation::Subtraction)) {
+        return nullptr;
+    }
+
+    auto* multiplication = llvm::dyn_cast<AST::BinaryOperationExpression>(&expr);
+    if (multiplication == nullptr || multiplication->op.kind != Typing::BinaryOperation::Mult
+        || !llvm::isa<PrimitiveFloatType>(multiplication->left->type) || multiplication->constantValue.has_value()) {
+        return nullptr;
+    }
+    return multiplication;
+}
+
+llvm::Value* CodegenVisitor::generateMultiplyAdd(llvm::Value* a, llvm::Value* b, llvm::Value* c)
+{
+    return builder->CreateIntrinsic(llvm::Intrinsic::fmuladd, { a->getType() }, { a, b, c }, nullptr, "fmuladd");
+}
+
 llvm::Value* CodegenVisitor::generateBinaryOperation(
     llvm::Value* left, llvm::Value* right, Typing::BinaryOperation op, Type* type)
 {
     switch (op.kind) {
     case Typing::BinaryOperation::Mult: {
         if (auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type)) {
-            // TODO: Check the semantics of signed overflow (NSW) and unsigned overflow (NUW)
-            return builder->CreateMul(left, right, "mul");
+            return generateIntegerArithmetic(llvm::Instruction::Mul, left, right, intType, "mul");
         } else if (auto* floatType = llvm::dyn_cast<PrimitiveFloatType>(type)) {
             return builder->CreateFMul(left, right, "fmul");
         } else {
@@ -285,8 +578,8 @@ llvm::Value* CodegenVisitor::generateBinaryOperation(
     case Typing::BinaryOperation::Div: {
         // TODO: Check the semantics of division
         if (auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type)) {
-            // TODO: Check the semantics of signed overflow (NSW) and unsigned overflow (NUW)
             if (intType->isSigned()) {
+                generateSignedDivisionCheck(left, right);
                 return builder->CreateSDiv(left, right, "sdiv");
             } else {
                 return builder->CreateUDiv(left, right, "udiv");
@@ -301,8 +594,8 @@ llvm::Value* CodegenVisitor::generateBinaryOperation(
     case Typing::BinaryOperation::Modulo: {
         // TODO: Check the semantics of modulo
         if (auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type)) {
-            // TODO: Check the semantics of signed overflow (NSW) and unsigned overflow (NUW)
             if (intType->isSigned()) {
+                generateSignedDivisionCheck(left, right);
                 return builder->CreateSRem(left, right, "srem");
             } else {
                 return builder->CreateURem(left, right, "urem");
@@ -317,8 +610,7 @@ llvm::Value* CodegenVisitor::generateBinaryOperation(
     }
     case Typing::BinaryOperation::Sum: {
         if (auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type)) {
-            // TODO: Check the semantics of signed overflow (NSW) and unsigned overflow (NUW)
-            return builder->CreateAdd(left, right, "add");
+            return generateIntegerArithmetic(llvm::Instruction::Add, left, right, intType, "add");
         } else if (auto* floatType = llvm::dyn_cast<PrimitiveFloatType>(type)) {
             return builder->CreateFAdd(left, right, "fadd");
         } else {
@@ -328,8 +620,7 @@ llvm::Value* CodegenVisitor::generateBinaryOperation(
     }
     case Typing::BinaryOperation::Subtraction: {
         if (auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type)) {
-            // TODO: Check the semantics of signed overflow (NSW) and unsigned overflow (NUW)
-            return builder->CreateSub(left, right, "sub");
+            return generateIntegerArithmetic(llvm::Instruction::Sub, left, right, intType, "sub");
         } else if (auto* floatType = llvm::dyn_cast<PrimitiveFloatType>(type)) {
             return builder->CreateFSub(left, right, "fsub");
         } else {
@@ -423,13 +714,13 @@ llvm::Value* CodegenVisitor::generateBinaryOperation(
     case Typing::BinaryOperation::LessThan: {
         if (auto* intType = llvm::dyn_cast<PrimitiveIntegerType>(type)) {
             if (intType->isSigned()) {
-                return generateRelationalCmp(llvm::CmpInst::ICMP_SGT, left, right);
+                return generateRelationalCmp(llvm::CmpInst::ICMP_SLT, left, right);
             } else {
-                return generateRelationalCmp(llvm::CmpInst::ICMP_UGT, left, right);
+                return generateRelationalCmp(llvm::CmpInst::ICMP_ULT, left, right);
             }
         } else if (auto* floatType = llvm::dyn_cast<PrimitiveFloatType>(type)) {
             // TODO: Review semantics of float comparison (oeq vs ueq)
-            return generateRelationalCmp(llvm::CmpInst::FCMP_OGT, left, right);
+            return generateRelationalCmp(llvm::CmpInst::FCMP_OLT, left, right);
         } else {
             NOT_IMPLEMENTED();
         }
@@ -448,6 +739,83 @@ llvm::Value* CodegenVisitor::generateBinaryOperation(
     }
 }
 
+llvm::Value* CodegenVisitor::generateIntegerArithmetic(llvm::Instruction::BinaryOps opcode, llvm::Value* left,
+    llvm::Value* right, PrimitiveIntegerType* type, llvm::Twine const& name)
+{
+    bool isSigned = type->isSigned();
+    switch (overflowMode) {
+    case AST::OverflowMode::Wrap:
+        return builder->CreateBinOp(opcode, left, right, name);
+    case AST::OverflowMode::Undefined: {
+        // Lets LLVM assume that the operation doesn't overflow, for example to widen induction variables
+        auto* value = builder->CreateBinOp(opcode, left, right, name);
+        if (auto* instruction = llvm::dyn_cast<llvm::BinaryOperator>(value)) {
+            instruction->setHasNoSignedWrap(isSigned);
+            instruction->setHasNoUnsignedWrap(!isSigned);
+        }
+        return value;
+    }
+    case AST::OverflowMode::Trap:
+        break;
+    }
+
+    llvm::Intrinsic::ID intrinsic;
+    switch (opcode) {
+    case llvm::Instruction::Add:
+        intrinsic = isSigned ? llvm::Intrinsic::sadd_with_overflow : llvm::Intrinsic::uadd_with_overflow;
+        break;
+    case llvm::Instruction::Sub:
+        intrinsic = isSigned ? llvm::Intrinsic::ssub_with_overflow : llvm::Intrinsic::usub_with_overflow;
+        break;
+    case llvm::Instruction::Mul:
+        intrinsic = isSigned ? llvm::Intrinsic::smul_with_overflow : llvm::Intrinsic::umul_with_overflow;
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+
+    auto* result = builder->CreateBinaryIntrinsic(intrinsic, left, right);
+    auto* value = builder->CreateExtractValue(result, 0, name);
+    generateOverflowTrap(builder->CreateExtractValue(result, 1, "overflow"));
+    return value;
+}
+
+void CodegenVisitor::generateSignedDivisionCheck(llvm::Value* left, llvm::Value* right)
+{
+    if (overflowMode != AST::OverflowMode::Trap) {
+        return;
+    }
+
+    // The only signed division that overflows is the minimum value divided by -1. The remainder is computed by the same
+    // instruction on most targets, so it's undefined too, even if its result (0) fits
+    auto* type = llvm::cast<llvm::IntegerType>(left->getType());
+    auto* isMinimum = builder->CreateICmpEQ(
+        left, llvm::ConstantInt::get(type, llvm::APInt::getSignedMinValue(type->getBitWidth())), "is.min");
+    auto* isMinusOne = builder->CreateICmpEQ(right, llvm::ConstantInt::getSigned(type, -1), "is.minus.one");
+    generateOverflowTrap(builder->CreateAnd(isMinimum, isMinusOne, "overflow"));
+}
+
+void CodegenVisitor::generateOverflowTrap(llvm::Value* overflow)
+{
+    // Note: No branch weights are needed, blocks that end in unreachable are already assumed to be cold
+    auto* continueBlock = llvm::BasicBlock::Create(*context, "no.overflow", currentFunction);
+    builder->CreateCondBr(overflow, getOverflowTrapBlock(), continueBlock);
+    sealBlock(continueBlock);
+    builder->SetInsertPoint(continueBlock);
+}
+
+llvm::BasicBlock* CodegenVisitor::getOverflowTrapBlock()
+{
+    if (overflowTrapBlock == nullptr) {
+        // All the checks of a function share the block, so that they take as little code as possible
+        overflowTrapBlock = llvm::BasicBlock::Create(*context, "overflow.trap", currentFunction);
+        llvm::IRBuilder<> trapBuilder(overflowTrapBlock);
+        trapBuilder.CreateIntrinsic(llvm::Intrinsic::trap, {}, {});
+        trapBuilder.CreateUnreachable();
+    }
+    return overflowTrapBlock;
+}
+
 llvm::Value* CodegenVisitor::generateRelationalCmp(llvm::CmpInst::Predicate pred, llvm::Value* left, llvm::Value* right)
 {
     llvm::Value* value = builder->CreateCmp(pred, left, right);
@@ -462,7 +830,7 @@ llvm::Value* CodegenVisitor::generateRelationalCmp(llvm::CmpInst::Predicate pred
     return value;
 }
 
-llvm::Value* CodegenVisitor::doVisitBoolLiteral(AST::BoolLiteralExpression& lit)
+llvm::Value* CodegenVisitor::visitBoolLiteralExpression(AST::BoolLiteralExpression& lit)
 {
     bool literalValue = lit.getLiteralBool();
 
@@ -482,13 +850,28 @@ llvm::Value* CodegenVisitor::doVisitBoolLiteral(AST::BoolLiteralExpression& lit)
     }
 }
 
-llvm::Value* CodegenVisitor::doVisitCastExpression(AST::CastExpression& expr)
+llvm::Value* CodegenVisitor::visitCastExpression(AST::CastExpression& expr)
 {
-    // TODO: Do not forget to handle operator && and || when casting to bool
-    TODO();
+    // Note: Only numeric types can be cast, so the result is never a bool that has to branch
+    llvm::Value* value = visit(*expr.expr);
+    llvm::Type* destinationType = llvmTypes.get(expr.type);
+
+    auto* fromInt = llvm::dyn_cast<PrimitiveIntegerType>(expr.expr->type);
+    auto* toInt = llvm::dyn_cast<PrimitiveIntegerType>(expr.type);
+    if (fromInt != nullptr && toInt != nullptr) {
+        return builder->CreateIntCast(value, destinationType, fromInt->isSigned(), "cast");
+    } else if (fromInt != nullptr) {
+        return fromInt->isSigned() ? builder->CreateSIToFP(value, destinationType, "cast")
+                                   : builder->CreateUIToFP(value, destinationType, "cast");
+    } else if (toInt != nullptr) {
+        return toInt->isSigned() ? builder->CreateFPToSI(value, destinationType, "cast")
+                                 : builder->CreateFPToUI(value, destinationType, "cast");
+    } else {
+        return builder->CreateFPCast(value, destinationType, "cast");
+    }
 }
 
-llvm::Value* CodegenVisitor::doVisitCommaExpression(AST::CommaExpression& expr)
+llvm::Value* CodegenVisitor::visitCommaExpression(AST::CommaExpression& expr)
 {
     // TODO: Check how we handle operator && and || short-circuit within comma expressions
     llvm::Value* value = nullptr;
@@ -498,15 +881,15 @@ llvm::Value* CodegenVisitor::doVisitCommaExpression(AST::CommaExpression& expr)
     return value;
 }
 
-llvm::Value* CodegenVisitor::doVisitFloatLiteralExpression(AST::FloatLiteralExpression& expr)
+llvm::Value* CodegenVisitor::visitFloatLiteralExpression(AST::FloatLiteralExpression& expr)
 {
     PrimitiveFloatType* type = llvm::dyn_cast<PrimitiveFloatType>(expr.type);
     ASSERT(type != nullptr);
 
-    return llvm::ConstantFP::get(type->getLLVMType(), expr.getLLVMAPFloat());
+    return llvm::ConstantFP::get(llvmTypes.get(type), expr.getLLVMAPFloat());
 }
 
-llvm::Value* CodegenVisitor::doVisitFunctionCallExpression(AST::FunctionCallExpression& expr)
+llvm::Value* CodegenVisitor::visitFunctionCallExpression(AST::FunctionCallExpression& expr)
 {
     // TODO: Check if this works well with both function definitions, declarations and function pointers
     llvm::Value* callee = visit(*expr.identifier);
@@ -518,38 +901,105 @@ llvm::Value* CodegenVisitor::doVisitFunctionCallExpression(AST::FunctionCallExpr
         args.push_back(visit(*arg));
     }
 
-    llvm::FunctionType* functionType = llvm::dyn_cast<llvm::FunctionType>(expr.identifier->type->getLLVMType());
+    llvm::FunctionType* functionType = llvm::dyn_cast<llvm::FunctionType>(llvmTypes.get(expr.identifier->type));
     ASSERT(functionType != nullptr);
     ASSERT(callee != nullptr);
 
     // TODO: Handle short circuit boolean code
     ASSERT(!shouldGenerateShortCircuitBooleanCode);
 
-    return builder->CreateCall(functionType, callee, args);
+    auto* call = builder->CreateCall(functionType, callee, args);
+    if (auto* function = llvm::dyn_cast<llvm::Function>(callee)) {
+        // The calling convention of the call must match the one of the function, which may be fastcc
+        call->setCallingConv(function->getCallingConv());
+    }
+    return call;
 }
 
-llvm::Value* CodegenVisitor::generateLoad(Type* type, llvm::Value* ptr, std::string const& name)
+llvm::Value* CodegenVisitor::generateLoad(Type* type, llvm::Value* ptr, llvm::Twine const& name)
 {
-    llvm::Type* llvmType = type->getLLVMType();
     // Note: If we are trying to load a function pointer, we have to take a pointer
-    if (auto* functionType = llvm::dyn_cast<FunctionType>(type)) {
-        llvmType = llvmType->getPointerTo();
-    }
+    llvm::Type* llvmType = getLLVMValueType(type);
 
     llvm::Value* loadedValue = builder->CreateLoad(llvmType, ptr, name);
 
     // If we are loading a boolean, we have to check for short circuit
+    generateShortCircuitBranchIfNeeded(type, loadedValue);
+
+    return loadedValue;
+}
+
+llvm::Value* CodegenVisitor::generateConstant(AST::Expression& expr)
+{
+    ASSERT(expr.constantValue.has_value());
+
+    llvm::Value* value;
+    if (auto const* intValue = std::get_if<llvm::APInt>(&*expr.constantValue)) {
+        value = llvm::ConstantInt::get(*context, *intValue);
+    } else {
+        value = llvm::ConstantFP::get(*context, std::get<llvm::APFloat>(*expr.constantValue));
+    }
+
+    generateShortCircuitBranchIfNeeded(expr.type, value);
+    return value;
+}
+
+void CodegenVisitor::generateShortCircuitBranchIfNeeded(Type* type, llvm::Value* value)
+{
     if (type == BoolType::get() && shouldGenerateShortCircuitBooleanCode) {
         // Generate short-circuit branches
         ASSERT(trueLabel != nullptr);
         ASSERT(falseLabel != nullptr);
-        builder->CreateCondBr(loadedValue, trueLabel, falseLabel);
+        builder->CreateCondBr(value, trueLabel, falseLabel);
     }
+}
 
-    return loadedValue;
+llvm::Type* CodegenVisitor::getLLVMValueType(Type* type)
+{
+    llvm::Type* llvmType = llvmTypes.get(type);
+    // Note: Variables of function type hold a pointer to the function
+    if (llvm::isa<FunctionType>(type)) {
+        llvmType = llvmType->getPointerTo();
+    }
+    return llvmType;
+}
+
+SSABuilder::Variable CodegenVisitor::getSSAVariable(Binding::SymbolDeclaration const& decl)
+{
+    switch (decl.getKind()) {
+    case Binding::SymbolDeclarationKind::LocalVariableDeclaration:
+        return decl.getVarDecl();
+    case Binding::SymbolDeclarationKind::FunctionParamDeclaration:
+        return decl.getParam();
+    default:
+        return nullptr;
+    }
 }
 
-llvm::Value* CodegenVisitor::doVisitIdentifierExpression(AST::IdentifierExpression& expr)
+bool CodegenVisitor::isSSAVariable(SSABuilder::Variable variable) const
+{
+    ASSERT(variable != nullptr);
+    // A variable only needs memory if its address can escape. Ceres has no address-of operator yet and nested
+    //  functions cannot capture locals, so in direct SSA mode every local variable and parameter is promoted.
+    //  TODO: Exclude address-taken and captured variables here once the language supports them
+    return options.directSSA;
+}
+
+llvm::Value* CodegenVisitor::readSSAVariable(SSABuilder::Variable variable, Type* type)
+{
+    llvm::Value* value = ssaBuilder.readVariable(variable, getLLVMValueType(type), builder->GetInsertBlock());
+    generateShortCircuitBranchIfNeeded(type, value);
+    return value;
+}
+
+void CodegenVisitor::writeSSAVariable(SSABuilder::Variable variable, llvm::Value* value)
+{
+    ssaBuilder.writeVariable(variable, builder->GetInsertBlock(), value);
+}
+
+void CodegenVisitor::sealBlock(llvm::BasicBlock* block) { ssaBuilder.sealBlock(block); }
+
+llvm::Value* CodegenVisitor::visitIdentifierExpression(AST::IdentifierExpression& expr)
 {
     ASSERT(expr.decl.has_value());
 
@@ -568,10 +1018,21 @@ llvm::Value* CodegenVisitor::doVisitIdentifierExpression(AST::IdentifierExpressi
     }
     case Binding::SymbolDeclarationKind::LocalVariableDeclaration: {
         auto* varDec = expr.decl->getVarDecl();
+        if (varDec->isCompileTimeConstant()) {
+            ASSERT(!LHSVisitingMode);
+            return generateConstant(*varDec->initializerExpression);
+        }
+
+        if (isSSAVariable(varDec)) {
+            // Assignments to SSA variables are handled in visitAssignmentExpression
+            ASSERT(!LHSVisitingMode);
+            return readSSAVariable(varDec, varDec->type);
+        }
+
         if (LHSVisitingMode) {
             return varDec->allocaInst;
         } else {
-            return generateLoad(varDec->type, varDec->allocaInst, varDec->id);
+            return generateLoad(varDec->type, varDec->allocaInst, varDec->id.getText());
         }
     }
     case Binding::SymbolDeclarationKind::GlobalVariableDeclaration:
@@ -579,10 +1040,15 @@ llvm::Value* CodegenVisitor::doVisitIdentifierExpression(AST::IdentifierExpressi
         TODO();
     case Binding::SymbolDeclarationKind::FunctionParamDeclaration: {
         auto* funParam = expr.decl->getParam();
+        if (isSSAVariable(funParam)) {
+            ASSERT(!LHSVisitingMode);
+            return readSSAVariable(funParam, funParam->type);
+        }
+
         if (LHSVisitingMode) {
             return funParam->llvmAlloca;
         } else {
-            return generateLoad(funParam->type, funParam->llvmAlloca, funParam->id);
+            return generateLoad(funParam->type, funParam->llvmAlloca, funParam->id.getText());
         }
     }
     case Binding::SymbolDeclarationKind::Invalid:
@@ -591,26 +1057,77 @@ llvm::Value* CodegenVisitor::doVisitIdentifierExpression(AST::IdentifierExpressi
     }
 }
 
-llvm::Value* CodegenVisitor::doVisitIntLiteralExpression(AST::IntLiteralExpression& expr)
+llvm::Value* CodegenVisitor::visitIntLiteralExpression(AST::IntLiteralExpression& expr)
 {
     PrimitiveIntegerType* type = llvm::dyn_cast<PrimitiveIntegerType>(expr.type);
     ASSERT(type != nullptr);
 
-    // TODO: We should check in a previous pass that the literal indeed fits in the integer type
-    return llvm::ConstantInt::get(type->getLLVMType(), expr.getLLVMAPInt());
+    // Note: Literals are folded by the constant evaluation pass, this is only reached if it's disabled
+    return llvm::ConstantInt::get(llvmTypes.get(type), expr.getLLVMAPInt());
 }
 
-llvm::Value* CodegenVisitor::doVisitPostfixExpression(AST::PostfixExpression& expr) { TODO(); }
+llvm::Value* CodegenVisitor::visitPostfixExpression(AST::PostfixExpression& expr) { TODO(); }
 
-llvm::Value* CodegenVisitor::doVisitPrefixExpression(AST::PrefixExpression& expr) { TODO(); }
+llvm::Value* CodegenVisitor::visitPrefixExpression(AST::PrefixExpression& expr)
+{
+    // TODO: Prefix increment and decrement, which need the address of the variable
+    if (expr.op == AST::PrefixOp::PrefixIncrement || expr.op == AST::PrefixOp::PrefixDecrement) {
+        TODO();
+    }
 
-llvm::Value* CodegenVisitor::doVisitVariableDeclaration(AST::VariableDeclaration& decl)
+    if (expr.op == AST::PrefixOp::UnaryLogicalNot && shouldGenerateShortCircuitBooleanCode) {
+        // The operand generates the branch, so it only has to jump to the opposite labels
+        std::swap(trueLabel, falseLabel);
+        llvm::Value* value = visit(*expr.expr);
+        std::swap(trueLabel, falseLabel);
+        return value;
+    }
+
+    llvm::Value* value = visit(*expr.expr);
+
+    switch (expr.op) {
+    case AST::PrefixOp::UnaryPlus:
+        return value;
+    case AST::PrefixOp::UnaryMinus: {
+        if (llvm::isa<PrimitiveFloatType>(expr.type)) {
+            return builder->CreateFNeg(value, "fneg");
+        }
+        // Same as subtracting from zero. Negating an unsigned integer always wraps, so only signed ones can overflow
+        auto* intType = llvm::cast<PrimitiveIntegerType>(expr.type);
+        if (!intType->isSigned()) {
+            return builder->CreateNeg(value, "neg");
+        }
+        auto* zero = llvm::ConstantInt::get(value->getType(), 0);
+        return generateIntegerArithmetic(llvm::Instruction::Sub, zero, value, intType, "neg");
+    }
+    case AST::PrefixOp::UnaryLogicalNot:
+    case AST::PrefixOp::UnaryBitwiseNot:
+        return builder->CreateNot(value, "not");
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
+
+llvm::Value* CodegenVisitor::visitVariableDeclaration(AST::VariableDeclaration& decl)
 {
     // TODO: Handle global vs local variable declaration
     switch (decl.scope) {
     case AST::VariableScope::Local: {
+        if (decl.isCompileTimeConstant()) {
+            // The variable needs no storage, its uses are replaced by its value
+            return nullptr;
+        }
+
+        if (isSSAVariable(&decl)) {
+            // Variables without initializer are left undefined until their first assignment
+            if (decl.initializerExpression != nullptr) {
+                writeSSAVariable(&decl, visit(*decl.initializerExpression));
+            }
+            return nullptr;
+        }
+
         // Create an alloca instantiation at the beginning of the function block
-        decl.allocaInst = allocateLocalVariable(decl.type, decl.id);
+        decl.allocaInst = allocateLocalVariable(decl.type, decl.id.getText());
 
         if (decl.initializerExpression != nullptr) {
             llvm::Value* initializationValue = visit(*decl.initializerExpression);
@@ -627,15 +1144,10 @@ llvm::Value* CodegenVisitor::doVisitVariableDeclaration(AST::VariableDeclaration
 }
 
 llvm::AllocaInst* CodegenVisitor::allocateLocalVariable(
-    Type* type, std::string const& name, llvm::IRBuilder<>* builderToUse)
+    Type* type, llvm::Twine const& name, llvm::IRBuilder<>* builderToUse)
 {
-    llvm::Type* llvmType = type->getLLVMType();
-
-    if (auto* functionType = llvm::dyn_cast<FunctionType>(type)) {
-        // TODO: Check that this is the correct way of handling allocas of function pointers
-        // If we are a function type, we need to create a pointer to function
-        llvmType = llvmType->getPointerTo();
-    }
+    // TODO: Check that this is the correct way of handling allocas of function pointers
+    llvm::Type* llvmType = getLLVMValueType(type);
 
     auto createAlloca = [&](llvm::IRBuilder<>* bld) { return bld->CreateAlloca(llvmType, nullptr, name); };
 
@@ -1,35 +1,111 @@
 #ifndef COMPILER_CODEGENVISITOR_H
 #define COMPILER_CODEGENVISITOR_H
 
-#include "../AST/AbstractReturningASTVisitor.hpp"
+#include "../AST/StaticASTVisitor.hpp"
+#include "../Typing/TypeContext.h"
+#include "CodegenOptions.h"
+#include "SSABuilder.h"
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Value.h>
 
 namespace Ceres::Codegen {
 
-class CodegenVisitor : public AST::AbstractReturningASTVisitor<llvm::Value*> {
+class CodegenVisitor : public AST::StaticASTVisitor<CodegenVisitor, llvm::Value*> {
 
     llvm::LLVMContext* context;
+    LLVMTypeCache llvmTypes;
     std::unique_ptr<llvm::IRBuilder<>> builder;
     std::unique_ptr<llvm::Module> module;
     llvm::Function* currentFunction = nullptr;
 
+    /* Overflow mode of the current function, and the block its overflow checks jump to, created when first needed */
+    AST::OverflowMode overflowMode;
+    llvm::BasicBlock* overflowTrapBlock = nullptr;
+
+    /* Floating point semantics of the current function. The builder applies them to every operation it creates */
+    FastMathOptions fastMath;
+    void setFastMath(FastMathOptions const& newFastMath);
+
+    CodegenOptions options;
+    SSABuilder ssaBuilder;
+
     llvm::AllocaInst* allocateLocalVariable(
-        Type* type, std::string const& name, llvm::IRBuilder<>* builderToUse = nullptr);
+        Type* type, llvm::Twine const& name, llvm::IRBuilder<>* builderToUse = nullptr);
 
     void generateStore(llvm::AllocaInst* allocaInst, llvm::Value* value);
 
     void generateFunctionDefinitionPrototype(AST::FunctionDefinition& def);
+
+    // Records the target CPU and features in the function, so that IR passes can query them
+    void addTargetAttributes(llvm::Function* function) const;
     void generateFunctionDeclarationPrototype(AST::FunctionDeclaration& dec);
     void generateGlobalVariablePrototype(AST::VariableDeclaration& dec);
 
     /* Also handles if short-circuit */
     llvm::Value* generateRelationalCmp(llvm::CmpInst::Predicate pred, llvm::Value* left, llvm::Value* right);
 
-    llvm::Value* generateLoad(Type* type, llvm::Value* ptr, std::string const& name = "");
+    llvm::Value* generateLoad(Type* type, llvm::Value* ptr, llvm::Twine const& name = "");
+
+    /* Type of the LLVM values holding a variable of the given type. Functions are held by pointer */
+    llvm::Type* getLLVMValueType(Type* type);
+
+    /* Returns the SSA variable handle for local variables and parameters, nullptr for any other declaration */
+    static SSABuilder::Variable getSSAVariable(Binding::SymbolDeclaration const& decl);
+
+    /* True if the variable is represented with SSA values instead of an alloca */
+    bool isSSAVariable(SSABuilder::Variable variable) const;
+
+    llvm::Value* readSSAVariable(SSABuilder::Variable variable, Type* type);
+    void writeSSAVariable(SSABuilder::Variable variable, llvm::Value* value);
+
+    /* Value of an expression folded by the constant evaluation pass */
+    llvm::Value* generateConstant(AST::Expression& expr);
+
+    /* If we are generating short circuit code and value is a boolean, branch to the true or false labels */
+    void generateShortCircuitBranchIfNeeded(Type* type, llvm::Value* value);
+
+    /* Seals a basic block for SSA construction. All the predecessors of block must have already been generated */
+    void sealBlock(llvm::BasicBlock* block);
 
     llvm::Value* generateBinaryOperation(llvm::Value* left, llvm::Value* right, Typing::BinaryOperation op, Type* type);
 
+    /* Value stored by an assignment. For compound assignments, readVariable is called to get the current value of the
+     * variable once the right side has been generated */
+    llvm::Value* generateAssignedValue(
+        AST::AssignmentExpression& expr, llvm::function_ref<llvm::Value*()> readVariable);
+
+    /* With -ffp-contract=on, the float multiplications that are added or subtracted in the same expression are fused
+     * with the addition. Returns the multiplication if it's one of them, null otherwise */
+    AST::BinaryOperationExpression* getContractableMultiplication(AST::Expression& expr, Typing::BinaryOperation op);
+
+    /* Generates `a * b + c` as llvm.fmuladd, which is a single instruction if the target has fused multiply-add */
+    llvm::Value* generateMultiplyAdd(llvm::Value* a, llvm::Value* b, llvm::Value* c);
+
+    /* Integer addition, subtraction or multiplication, which behaves on overflow as overflowMode says */
+    llvm::Value* generateIntegerArithmetic(llvm::Instruction::BinaryOps opcode, llvm::Value* left, llvm::Value* right,
+        PrimitiveIntegerType* type, llvm::Twine const& name);
+
+    /* With -foverflow=trap, aborts the program before a signed division or remainder of the minimum value by -1 */
+    void generateSignedDivisionCheck(llvm::Value* left, llvm::Value* right);
+
+    /* Jumps to the trap block if overflow is true, continuing in a new block otherwise */
+    void generateOverflowTrap(llvm::Value* overflow);
+
+    /* Block that aborts the program, where the overflow checks of the current function jump to */
+    llvm::BasicBlock* getOverflowTrapBlock();
+
+    /* Generates a loop in rotated form, the canonical form of the LLVM loop passes: the condition is checked once
+     * before entering the loop, and then at the end of every iteration. A null condition is always true */
+    void generateLoop(AST::Expression* condition, AST::BlockStatement& body, AST::Expression* update,
+        AST::LoopHints const& hints);
+
+    /* Branches to trueBlock or falseBlock depending on condition. A null condition always goes to trueBlock */
+    void generateConditionalBranch(
+        AST::Expression* condition, llvm::BasicBlock* trueBlock, llvm::BasicBlock* falseBlock);
+
+    /* Loop ID with the hints, to be attached to the back edges of the loop as llvm.loop metadata */
+    llvm::MDNode* createLoopMetadata(AST::LoopHints const& hints);
+
     /* True when we are looking for an LHS expression, that is, we need the pointer of a variable instead of the
      * variable itself*/
     bool LHSVisitingMode = false;
@@ -47,30 +123,33 @@ class CodegenVisitor : public AST::AbstractReturningASTVisitor<llvm::Value*> {
     llvm::BasicBlock* falseLabel = nullptr;
 
 public:
-    CodegenVisitor(llvm::LLVMContext* context);
+    CodegenVisitor(llvm::LLVMContext* context, CodegenOptions const& options);
 
 public:
-    llvm::Value* doVisitAssignmentExpression(AST::AssignmentExpression& expr) override;
-    llvm::Value* doVisitBinaryOperationExpression(AST::BinaryOperationExpression& expr) override;
-    llvm::Value* doVisitBlockStatement(AST::BlockStatement& stm) override;
-    llvm::Value* doVisitBoolLiteral(AST::BoolLiteralExpression& lit) override;
-    llvm::Value* doVisitCastExpression(AST::CastExpression& expr) override;
-    llvm::Value* doVisitCommaExpression(AST::CommaExpression& expr) override;
-    llvm::Value* doVisitCompilationUnit(AST::CompilationUnit& unit) override;
-    llvm::Value* doVisitExpressionStatement(AST::ExpressionStatement& stm) override;
-    llvm::Value* doVisitFloatLiteralExpression(AST::FloatLiteralExpression& expr) override;
-    llvm::Value* doVisitForStatement(AST::ForStatement& stm) override;
-    llvm::Value* doVisitFunctionCallExpression(AST::FunctionCallExpression& expr) override;
-    llvm::Value* doVisitFunctionDefinition(AST::FunctionDefinition& def) override;
-    llvm::Value* doVisitIdentifierExpression(AST::IdentifierExpression& expr) override;
-    llvm::Value* doVisitIfStatement(AST::IfStatement& stm) override;
-    llvm::Value* doVisitIntLiteralExpression(AST::IntLiteralExpression& expr) override;
-    llvm::Value* doVisitPostfixExpression(AST::PostfixExpression& expr) override;
-    llvm::Value* doVisitPrefixExpression(AST::PrefixExpression& expr) override;
-    llvm::Value* doVisitReturnStatement(AST::ReturnStatement& stm) override;
-    llvm::Value* doVisitVariableDeclaration(AST::VariableDeclaration& decl) override;
-    llvm::Value* doVisitWhileStatement(AST::WhileStatement& stm) override;
-    llvm::Value* doVisitFunctionDeclaration(AST::FunctionDeclaration& def) override;
+    /* Expressions folded by the constant evaluation pass are emitted as constants, without visiting their operands */
+    llvm::Value* visit(AST::Node& node);
+
+    llvm::Value* visitAssignmentExpression(AST::AssignmentExpression& expr);
+    llvm::Value* visitBinaryOperationExpression(AST::BinaryOperationExpression& expr);
+    llvm::Value* visitBlockStatement(AST::BlockStatement& stm);
+    llvm::Value* visitBoolLiteralExpression(AST::BoolLiteralExpression& lit);
+    llvm::Value* visitCastExpression(AST::CastExpression& expr);
+    llvm::Value* visitCommaExpression(AST::CommaExpression& expr);
+    llvm::Value* visitCompilationUnit(AST::CompilationUnit& unit);
+    llvm::Value* visitExpressionStatement(AST::ExpressionStatement& stm);
+    llvm::Value* visitFloatLiteralExpression(AST::FloatLiteralExpression& expr);
+    llvm::Value* visitForStatement(AST::ForStatement& stm);
+    llvm::Value* visitFunctionCallExpression(AST::FunctionCallExpression& expr);
+    llvm::Value* visitFunctionDefinition(AST::FunctionDefinition& def);
+    llvm::Value* visitIdentifierExpression(AST::IdentifierExpression& expr);
+    llvm::Value* visitIfStatement(AST::IfStatement& stm);
+    llvm::Value* visitIntLiteralExpression(AST::IntLiteralExpression& expr);
+    llvm::Value* visitPostfixExpression(AST::PostfixExpression& expr);
+    llvm::Value* visitPrefixExpression(AST::PrefixExpression& expr);
+    llvm::Value* visitReturnStatement(AST::ReturnStatement& stm);
+    llvm::Value* visitVariableDeclaration(AST::VariableDeclaration& decl);
+    llvm::Value* visitWhileStatement(AST::WhileStatement& stm);
+    llvm::Value* visitFunctionDeclaration(AST::FunctionDeclaration& def);
 
     friend class CodeGenerator;
 };
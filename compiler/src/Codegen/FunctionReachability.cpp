@@ -0,0 +1,63 @@
+#include "FunctionReachability.h"
+#include <llvm/Support/Casting.h>
+
+namespace Ceres::Codegen {
+
+void FunctionReachabilityVisitor::markReachable(AST::FunctionDefinition& def)
+{
+    if (!def.isReachable) {
+        def.isReachable = true;
+        worklist.push_back(&def);
+    }
+}
+
+void FunctionReachabilityVisitor::visitFunctionCallExpression(AST::FunctionCallExpression& expr)
+{
+    // A direct call doesn't take the address of the callee
+    auto const& callee = expr.identifier->decl;
+    if (callee.has_value() && callee->getKind() == Binding::SymbolDeclarationKind::FunctionDefinition) {
+        markReachable(*callee->getFunDef());
+    } else {
+        visit(*expr.identifier);
+    }
+
+    for (auto* argument : expr.arguments) {
+        visit(*argument);
+    }
+}
+
+void FunctionReachabilityVisitor::visitIdentifierExpression(AST::IdentifierExpression& expr)
+{
+    if (expr.decl.has_value() && expr.decl->getKind() == Binding::SymbolDeclarationKind::FunctionDefinition) {
+        auto* def = expr.decl->getFunDef();
+        def->isAddressTaken = true;
+        markReachable(*def);
+    }
+}
+
+void FunctionReachabilityVisitor::run(AST::CompilationUnit& unit)
+{
+    for (auto* def : unit.functionDefinitions) {
+        def->isReachable = false;
+        def->isAddressTaken = false;
+    }
+
+    for (auto* def : unit.functionDefinitions) {
+        if (def->isExported()) {
+            markReachable(*def);
+        }
+    }
+
+    // Global variables are always generated, the functions they refer to are too
+    for (auto* decl : unit.globalVariableDeclarations) {
+        visit(*decl);
+    }
+
+    while (!worklist.empty()) {
+        auto* def = worklist.back();
+        worklist.pop_back();
+        visit(*def->block);
+    }
+}
+
+} // namespace Ceres::Codegen
@@ -0,0 +1,28 @@
+#ifndef COMPILER_FUNCTIONREACHABILITY_H
+#define COMPILER_FUNCTIONREACHABILITY_H
+
+#include "../AST/StaticASTVisitor.hpp"
+#include <vector>
+
+namespace Ceres::Codegen {
+
+// Finds the functions that can be called, directly or through a pointer, starting from the exported functions and the
+// initializers of the global variables. Private functions that can't be reached don't need to be generated. Nested
+// functions are always kept along with the function that contains them
+class FunctionReachabilityVisitor : public AST::StaticASTVisitor<FunctionReachabilityVisitor> {
+    // Functions found reachable whose bodies haven't been visited yet
+    std::vector<AST::FunctionDefinition*> worklist;
+
+    void markReachable(AST::FunctionDefinition& def);
+
+public:
+    void visitFunctionCallExpression(AST::FunctionCallExpression& expr);
+    void visitIdentifierExpression(AST::IdentifierExpression& expr);
+
+    // Sets FunctionDefinition::isReachable and FunctionDefinition::isAddressTaken for the functions of the unit
+    void run(AST::CompilationUnit& unit);
+};
+
+} // namespace Ceres::Codegen
+
+#endif // COMPILER_FUNCTIONREACHABILITY_H
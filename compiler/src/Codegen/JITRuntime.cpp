@@ -0,0 +1,25 @@
+#include "JITRuntime.h"
+#include "../utils/log.hpp"
+#include "TestRuntime.h"
+
+namespace Ceres::Codegen {
+
+void defineJITRuntimeSymbols(llvm::orc::LLJIT& jit)
+{
+    llvm::orc::MangleAndInterner mangle(jit.getExecutionSession(), jit.getDataLayout());
+    llvm::orc::SymbolMap symbols;
+
+    auto addSymbol = [&](llvm::StringRef name, auto* function) {
+        symbols[mangle(name)] = llvm::JITEvaluatedSymbol(
+            llvm::pointerToJITTargetAddress(function), llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+    };
+
+#define TEST_RUNTIME_FUNCTION(name, function, parameterType) addSymbol(#name, &TestRuntime::function);
+#include "TestRuntime.def"
+
+    if (auto error = jit.getMainJITDylib().define(llvm::orc::absoluteSymbols(std::move(symbols)))) {
+        Log::panic("Could not define JIT runtime symbols: {}", llvm::toString(std::move(error)));
+    }
+}
+
+} // namespace Ceres::Codegen
@@ -0,0 +1,13 @@
+#ifndef COMPILER_JITRUNTIME_H
+#define COMPILER_JITRUNTIME_H
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+
+namespace Ceres::Codegen {
+
+// Makes the runtime library functions (assert, printI32, ...) of TestRuntime.h available to programs executed in-process
+void defineJITRuntimeSymbols(llvm::orc::LLJIT& jit);
+
+} // namespace Ceres::Codegen
+
+#endif // COMPILER_JITRUNTIME_H
@@ -0,0 +1,146 @@
+#include "SSABuilder.h"
+#include "../utils/log.hpp"
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Constants.h>
+
+namespace Ceres::Codegen {
+
+void SSABuilder::writeVariable(Variable variable, llvm::BasicBlock* block, llvm::Value* value)
+{
+    ASSERT(value != nullptr);
+    currentDefinitions[block][variable] = value;
+}
+
+llvm::Value* SSABuilder::readVariable(Variable variable, llvm::Type* type, llvm::BasicBlock* block)
+{
+    auto blockIt = currentDefinitions.find(block);
+    if (blockIt != currentDefinitions.end()) {
+        auto it = blockIt->second.find(variable);
+        if (it != blockIt->second.end() && it->second != nullptr) {
+            // Local value numbering
+            return it->second;
+        }
+    }
+
+    // Global value numbering
+    return readVariableRecursive(variable, type, block);
+}
+
+llvm::Value* SSABuilder::readVariableRecursive(Variable variable, llvm::Type* type, llvm::BasicBlock* block)
+{
+    llvm::Value* value = nullptr;
+
+    if (!isSealed(block)) {
+        // Incomplete CFG, the operands will be added when the block gets sealed
+        auto* phi = createPhi(type, block);
+        incompletePhis[block].emplace_back(variable, phi);
+        value = phi;
+    } else if (auto* predecessor = block->getSinglePredecessor()) {
+        // Optimize the common case of one predecessor: no phi needed
+        value = readVariable(variable, type, predecessor);
+    } else if (llvm::pred_empty(block)) {
+        // Reached the entry block (or an unreachable one) without any definition
+        value = llvm::UndefValue::get(type);
+    } else {
+        // Break potential cycles with an operandless phi
+        auto* phi = createPhi(type, block);
+        writeVariable(variable, block, phi);
+        value = addPhiOperands(variable, phi);
+    }
+
+    writeVariable(variable, block, value);
+    return value;
+}
+
+llvm::Value* SSABuilder::addPhiOperands(Variable variable, llvm::PHINode* phi)
+{
+    // Note: a predecessor can appear more than once (conditional branch with both edges to the same block), LLVM
+    //  requires an incoming value per edge, which is exactly what llvm::predecessors() yields
+    for (auto* predecessor : llvm::predecessors(phi->getParent())) {
+        phi->addIncoming(readVariable(variable, phi->getType(), predecessor), predecessor);
+    }
+    return tryRemoveTrivialPhi(phi);
+}
+
+llvm::Value* SSABuilder::tryRemoveTrivialPhi(llvm::PHINode* phi)
+{
+    llvm::Value* same = nullptr;
+
+    for (llvm::Value* operand : phi->incoming_values()) {
+        if (operand == same || operand == phi) {
+            // Unique value or self-reference
+            continue;
+        }
+        if (same != nullptr) {
+            // The phi merges at least two values: not trivial
+            return phi;
+        }
+        same = operand;
+    }
+
+    if (same == nullptr) {
+        // The phi is unreachable or in the entry block
+        same = llvm::UndefValue::get(phi->getType());
+    }
+
+    // Remember all users except the phi itself, they may become trivial once it is removed
+    llvm::SmallVector<llvm::WeakVH, 4> phiUsers;
+    for (auto* user : phi->users()) {
+        if (user != phi && llvm::isa<llvm::PHINode>(user)) {
+            phiUsers.emplace_back(user);
+        }
+    }
+
+    // Reroute all uses of phi to same and remove phi. The definition maps are updated by the value handles
+    phi->replaceAllUsesWith(same);
+    phi->eraseFromParent();
+
+    for (auto& user : phiUsers) {
+        if (auto* userPhi = llvm::dyn_cast_or_null<llvm::PHINode>(user)) {
+            tryRemoveTrivialPhi(userPhi);
+        }
+    }
+
+    return same;
+}
+
+void SSABuilder::sealBlock(llvm::BasicBlock* block)
+{
+    ASSERT(!isSealed(block));
+
+    // Mark as sealed first, so that reads performed while completing the phis don't create new incomplete ones
+    sealedBlocks.insert(block);
+
+    auto it = incompletePhis.find(block);
+    if (it == incompletePhis.end()) {
+        return;
+    }
+
+    auto phis = std::move(it->second);
+    incompletePhis.erase(it);
+
+    for (auto& [variable, phi] : phis) {
+        addPhiOperands(variable, phi);
+    }
+}
+
+bool SSABuilder::isSealed(llvm::BasicBlock* block) const { return sealedBlocks.contains(block); }
+
+void SSABuilder::clear()
+{
+    ASSERT(incompletePhis.empty());
+
+    currentDefinitions.clear();
+    sealedBlocks.clear();
+}
+
+llvm::PHINode* SSABuilder::createPhi(llvm::Type* type, llvm::BasicBlock* block)
+{
+    // Phi nodes must be grouped at the beginning of the block
+    if (block->empty()) {
+        return llvm::PHINode::Create(type, 0, "", block);
+    }
+    return llvm::PHINode::Create(type, 0, "", &block->front());
+}
+
+} // namespace Ceres::Codegen
@@ -0,0 +1,51 @@
+#ifndef COMPILER_SSABUILDER_H
+#define COMPILER_SSABUILDER_H
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/ValueHandle.h>
+#include <string>
+
+namespace Ceres::Codegen {
+
+// Builds SSA form directly while the AST is being lowered, without going through allocas and mem2reg.
+// Implements the algorithm described in "Simple and Efficient Construction of Static Single Assignment Form"
+// (Braun et al., 2013): each block records the last definition of every variable, reads that are not defined
+// locally are resolved recursively through the predecessors, and phi nodes are only completed once a block is
+// sealed (that is, once all of its predecessors are known).
+class SSABuilder {
+public:
+    // Opaque handle identifying a source variable. It is the address of the AST object declaring it
+    // (an AST::VariableDeclaration or an AST::FunctionParameter)
+    using Variable = void const*;
+
+private:
+    // WeakTrackingVH follows replaceAllUsesWith, so definitions stay valid when a trivial phi is removed
+    llvm::DenseMap<llvm::BasicBlock*, llvm::DenseMap<Variable, llvm::WeakTrackingVH>> currentDefinitions;
+    llvm::DenseMap<llvm::BasicBlock*, llvm::SmallVector<std::pair<Variable, llvm::PHINode*>, 4>> incompletePhis;
+    llvm::DenseSet<llvm::BasicBlock*> sealedBlocks;
+
+    llvm::Value* readVariableRecursive(Variable variable, llvm::Type* type, llvm::BasicBlock* block);
+    llvm::Value* addPhiOperands(Variable variable, llvm::PHINode* phi);
+    llvm::Value* tryRemoveTrivialPhi(llvm::PHINode* phi);
+
+    static llvm::PHINode* createPhi(llvm::Type* type, llvm::BasicBlock* block);
+
+public:
+    void writeVariable(Variable variable, llvm::BasicBlock* block, llvm::Value* value);
+    llvm::Value* readVariable(Variable variable, llvm::Type* type, llvm::BasicBlock* block);
+
+    // Must be called once every predecessor of block has been linked to it
+    void sealBlock(llvm::BasicBlock* block);
+    bool isSealed(llvm::BasicBlock* block) const;
+
+    // Forget every definition. Should be called after finishing each function
+    void clear();
+};
+
+} // namespace Ceres::Codegen
+
+#endif // COMPILER_SSABUILDER_H
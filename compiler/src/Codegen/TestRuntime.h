@@ -0,0 +1,51 @@
+#ifndef COMPILER_TESTRUNTIME_H
+#define COMPILER_TESTRUNTIME_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Library functions of the test programs. They are shared by tests/codegen/test_driver.cpp, which links them with an
+// object file, and by the JIT, so both run the tests the same way. Only depends on the standard library, as the test
+// driver is built on its own
+namespace Ceres::TestRuntime {
+
+// Signal a fail message and bail (exit)
+[[noreturn]] inline void failed(std::string const& msg)
+{
+    std::cerr << "Test failed: " << msg << std::endl;
+    exit(1);
+}
+
+inline void passed() { std::cout << "Test passed!" << std::endl; }
+
+// Note: Not called assert, as it could be the macro from <cassert>
+inline void assertTrue(bool cond)
+{
+    if (!cond) {
+        failed("Assertion failed");
+    }
+}
+
+// Printing ints
+inline void printI8(int8_t x)
+{
+    /* Print as number instead of char */
+    std::cout << +x << std::endl;
+}
+inline void printI16(int16_t x) { std::cout << x << std::endl; }
+inline void printI32(int32_t x) { std::cout << x << std::endl; }
+inline void printI64(int64_t x) { std::cout << x << std::endl; }
+inline void printU8(uint8_t x) { std::cout << x << std::endl; }
+inline void printU16(uint16_t x) { std::cout << x << std::endl; }
+inline void printU32(uint32_t x) { std::cout << x << std::endl; }
+inline void printU64(uint64_t x) { std::cout << x << std::endl; }
+
+// Printing floats
+inline void printF32(float x) { std::cout << x << std::endl; }
+inline void printF64(double x) { std::cout << x << std::endl; }
+
+} // namespace Ceres::TestRuntime
+
+#endif // COMPILER_TESTRUNTIME_H
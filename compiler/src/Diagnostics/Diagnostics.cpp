@@ -1,10 +1,115 @@
 #include "Diagnostics.h"
+#include "../utils/log.hpp"
+#include <algorithm>
+#include <optional>
 
 namespace Ceres {
-unsigned Diagnostics::numErrors = 0;
-unsigned Diagnostics::numWarnings = 0;
-unsigned Diagnostics::numRemarks = 0;
-unsigned Diagnostics::numNotes = 0;
+std::atomic<unsigned> Diagnostics::numErrors = 0;
+std::atomic<unsigned> Diagnostics::numWarnings = 0;
+std::atomic<unsigned> Diagnostics::numRemarks = 0;
+std::atomic<unsigned> Diagnostics::numNotes = 0;
+
+std::atomic<unsigned> Diagnostics::errorLimit = 0;
+
+DiagnosticBuffer Diagnostics::printedBuffer;
+
+thread_local DiagnosticsCapture* Diagnostics::currentCapture = nullptr;
+
+// Last error, warning or remark reported by the current thread, which the notes reported after it are attached to
+struct LastReportedGroup {
+    DiagnosticBuffer* buffer = nullptr;
+    uint32_t group = 0;
+    uint32_t groupOffset = 0;
+};
+
+static thread_local LastReportedGroup lastReportedGroup;
+
+// Called when the diagnostics of the buffer are cleared or the buffer is destroyed, so the group index doesn't point to
+// another diagnostic, or to none, when a note is reported later
+static void forgetLastReportedGroup(DiagnosticBuffer const* buffer)
+{
+    if (lastReportedGroup.buffer == buffer) {
+        lastReportedGroup = {};
+    }
+}
+
+DiagnosticsCapture::DiagnosticsCapture()
+    : stream(output)
+    , previousCapture(Diagnostics::currentCapture)
+{
+    // Keep colored output if diagnostics would have been colored when printed directly
+    stream.enable_colors(llvm::errs().has_colors());
+    Diagnostics::currentCapture = this;
+
+    // Note: The buffer may be at the same address as the one of a destroyed capture
+    forgetLastReportedGroup(&buffer);
+}
+
+DiagnosticsCapture::~DiagnosticsCapture()
+{
+    ASSERT(Diagnostics::currentCapture == this);
+    Diagnostics::currentCapture = previousCapture;
+    forgetLastReportedGroup(&buffer);
+}
+
+std::string const& DiagnosticsCapture::getOutput()
+{
+    buffer.print(stream);
+    return stream.str();
+}
+
+DiagnosticsRedirect::DiagnosticsRedirect(DiagnosticsCapture* capture)
+    : previousCapture(Diagnostics::currentCapture)
+{
+    Diagnostics::currentCapture = capture;
+}
+
+DiagnosticsRedirect::~DiagnosticsRedirect() { Diagnostics::currentCapture = previousCapture; }
+
+void DiagnosticBuffer::print(llvm::raw_ostream& stream)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Note: Notes have the offset and the group of the diagnostic they are attached to, and are stored after it, so the
+    // stable sort keeps them right after it. Diagnostics at the same offset are printed in the order they were reported
+    std::stable_sort(diagnostics.begin(), diagnostics.end(), [](auto const& lhs, auto const& rhs) {
+        return std::tie(lhs.groupOffset, lhs.group) < std::tie(rhs.groupOffset, rhs.group);
+    });
+
+    // Note: The limit is applied after sorting, since the errors are reported in the order the passes and threads find
+    // them, which is not the order of the source
+    auto limit = Diagnostics::errorLimit.load();
+    bool reachedErrorLimit = false;
+    std::optional<uint32_t> droppedGroup;
+    for (auto const& diagnostic : diagnostics) {
+        auto kind = Diagnostics::getDiagnosticKind(diagnostic.id);
+        if (kind == llvm::SourceMgr::DK_Error && limit != 0 && numPrintedErrors >= limit) {
+            reachedErrorLimit = true;
+            droppedGroup = diagnostic.group;
+            continue;
+        }
+
+        // The notes of a dropped error are dropped too
+        if (kind == llvm::SourceMgr::DK_Note && droppedGroup == diagnostic.group) {
+            continue;
+        }
+
+        if (kind == llvm::SourceMgr::DK_Error) {
+            numPrintedErrors++;
+        }
+        Diagnostics::printDiagnostic(stream, diagnostic);
+    }
+    diagnostics.clear();
+    forgetLastReportedGroup(this);
+
+    if (reachedErrorLimit && !printedErrorLimit) {
+        // Note: It has no location, so it's printed without the file name
+        auto id = Diag::too_many_errors;
+        auto msg = fmt::format(Diagnostics::getDiagnosticFormatString(id), limit);
+        llvm::SMDiagnostic("", Diagnostics::getDiagnosticKind(id), msg).print(nullptr, stream);
+        printedErrorLimit = true;
+    }
+}
 
 char const* diagnosticTexts[] = {
 #define DIAG(identifier, severity, formatString) formatString,
@@ -25,19 +130,116 @@ llvm::SourceMgr::DiagKind Diagnostics::getDiagnosticKind(Diag diagIdentifier)
     return diagnosticsKind[(int)diagIdentifier];
 }
 
+void Diagnostics::countDiagnostic(llvm::SourceMgr::DiagKind kind)
+{
+    switch (kind) {
+    case llvm::SourceMgr::DK_Error:
+        numErrors++;
+        break;
+    case llvm::SourceMgr::DK_Warning:
+        numWarnings++;
+        break;
+    case llvm::SourceMgr::DK_Remark:
+        numRemarks++;
+        break;
+    case llvm::SourceMgr::DK_Note:
+        numNotes++;
+        break;
+    }
+}
+
+DiagnosticBuffer& Diagnostics::getCurrentBuffer()
+{
+    return currentCapture != nullptr ? currentCapture->buffer : printedBuffer;
+}
+
+void Diagnostics::store(StoredDiagnostic&& diagnostic)
+{
+    auto& buffer = getCurrentBuffer();
+    auto kind = getDiagnosticKind(diagnostic.id);
+
+    // A note reported right after another diagnostic in the same buffer belongs to it
+    bool isAttachedNote = kind == llvm::SourceMgr::DK_Note && lastReportedGroup.buffer == &buffer;
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    if (kind == llvm::SourceMgr::DK_Error) {
+        buffer.numErrors++;
+    }
+
+    auto index = static_cast<uint32_t>(buffer.diagnostics.size());
+    if (isAttachedNote) {
+        diagnostic.group = lastReportedGroup.group;
+        diagnostic.groupOffset = lastReportedGroup.groupOffset;
+    } else {
+        diagnostic.group = index;
+        if (kind != llvm::SourceMgr::DK_Note) {
+            lastReportedGroup = { &buffer, index, diagnostic.groupOffset };
+        }
+    }
+
+    buffer.diagnostics.push_back(std::move(diagnostic));
+    countDiagnostic(kind);
+}
+
+void Diagnostics::flush() { getCurrentBuffer().print(getOutputStream()); }
+
+bool Diagnostics::hasReachedErrorLimit()
+{
+    auto limit = errorLimit.load();
+    return limit != 0 && getCurrentBuffer().numErrors >= limit;
+}
+
+llvm::raw_ostream& Diagnostics::getOutputStream()
+{
+    if (currentCapture != nullptr) {
+        return currentCapture->stream;
+    }
+    return llvm::errs();
+}
+
+void Diagnostics::printDiagnostic(llvm::raw_ostream& stream, StoredDiagnostic const& diagnostic)
+{
+    std::string msg = fmt::vformat(getDiagnosticFormatString(diagnostic.id), diagnostic.arguments);
+    auto kind = getDiagnosticKind(diagnostic.id);
+    auto const& range = diagnostic.span;
+
+    llvm::SMLoc loc {};
+    if (range.isValid()) {
+        loc = getSMLocFromSourceSpan(range);
+    }
+
+    std::vector<llvm::SMRange> smRanges;
+    smRanges.reserve(diagnostic.extraRanges.size() + 1);
+
+    if (range.isValid() && diagnostic.hasRange) {
+        smRanges.push_back(getSMRangeFromSourceSpan(range));
+    }
+
+    for (auto const& sourceSpan : diagnostic.extraRanges) {
+        smRanges.push_back(getSMRangeFromSourceSpan(sourceSpan));
+    }
+
+    std::vector<llvm::SMFixIt> smFixIt;
+    smFixIt.reserve(diagnostic.fixIts.size());
+
+    for (auto const& fixIt : diagnostic.fixIts) {
+        smFixIt.push_back(getSMFixItFromFixIt(fixIt));
+    }
+
+    SourceManager::get().getLLVMSourceMgr().PrintMessage(stream, loc, kind, msg, smRanges, smFixIt);
+}
+
 llvm::SMLoc Diagnostics::getSMLocFromSourceSpan(SourceSpan const& span)
 {
-    char const* bufferStart
-        = SourceManager::get().getLLVMSourceMgr().getMemoryBuffer((unsigned)span.fileId)->getBufferStart();
-    return llvm::SMLoc::getFromPointer(bufferStart + span.startCharacterIndex);
+    return SourceManager::get().getSMLoc(span.startOffset);
 }
 
 llvm::SMRange Diagnostics::getSMRangeFromSourceSpan(SourceSpan const& span)
 {
-    char const* bufferStart
-        = SourceManager::get().getLLVMSourceMgr().getMemoryBuffer((unsigned)span.fileId)->getBufferStart();
-    return { llvm::SMLoc::getFromPointer(bufferStart + span.startCharacterIndex),
-        llvm::SMLoc::getFromPointer(bufferStart + span.endCharacterIndex + 1) };
+    // Note: Both ends are in the same file, so the end is found from the start without looking up the file again
+    llvm::SMLoc start = SourceManager::get().getSMLoc(span.startOffset);
+    return { start, llvm::SMLoc::getFromPointer(start.getPointer() + (span.endOffset - span.startOffset) + 1) };
 }
 
 llvm::SMFixIt Diagnostics::getSMFixItFromFixIt(FixItSpan const& fixit)
@@ -4,9 +4,17 @@
 #include "../utils/SourceManager.h"
 #include "../utils/SourceSpan.h"
 #include "FixItSpan.h"
+#include "spdlog/fmt/bundled/args.h"
 #include "spdlog/fmt/fmt.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace Ceres {
 
@@ -16,19 +24,126 @@ enum class Diag {
 #undef DIAG
 };
 
+// Diagnostic as it was reported. The message is only formatted, and the location only looked up, when it's printed
+struct StoredDiagnostic {
+    Diag id;
+    // If false, only the start of the span is shown, without highlighting the range
+    bool hasRange;
+    SourceSpan span;
+    // Start of the first diagnostic of the group, which is the diagnostic itself, or the one a note is attached to
+    uint32_t groupOffset;
+    // Index in the buffer of the first diagnostic of the group
+    uint32_t group;
+    std::vector<SourceSpan> extraRanges;
+    std::vector<FixItSpan> fixIts;
+    fmt::dynamic_format_arg_store<fmt::format_context> arguments;
+
+    StoredDiagnostic(Diag id, SourceSpan const& span, bool hasRange)
+        : id(id)
+        , hasRange(hasRange)
+        , span(span)
+        , groupOffset(span.startOffset)
+        , group(0)
+    {
+    }
+};
+
+// Diagnostics reported but not printed yet. It can be used from several threads at the same time
+class DiagnosticBuffer {
+    std::mutex mutex;
+    std::vector<StoredDiagnostic> diagnostics;
+    std::atomic<unsigned> numErrors = 0;
+    // Errors printed so far, which count towards the error limit
+    unsigned numPrintedErrors = 0;
+    bool printedErrorLimit = false;
+
+    friend class Diagnostics;
+
+public:
+    // Prints the diagnostics in source order, with their notes after them, and empties the buffer. The errors beyond the
+    // error limit are dropped along with their notes, so the ones printed are the first in the source
+    void print(llvm::raw_ostream& stream);
+
+    unsigned getNumErrors() const { return numErrors; }
+};
+
+// While alive, buffers the diagnostics reported by the thread that created it instead of printing them. This allows
+// printing the diagnostics of files compiled in parallel in a deterministic order
+class DiagnosticsCapture {
+    std::string output;
+    llvm::raw_string_ostream stream;
+    DiagnosticBuffer buffer;
+    DiagnosticsCapture* previousCapture;
+
+    friend class Diagnostics;
+
+public:
+    DiagnosticsCapture();
+    ~DiagnosticsCapture();
+
+    DiagnosticsCapture(DiagnosticsCapture const&) = delete;
+    DiagnosticsCapture& operator=(DiagnosticsCapture const&) = delete;
+
+    std::string const& getOutput();
+    [[nodiscard]] unsigned getNumErrors() { return buffer.getNumErrors(); }
+};
+
+// While alive, the diagnostics reported by the current thread go to the given capture, or are printed if it's null.
+// Lets the threads of a pool report to the capture of the thread they are working for
+class DiagnosticsRedirect {
+    DiagnosticsCapture* previousCapture;
+
+public:
+    explicit DiagnosticsRedirect(DiagnosticsCapture* capture);
+    ~DiagnosticsRedirect();
+
+    DiagnosticsRedirect(DiagnosticsRedirect const&) = delete;
+    DiagnosticsRedirect& operator=(DiagnosticsRedirect const&) = delete;
+};
+
+// Diagnostics are stored when they are reported, and printed by flush(), sorted by their location. Errors beyond the
+// error limit are dropped when printing them, along with their notes
 class Diagnostics {
 protected:
     static char const* getDiagnosticFormatString(Diag diagIdentifier);
     static llvm::SourceMgr::DiagKind getDiagnosticKind(Diag diagIdentifier);
 
-    static unsigned numErrors;
-    static unsigned numWarnings;
-    static unsigned numRemarks;
-    static unsigned numNotes;
+    static std::atomic<unsigned> numErrors;
+    static std::atomic<unsigned> numWarnings;
+    static std::atomic<unsigned> numRemarks;
+    static std::atomic<unsigned> numNotes;
+
+    static std::atomic<unsigned> errorLimit;
+
+    // Buffer of the diagnostics that aren't captured
+    static DiagnosticBuffer printedBuffer;
+
+    static thread_local DiagnosticsCapture* currentCapture;
+    friend class DiagnosticsCapture;
+    friend class DiagnosticsRedirect;
+    friend class DiagnosticBuffer;
+
+    static DiagnosticBuffer& getCurrentBuffer();
+    static void store(StoredDiagnostic&& diagnostic);
+    static void countDiagnostic(llvm::SourceMgr::DiagKind kind);
 
     static llvm::SMLoc getSMLocFromSourceSpan(SourceSpan const& span);
     static llvm::SMRange getSMRangeFromSourceSpan(SourceSpan const& span);
     static llvm::SMFixIt getSMFixItFromFixIt(FixItSpan const& fixit);
+    static void printDiagnostic(llvm::raw_ostream& stream, StoredDiagnostic const& diagnostic);
+
+    // Arguments are formatted when the diagnostic is printed, so they can't refer to strings that may be gone by then
+    template<typename T>
+    static constexpr bool isStringView = std::is_same_v<T, llvm::StringRef> || std::is_same_v<T, std::string_view>
+        || std::is_same_v<T, fmt::string_view>;
+
+    template<typename... Args>
+    static void storeWithArguments(StoredDiagnostic&& diagnostic, Args const&... args)
+    {
+        static_assert((!isStringView<Args> && ...), "Diagnostic arguments must own their strings");
+        (diagnostic.arguments.push_back(args), ...);
+        store(std::move(diagnostic));
+    }
 
 public:
     template<typename... Args> static void report(SourceSpan const& range, Diag id, Args&&... args)
@@ -41,82 +156,44 @@ public:
         report(range, id, extraRanges, {}, std::forward<Args>(args)...);
     }
 
+    // Reports a diagnostic that points to a location, instead of to a range
     template<typename... Args> static void report(llvm::SMLoc const& loc, Diag id, Args&&... args)
     {
-        std::string msg = fmt::format(getDiagnosticFormatString(id), std::forward<Args>(args)...);
-        auto kind = getDiagnosticKind(id);
-        auto& srcMgr = SourceManager::get().getLLVMSourceMgr();
-
-        srcMgr.PrintMessage(loc, kind, msg);
-
-        switch (kind) {
-        case llvm::SourceMgr::DK_Error:
-            numErrors++;
-            break;
-        case llvm::SourceMgr::DK_Warning:
-            numWarnings++;
-            break;
-        case llvm::SourceMgr::DK_Remark:
-            numRemarks++;
-            break;
-        case llvm::SourceMgr::DK_Note:
-            numNotes++;
-            break;
-        }
+        auto offset = SourceManager::get().getOffset(loc);
+        storeWithArguments(StoredDiagnostic(id, SourceSpan(offset, offset), false), args...);
     }
 
     template<typename... Args>
     static void report(SourceSpan const& range, Diag id, std::vector<SourceSpan> const& extraRanges,
         std::vector<FixItSpan> const& fixitRanges, Args&&... args)
     {
-        std::string msg = fmt::format(getDiagnosticFormatString(id), std::forward<Args>(args)...);
-        auto kind = getDiagnosticKind(id);
-
-        auto& srcMgr = SourceManager::get().getLLVMSourceMgr();
-
-        llvm::SMLoc loc {};
-        if (range.isSpanValid) {
-            loc = getSMLocFromSourceSpan(range);
-        }
-
-        std::vector<llvm::SMRange> smRanges;
-        smRanges.reserve(extraRanges.size() + 1);
-
-        if (range.isSpanValid) {
-            auto mainRange = getSMRangeFromSourceSpan(range);
-            smRanges.push_back(mainRange);
-        }
-
-        for (auto const& sourceSpan : extraRanges) {
-            smRanges.push_back(getSMRangeFromSourceSpan(sourceSpan));
-        }
-
-        std::vector<llvm::SMFixIt> smFixIt;
-        smFixIt.reserve(fixitRanges.size());
-
-        for (auto const& fixIt : fixitRanges) {
-            smFixIt.push_back(getSMFixItFromFixIt(fixIt));
-        }
-
-        srcMgr.PrintMessage(loc, kind, msg, smRanges, smFixIt);
-
-        switch (kind) {
-        case llvm::SourceMgr::DK_Error:
-            numErrors++;
-            break;
-        case llvm::SourceMgr::DK_Warning:
-            numWarnings++;
-            break;
-        case llvm::SourceMgr::DK_Remark:
-            numRemarks++;
-            break;
-        case llvm::SourceMgr::DK_Note:
-            numNotes++;
-            break;
-        }
+        StoredDiagnostic diagnostic(id, range, true);
+        diagnostic.extraRanges = extraRanges;
+        diagnostic.fixIts = fixitRanges;
+        storeWithArguments(std::move(diagnostic), args...);
     }
 
-    static unsigned getNumErrors() { return numErrors; }
+    // Prints the diagnostics reported by the current thread so far
+    static void flush();
+
+    // Maximum number of errors to print, 0 means no limit
+    static void setErrorLimit(unsigned limit) { errorLimit = limit; }
+
+    // True once the current thread has reported as many errors as the limit. Looking for more errors is pointless then,
+    // but the code is only skipped after the errors found so far, as only the first ones in the source are printed
+    static bool hasReachedErrorLimit();
+
+    // Note: If the current thread is capturing diagnostics, only the errors reported to the capture are counted
+    static unsigned getNumErrors()
+    {
+        return currentCapture != nullptr ? currentCapture->getNumErrors() : numErrors.load();
+    }
+
+    // Capture the diagnostics of the current thread are reported to, null if they are printed
+    static DiagnosticsCapture* getCurrentCapture() { return currentCapture; }
+
+    // Stream the diagnostics of the current thread are written to
+    static llvm::raw_ostream& getOutputStream();
 };
 
 } // namespace Ceres
@@ -4,7 +4,7 @@
 
 namespace Ceres::Typing {
 
-FlowData FlowCheckVisitor::doVisitFunctionDefinition(AST::FunctionDefinition& def)
+FlowData FlowCheckVisitor::visitFunctionDefinition(AST::FunctionDefinition& def)
 {
     auto blockData = visit(*def.block);
     auto functionReturnsVoid = llvm::isa<VoidType>(def.returnType);
@@ -17,7 +17,7 @@ FlowData FlowCheckVisitor::doVisitFunctionDefinition(AST::FunctionDefinition& de
 
     return blockData;
 }
-FlowData FlowCheckVisitor::doVisitBlockStatement(AST::BlockStatement& blockStm)
+FlowData FlowCheckVisitor::visitBlockStatement(AST::BlockStatement& blockStm)
 {
     for (auto const& stm : blockStm.statements) {
         auto data = visit(*stm);
@@ -29,19 +29,19 @@ FlowData FlowCheckVisitor::doVisitBlockStatement(AST::BlockStatement& blockStm)
     return FlowData { false };
 }
 
-FlowData FlowCheckVisitor::doVisitExpressionStatement(AST::ExpressionStatement& stm)
+FlowData FlowCheckVisitor::visitExpressionStatement(AST::ExpressionStatement& stm)
 {
     // Expressions don't return
     return FlowData { false };
 }
 
-FlowData FlowCheckVisitor::doVisitForStatement(AST::ForStatement& stm)
+FlowData FlowCheckVisitor::visitForStatement(AST::ForStatement& stm)
 {
     // Loop may never be executed, so return that not all code path have return statements
     return FlowData { false };
 }
 
-FlowData FlowCheckVisitor::doVisitIfStatement(AST::IfStatement& stm)
+FlowData FlowCheckVisitor::visitIfStatement(AST::IfStatement& stm)
 {
     auto thenData = visit(*stm.thenBlock);
 
@@ -53,9 +53,9 @@ FlowData FlowCheckVisitor::doVisitIfStatement(AST::IfStatement& stm)
     }
 }
 
-FlowData FlowCheckVisitor::doVisitReturnStatement(AST::ReturnStatement& stm) { return FlowData { true }; }
+FlowData FlowCheckVisitor::visitReturnStatement(AST::ReturnStatement& stm) { return FlowData { true }; }
 
-FlowData FlowCheckVisitor::doVisitWhileStatement(AST::WhileStatement& stm)
+FlowData FlowCheckVisitor::visitWhileStatement(AST::WhileStatement& stm)
 {
     // Loop may never be executed, so return that not all code path have return statements
     return FlowData { false };
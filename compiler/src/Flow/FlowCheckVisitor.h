@@ -1,8 +1,7 @@
 #ifndef COMPILER_FlowCheckVisitor_H
 #define COMPILER_FlowCheckVisitor_H
 
-#include "../AST/ASTVisitor.h"
-#include "../AST/ReturningASTVisitor.hpp"
+#include "../AST/StaticASTVisitor.hpp"
 #include "../Binding/Scope.h"
 
 namespace Ceres::Typing {
@@ -12,16 +11,16 @@ struct FlowData {
     bool allCodePathsHaveReturnStatements = false;
 };
 
-class FlowCheckVisitor : public AST::ReturningASTVisitor<FlowData> {
+class FlowCheckVisitor : public AST::StaticASTVisitor<FlowCheckVisitor, FlowData> {
 public:
-    FlowData doVisitFunctionDefinition(AST::FunctionDefinition& def) override;
+    FlowData visitFunctionDefinition(AST::FunctionDefinition& def);
 
-    FlowData doVisitBlockStatement(AST::BlockStatement& stm) override;
-    FlowData doVisitExpressionStatement(AST::ExpressionStatement& stm) override;
-    FlowData doVisitForStatement(AST::ForStatement& stm) override;
-    FlowData doVisitIfStatement(AST::IfStatement& stm) override;
-    FlowData doVisitReturnStatement(AST::ReturnStatement& stm) override;
-    FlowData doVisitWhileStatement(AST::WhileStatement& stm) override;
+    FlowData visitBlockStatement(AST::BlockStatement& stm);
+    FlowData visitExpressionStatement(AST::ExpressionStatement& stm);
+    FlowData visitForStatement(AST::ForStatement& stm);
+    FlowData visitIfStatement(AST::IfStatement& stm);
+    FlowData visitReturnStatement(AST::ReturnStatement& stm);
+    FlowData visitWhileStatement(AST::WhileStatement& stm);
 };
 } // namespace Ceres::Typing
 
@@ -0,0 +1,49 @@
+#include "AntlrTokenSource.h"
+#include "../utils/log.hpp"
+#include "CeresLexer.h"
+
+namespace Ceres::Lexer {
+
+#define TOKEN(identifier, displayName)                                                                                 \
+    static_assert((size_t)TokenKind::identifier == antlrgenerated::CeresLexer::identifier,                             \
+        "Token kind " #identifier " doesn't match the ANTLR token type");
+#include "Tokens.def"
+#undef TOKEN
+
+AntlrTokenSource::AntlrTokenSource(std::vector<Token> tokens, llvm::StringRef source, std::string sourceName)
+    : tokens(std::move(tokens))
+    , source(source)
+    , sourceName(std::move(sourceName))
+{
+    ASSERT(!this->tokens.empty() && this->tokens.back().kind == TokenKind::EndOfFile);
+}
+
+std::unique_ptr<antlr4::Token> AntlrTokenSource::nextToken()
+{
+    auto const& token = tokens[nextTokenIndex];
+    if (token.kind != TokenKind::EndOfFile) {
+        nextTokenIndex++;
+    }
+
+    bool isEOF = token.kind == TokenKind::EndOfFile;
+    size_t type = isEOF ? antlr4::Token::EOF : (size_t)token.kind;
+
+    // Note: As in ANTLR, the stop index is inclusive, so it's one before the start index for the (empty) EOF token
+    auto result = std::make_unique<antlr4::CommonToken>(std::make_pair(this, (antlr4::CharStream*)nullptr), type,
+        antlr4::Token::DEFAULT_CHANNEL, token.offset, (size_t)token.offset + token.length - 1);
+    result->setText(isEOF ? "<EOF>" : source.substr(token.offset, token.length).str());
+    result->setLine(token.line);
+    result->setCharPositionInLine(token.column);
+    return result;
+}
+
+size_t AntlrTokenSource::getLine() const { return tokens[nextTokenIndex].line; }
+
+size_t AntlrTokenSource::getCharPositionInLine() { return tokens[nextTokenIndex].column; }
+
+antlr4::TokenFactory<antlr4::CommonToken>* AntlrTokenSource::getTokenFactory()
+{
+    return antlr4::CommonTokenFactory::DEFAULT.get();
+}
+
+} // namespace Ceres::Lexer
@@ -0,0 +1,38 @@
+#ifndef COMPILER_ANTLRTOKENSOURCE_H
+#define COMPILER_ANTLRTOKENSOURCE_H
+
+#include "Lexer.h"
+#include "antlr4-runtime.h"
+#include <llvm/ADT/StringRef.h>
+#include <string>
+#include <vector>
+
+namespace Ceres::Lexer {
+
+// Feeds the tokens of the hand-written lexer to the ANTLR generated parser. The token kinds are the same as the token
+// types of the generated CeresLexer, so the parser can't tell the difference
+class AntlrTokenSource : public antlr4::TokenSource {
+    std::vector<Token> tokens;
+    size_t nextTokenIndex = 0;
+
+    llvm::StringRef source;
+    std::string sourceName;
+
+public:
+    AntlrTokenSource(std::vector<Token> tokens, llvm::StringRef source, std::string sourceName);
+
+    // Note: Once the end of the file is reached, keeps returning EOF tokens
+    std::unique_ptr<antlr4::Token> nextToken() override;
+
+    size_t getLine() const override;
+    size_t getCharPositionInLine() override;
+
+    // There is no character stream, the tokens have already been lexed
+    antlr4::CharStream* getInputStream() override { return nullptr; }
+    std::string getSourceName() override { return sourceName; }
+    antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() override;
+};
+
+} // namespace Ceres::Lexer
+
+#endif // COMPILER_ANTLRTOKENSOURCE_H
@@ -0,0 +1,542 @@
+#include "Lexer.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "../utils/SourceManager.h"
+#include "../utils/log.hpp"
+#include <llvm/ADT/StringSwitch.h>
+#include <llvm/Support/MathExtras.h>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    define CERES_LEXER_USE_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+namespace Ceres::Lexer {
+
+static char const* tokenKindNames[] = {
+    "EOF",
+#define TOKEN(identifier, displayName) #identifier,
+#include "Tokens.def"
+#undef TOKEN
+};
+
+static char const* tokenKindDisplayNames[] = {
+    "<EOF>",
+#define TOKEN(identifier, displayName) displayName,
+#include "Tokens.def"
+#undef TOKEN
+};
+
+char const* getTokenKindName(TokenKind kind) { return tokenKindNames[(size_t)kind]; }
+
+char const* getTokenKindDisplayName(TokenKind kind) { return tokenKindDisplayNames[(size_t)kind]; }
+
+static bool isWhitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f'; }
+static bool isDecDigit(char c) { return c >= '0' && c <= '9'; }
+static bool isHexDigit(char c) { return isDecDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+static bool isOctDigit(char c) { return c >= '0' && c <= '7'; }
+static bool isBinDigit(char c) { return c == '0' || c == '1'; }
+static bool isIdentifierStart(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+static bool isIdentifierChar(char c) { return isIdentifierStart(c) || isDecDigit(c); }
+
+#ifdef CERES_LEXER_USE_SSE2
+// Note: Comparisons are signed, so bytes >= 0x80 (non-ASCII) are never inside the ranges
+static __m128i inRange(__m128i chunk, char low, char high)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8((char)(low - 1))),
+        _mm_cmplt_epi8(chunk, _mm_set1_epi8((char)(high + 1))));
+}
+
+static unsigned whitespaceMask(__m128i chunk)
+{
+    __m128i spaces
+        = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    __m128i newlines
+        = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')));
+    __m128i formFeeds = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\f'));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(spaces, newlines), formFeeds));
+}
+
+static unsigned identifierMask(__m128i chunk)
+{
+    // Setting the 0x20 bit maps uppercase letters to lowercase, without mapping any other character to a letter
+    __m128i letters = inRange(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 'z');
+    __m128i digits = inRange(chunk, '0', '9');
+    __m128i underscores = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letters, digits), underscores));
+}
+#endif
+
+// Returns the first character in [begin, end) that is not whitespace
+static char const* findWhitespaceEnd(char const* begin, char const* end)
+{
+#ifdef CERES_LEXER_USE_SSE2
+    while (end - begin >= 16) {
+        unsigned mask = whitespaceMask(_mm_loadu_si128(reinterpret_cast<__m128i const*>(begin)));
+        if (mask != 0xFFFF) {
+            return begin + llvm::countTrailingOnes(mask);
+        }
+        begin += 16;
+    }
+#endif
+    while (begin != end && isWhitespace(*begin)) {
+        begin++;
+    }
+    return begin;
+}
+
+// Returns the first character in [begin, end) that can't be part of an identifier
+static char const* findIdentifierEnd(char const* begin, char const* end)
+{
+#ifdef CERES_LEXER_USE_SSE2
+    while (end - begin >= 16) {
+        unsigned mask = identifierMask(_mm_loadu_si128(reinterpret_cast<__m128i const*>(begin)));
+        if (mask != 0xFFFF) {
+            return begin + llvm::countTrailingOnes(mask);
+        }
+        begin += 16;
+    }
+#endif
+    while (begin != end && isIdentifierChar(*begin)) {
+        begin++;
+    }
+    return begin;
+}
+
+// Returns the first '*' or '/' in [begin, end), which are the only characters that can open or close a comment
+static char const* findCommentDelimiter(char const* begin, char const* end)
+{
+#ifdef CERES_LEXER_USE_SSE2
+    while (end - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+        unsigned mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('*')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/'))));
+        if (mask != 0) {
+            return begin + llvm::countTrailingZeros(mask);
+        }
+        begin += 16;
+    }
+#endif
+    while (begin != end && *begin != '*' && *begin != '/') {
+        begin++;
+    }
+    return begin;
+}
+
+/* Matchers for the literal rules. They return the end of the longest match starting at begin, or nullptr */
+
+// Digits: [0-9] ([0-9_]* [0-9])?
+static char const* matchDigits(char const* begin, char const* end)
+{
+    if (begin == end || !isDecDigit(*begin)) {
+        return nullptr;
+    }
+
+    char const* lastDigit = begin;
+    for (char const* it = begin + 1; it != end && (isDecDigit(*it) || *it == '_'); it++) {
+        if (isDecDigit(*it)) {
+            lastDigit = it;
+        }
+    }
+    return lastDigit + 1;
+}
+
+// HexDigits: HexDigit ((HexDigit | '_')* HexDigit)?
+static char const* matchHexDigits(char const* begin, char const* end)
+{
+    if (begin == end || !isHexDigit(*begin)) {
+        return nullptr;
+    }
+
+    char const* lastDigit = begin;
+    for (char const* it = begin + 1; it != end && (isHexDigit(*it) || *it == '_'); it++) {
+        if (isHexDigit(*it)) {
+            lastDigit = it;
+        }
+    }
+    return lastDigit + 1;
+}
+
+// ExponentPart: [eE] [+-]? Digits
+static char const* matchExponent(char const* begin, char const* end)
+{
+    if (begin == end || (*begin != 'e' && *begin != 'E')) {
+        return nullptr;
+    }
+
+    char const* it = begin + 1;
+    if (it != end && (*it == '+' || *it == '-')) {
+        it++;
+    }
+    return matchDigits(it, end);
+}
+
+// DEC_LITERAL: DecDigit (DecDigit | '_')*
+static char const* matchDecLiteral(char const* begin, char const* end)
+{
+    if (begin == end || !isDecDigit(*begin)) {
+        return nullptr;
+    }
+
+    char const* it = begin + 1;
+    while (it != end && (isDecDigit(*it) || *it == '_')) {
+        it++;
+    }
+    return it;
+}
+
+// HEX_LITERAL, OCT_LITERAL and BIN_LITERAL: '0' prefix '_'* Digit (Digit | '_')*
+static char const* matchPrefixedLiteral(char const* begin, char const* end, char prefix, bool (*isDigit)(char))
+{
+    if (end - begin < 2 || begin[0] != '0' || begin[1] != prefix) {
+        return nullptr;
+    }
+
+    char const* it = begin + 2;
+    while (it != end && *it == '_') {
+        it++;
+    }
+
+    if (it == end || !isDigit(*it)) {
+        return nullptr;
+    }
+
+    while (it != end && (isDigit(*it) || *it == '_')) {
+        it++;
+    }
+    return it;
+}
+
+// FLOAT_LITERAL: (Digits '.' Digits? | '.' Digits) ExponentPart? | Digits ExponentPart
+static char const* matchFloatLiteral(char const* begin, char const* end)
+{
+    char const* it;
+
+    if (char const* digits = matchDigits(begin, end)) {
+        if (digits == end || *digits != '.') {
+            return matchExponent(digits, end);
+        }
+
+        it = digits + 1;
+        if (char const* fraction = matchDigits(it, end)) {
+            it = fraction;
+        }
+    } else {
+        if (begin == end || *begin != '.') {
+            return nullptr;
+        }
+
+        it = matchDigits(begin + 1, end);
+        if (it == nullptr) {
+            return nullptr;
+        }
+    }
+
+    if (char const* exponent = matchExponent(it, end)) {
+        it = exponent;
+    }
+    return it;
+}
+
+// HEX_FLOAT_LITERAL: '0' [xX] (HexDigits '.'? | HexDigits? '.' HexDigits) [pP] [+-]? Digits
+static char const* matchHexFloatLiteral(char const* begin, char const* end)
+{
+    if (end - begin < 2 || begin[0] != '0' || (begin[1] != 'x' && begin[1] != 'X')) {
+        return nullptr;
+    }
+
+    char const* it = begin + 2;
+    char const* integerPart = matchHexDigits(it, end);
+    if (integerPart != nullptr) {
+        it = integerPart;
+    }
+
+    if (it != end && *it == '.') {
+        char const* fractionalPart = matchHexDigits(it + 1, end);
+        if (fractionalPart == nullptr && integerPart == nullptr) {
+            return nullptr;
+        }
+        it = fractionalPart != nullptr ? fractionalPart : it + 1;
+    } else if (integerPart == nullptr) {
+        return nullptr;
+    }
+
+    if (it == end || (*it != 'p' && *it != 'P')) {
+        return nullptr;
+    }
+
+    it++;
+    if (it != end && (*it == '+' || *it == '-')) {
+        it++;
+    }
+    return matchDigits(it, end);
+}
+
+Lexer::Lexer(llvm::StringRef source, unsigned fileId)
+    : source(source)
+    , fileId(fileId)
+    , current(source.begin())
+    , lineStart(source.begin())
+{
+}
+
+std::vector<Token> Lexer::lex()
+{
+    // Tokens are a few characters long on average, so this avoids most reallocations
+    tokens.reserve(source.size() / 4 + 1);
+
+    char const* end = source.end();
+    while (current != end) {
+        char c = *current;
+
+        if (isWhitespace(c)) {
+            skipWhitespace();
+        } else if (isIdentifierStart(c)) {
+            lexIdentifierOrKeyword();
+        } else if (isDecDigit(c) || (c == '.' && current + 1 != end && isDecDigit(current[1]))) {
+            lexNumber();
+        } else {
+            lexOperator();
+        }
+    }
+
+    addToken(TokenKind::EndOfFile, end, end);
+    return std::move(tokens);
+}
+
+void Lexer::skipWhitespace() { advanceOverSkipped(findWhitespaceEnd(current, source.end())); }
+
+bool Lexer::skipInlineComment()
+{
+    // INLINE_COMMENT: '//' .*? '\n'
+    auto const* newline = static_cast<char const*>(std::memchr(current + 2, '\n', source.end() - (current + 2)));
+    if (newline == nullptr) {
+        // Note: A comment in the last line without a trailing newline is not a comment for ANTLR either
+        return false;
+    }
+
+    advanceOverSkipped(newline + 1);
+    return true;
+}
+
+bool Lexer::skipComment()
+{
+    // COMMENT: '/*' (COMMENT|.)*? '*/'
+    // Comments can be nested. If a nested comment is not closed, the comment ends at the first '*/' instead
+    char const* end = source.end();
+    char const* it = current + 2;
+    char const* firstClose = nullptr;
+    unsigned depth = 1;
+
+    while ((it = findCommentDelimiter(it, end)) != end) {
+        if (it + 1 == end) {
+            break;
+        }
+
+        if (it[0] == '*' && it[1] == '/') {
+            if (firstClose == nullptr) {
+                firstClose = it;
+            }
+
+            it += 2;
+            if (--depth == 0) {
+                advanceOverSkipped(it);
+                return true;
+            }
+        } else if (it[0] == '/' && it[1] == '*') {
+            depth++;
+            it += 2;
+        } else {
+            it++;
+        }
+    }
+
+    if (firstClose == nullptr) {
+        return false;
+    }
+
+    advanceOverSkipped(firstClose + 2);
+    return true;
+}
+
+void Lexer::lexIdentifierOrKeyword()
+{
+    char const* end = findIdentifierEnd(current + 1, source.end());
+    llvm::StringRef text(current, end - current);
+
+    // Note: Keywords are defined before IDENTIFIER, so they take precedence on a match of the same length
+    auto kind = llvm::StringSwitch<TokenKind>(text)
+                    .Case("fn", TokenKind::FN)
+                    .Case("pub", TokenKind::PUB)
+                    .Case("var", TokenKind::VAR)
+                    .Case("const", TokenKind::CONSTANT)
+                    .Case("return", TokenKind::RETURN)
+                    .Case("if", TokenKind::IF)
+                    .Case("else", TokenKind::ELSE)
+                    .Case("for", TokenKind::FOR)
+                    .Case("while", TokenKind::WHILE)
+                    .Case("extern", TokenKind::EXTERN)
+                    .Case("cast", TokenKind::CAST)
+                    .Case("bool", TokenKind::BOOL)
+                    .Case("void", TokenKind::UNIT_TYPE)
+                    .Cases("u8", "u16", "u32", "u64", "i8", "i16", "i32", "i64", TokenKind::INTEGER_LITERAL_SUFFIX)
+                    .Cases("f32", "f64", TokenKind::FLOAT_LITERAL_SUFFIX)
+                    .Cases("true", "false", TokenKind::BOOL_LITERAL)
+                    .Default(TokenKind::IDENTIFIER);
+
+    addToken(kind, current, end);
+}
+
+void Lexer::lexNumber()
+{
+    char const* end = source.end();
+
+    // Take the longest match. On a tie, the rule defined first in the grammar wins
+    TokenKind kind = TokenKind::EndOfFile;
+    char const* tokenEnd = current;
+
+    auto tryMatch = [&](TokenKind candidateKind, char const* candidateEnd) {
+        if (candidateEnd != nullptr && candidateEnd > tokenEnd) {
+            kind = candidateKind;
+            tokenEnd = candidateEnd;
+        }
+    };
+
+    tryMatch(TokenKind::DEC_LITERAL, matchDecLiteral(current, end));
+    tryMatch(TokenKind::HEX_LITERAL, matchPrefixedLiteral(current, end, 'x', isHexDigit));
+    tryMatch(TokenKind::OCT_LITERAL, matchPrefixedLiteral(current, end, 'o', isOctDigit));
+    tryMatch(TokenKind::BIN_LITERAL, matchPrefixedLiteral(current, end, 'b', isBinDigit));
+    tryMatch(TokenKind::FLOAT_LITERAL, matchFloatLiteral(current, end));
+    tryMatch(TokenKind::HEX_FLOAT_LITERAL, matchHexFloatLiteral(current, end));
+
+    // Either the number starts with a digit (DEC_LITERAL) or with '.' followed by a digit (FLOAT_LITERAL)
+    ASSERT(kind != TokenKind::EndOfFile);
+    addToken(kind, current, tokenEnd);
+}
+
+void Lexer::lexOperator()
+{
+    char const* end = source.end();
+    char next = current + 1 != end ? current[1] : '\0';
+    char afterNext = next != '\0' && current + 2 != end ? current[2] : '\0';
+
+    auto emit = [&](TokenKind kind, unsigned length) { addToken(kind, current, current + length); };
+
+    switch (*current) {
+    case '+':
+        return next == '+' ? emit(TokenKind::UNARY_PLUS_PLUS_OP, 2)
+            : next == '='  ? emit(TokenKind::PLUS_ASSIGN_OP, 2)
+                           : emit(TokenKind::PLUS_OP, 1);
+    case '-':
+        return next == '-' ? emit(TokenKind::UNARY_MINUS_MINUS_OP, 2)
+            : next == '='  ? emit(TokenKind::MINUS_ASSIGN_OP, 2)
+                           : emit(TokenKind::MINUS_OP, 1);
+    case '*':
+        return next == '=' ? emit(TokenKind::MULT_ASSIGN_OP, 2) : emit(TokenKind::MULT_OP, 1);
+    case '/':
+        if (next == '/' && skipInlineComment()) {
+            return;
+        }
+        if (next == '*' && skipComment()) {
+            return;
+        }
+        return next == '=' ? emit(TokenKind::DIV_ASSIGN_OP, 2) : emit(TokenKind::DIV_OP, 1);
+    case '%':
+        return next == '=' ? emit(TokenKind::MOD_ASSIGN_OP, 2) : emit(TokenKind::MOD_OP, 1);
+    case '|':
+        return next == '|' ? emit(TokenKind::LOGICAL_OR_OP, 2)
+            : next == '='  ? emit(TokenKind::BITWISE_OR_ASSIGN_OP, 2)
+                           : emit(TokenKind::BITWISE_OR, 1);
+    case '&':
+        return next == '&' ? emit(TokenKind::LOGICAL_AND_OP, 2)
+            : next == '='  ? emit(TokenKind::BITWISE_AND_ASSIGN_OP, 2)
+                           : emit(TokenKind::BITWISE_AND, 1);
+    case '^':
+        return next == '=' ? emit(TokenKind::BITWISE_XOR_ASSIGN_OP, 2) : emit(TokenKind::BITWISE_XOR, 1);
+    case '~':
+        return emit(TokenKind::BITWISE_NOT, 1);
+    case '!':
+        return next == '=' ? emit(TokenKind::NOT_EQUAL_OP, 2) : emit(TokenKind::LOGICAL_NOT, 1);
+    case '=':
+        return next == '=' ? emit(TokenKind::EQUAL_OP, 2) : emit(TokenKind::ASSIGN_OP, 1);
+    case '>':
+        // Note: '>>' is not a token by itself, only '>>='
+        return next == '>' && afterNext == '=' ? emit(TokenKind::BITWISE_RIGHT_SHIFT_ASSIGN_OP, 3)
+            : next == '='                      ? emit(TokenKind::GREATER_EQUAL_OP, 2)
+                                               : emit(TokenKind::GREATER_OP, 1);
+    case '<':
+        return next == '<' && afterNext == '=' ? emit(TokenKind::BITWISE_LEFT_SHIFT_ASSIGN_OP, 3)
+            : next == '='                      ? emit(TokenKind::LOWER_EQUAL_OP, 2)
+                                               : emit(TokenKind::LOWER_OP, 1);
+    case '.':
+        return emit(TokenKind::DOT, 1);
+    case ',':
+        return emit(TokenKind::COMMA, 1);
+    case ':':
+        return emit(TokenKind::COLON, 1);
+    case ';':
+        return emit(TokenKind::SEMICOLON, 1);
+    case '{':
+        return emit(TokenKind::OPEN_BRACES, 1);
+    case '}':
+        return emit(TokenKind::CLOSE_BRACES, 1);
+    case '[':
+        return emit(TokenKind::OPEN_BRACKETS, 1);
+    case ']':
+        return emit(TokenKind::CLOSE_BRACKETS, 1);
+    case '(':
+        return emit(TokenKind::OPEN_PARENS, 1);
+    case ')':
+        return emit(TokenKind::CLOSE_PARENS, 1);
+    case '#':
+        return emit(TokenKind::HASH, 1);
+    default:
+        break;
+    }
+
+    // Skip the whole UTF-8 sequence, so a non-ASCII character is only reported once
+    auto leadByte = (unsigned char)*current;
+    unsigned length = leadByte >= 0xF0 ? 4 : leadByte >= 0xE0 ? 3 : leadByte >= 0xC0 ? 2 : 1;
+    length = std::min<unsigned>(length, end - current);
+
+    uint32_t offset = SourceManager::get().getFileStartOffset(fileId) + (current - source.begin());
+    Diagnostics::report(SourceSpan(offset, offset + length - 1), Diag::lex_unexpected_character,
+        llvm::StringRef(current, length).str());
+    advanceOverSkipped(current + length);
+}
+
+void Lexer::advanceOverSkipped(char const* end)
+{
+    char const* it = current;
+
+#ifdef CERES_LEXER_USE_SSE2
+    __m128i const newline = _mm_set1_epi8('\n');
+    while (end - it >= 16) {
+        unsigned mask
+            = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(it)), newline));
+        if (mask != 0) {
+            line += llvm::countPopulation(mask);
+            lineStart = it + llvm::Log2_32(mask) + 1;
+        }
+        it += 16;
+    }
+#endif
+
+    for (; it != end; it++) {
+        if (*it == '\n') {
+            line++;
+            lineStart = it + 1;
+        }
+    }
+
+    current = end;
+}
+
+void Lexer::addToken(TokenKind kind, char const* start, char const* end)
+{
+    tokens.push_back({ kind, (uint32_t)(start - source.begin()), (uint32_t)(end - start), line,
+        (uint32_t)(start - lineStart) });
+    current = end;
+}
+
+} // namespace Ceres::Lexer
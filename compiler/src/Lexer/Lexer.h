@@ -0,0 +1,70 @@
+#ifndef COMPILER_LEXER_H
+#define COMPILER_LEXER_H
+
+#include <llvm/ADT/StringRef.h>
+#include <cstdint>
+#include <vector>
+
+namespace Ceres::Lexer {
+
+enum class TokenKind : uint16_t {
+    EndOfFile = 0,
+#define TOKEN(identifier, displayName) identifier,
+#include "Tokens.def"
+#undef TOKEN
+};
+
+char const* getTokenKindName(TokenKind kind);
+char const* getTokenKindDisplayName(TokenKind kind);
+
+// Tokens are plain values stored contiguously, their text is a slice of the source buffer
+struct Token {
+    TokenKind kind;
+
+    // Offset of the first character of the token into the source buffer, and its length in bytes
+    uint32_t offset;
+    uint32_t length;
+
+    // Line starts at 1, column starts at 0 (as in ANTLR)
+    uint32_t line;
+    uint32_t column;
+};
+
+// Hand-written scanner for the language described by syntax/CeresLexer.g4. It follows the same rules as the ANTLR
+// lexer (longest match, ties resolved in favor of the rule defined first), and uses SIMD to skip whitespace, comments
+// and identifiers
+class Lexer {
+    llvm::StringRef source;
+    unsigned fileId;
+
+    char const* current;
+    uint32_t line = 1;
+    char const* lineStart;
+
+    std::vector<Token> tokens;
+
+    void skipWhitespace();
+
+    // Return false if the characters are not a comment, in which case they have to be lexed as operators
+    bool skipInlineComment();
+    bool skipComment();
+
+    void lexIdentifierOrKeyword();
+    void lexNumber();
+    void lexOperator();
+
+    // Note: Skipped characters may contain newlines, which have to be accounted for
+    void advanceOverSkipped(char const* end);
+    void addToken(TokenKind kind, char const* start, char const* end);
+
+public:
+    Lexer(llvm::StringRef source, unsigned fileId);
+
+    // Returns all the tokens in the source, the last of them being EndOfFile. Unexpected characters are reported and
+    // skipped
+    std::vector<Token> lex();
+};
+
+} // namespace Ceres::Lexer
+
+#endif // COMPILER_LEXER_H
@@ -0,0 +1,946 @@
+#include "Parser.h"
+#include "../AST/nodes/Expressions/AssignmentExpression.h"
+#include "../AST/nodes/Expressions/BinaryOperationExpression.h"
+#include "../AST/nodes/Expressions/BoolLiteralExpression.h"
+#include "../AST/nodes/Expressions/CastExpression.h"
+#include "../AST/nodes/Expressions/CommaExpression.h"
+#include "../AST/nodes/Expressions/FloatLiteralExpression.h"
+#include "../AST/nodes/Expressions/FunctionCallExpression.h"
+#include "../AST/nodes/Expressions/IdentifierExpression.h"
+#include "../AST/nodes/Expressions/IntLiteralExpression.h"
+#include "../AST/nodes/Expressions/PostfixExpression.h"
+#include "../AST/nodes/Expressions/PrefixExpression.h"
+#include "../AST/nodes/FunctionDeclaration.h"
+#include "../AST/nodes/Statements/BlockStatement.h"
+#include "../AST/nodes/Statements/ExpressionStatement.h"
+#include "../AST/nodes/Statements/ForStatement.h"
+#include "../AST/nodes/Statements/FunctionDefinition.h"
+#include "../AST/nodes/Statements/IfStatement.h"
+#include "../AST/nodes/Statements/ReturnStatement.h"
+#include "../AST/nodes/Statements/VariableDeclaration.h"
+#include "../AST/nodes/Statements/WhileStatement.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "../Typing/BinaryOperation.h"
+#include "../Typing/Type.h"
+#include "../utils/SourceManager.h"
+#include "../utils/Symbol.h"
+#include "../utils/log.hpp"
+#include <optional>
+#include <stdexcept>
+
+namespace Ceres::Parser {
+
+using namespace Ceres::AST;
+using Lexer::Token;
+using Lexer::TokenKind;
+
+// Thrown after reporting a syntax error, it's caught where parsing can resume
+class ParseException : public std::runtime_error {
+public:
+    ParseException()
+        : std::runtime_error("ParseException. Should not escape Parser!")
+    {
+    }
+};
+
+struct BinaryOperator {
+    Precedence precedence;
+    // Shifts are written as two tokens ('<' '<' and '>' '>')
+    unsigned numTokens;
+    bool isAssignment;
+    // For compound assignments, the operation applied before assigning. Empty for plain assignments
+    std::optional<Typing::BinaryOperation> operation;
+};
+
+static std::optional<BinaryOperator> getBinaryOperator(TokenKind kind, TokenKind nextKind)
+{
+    using Typing::BinaryOperation;
+
+    auto binary = [](Precedence precedence, BinaryOperation operation) {
+        return BinaryOperator { precedence, 1, false, operation };
+    };
+    auto assignment = [](std::optional<BinaryOperation> operation) {
+        return BinaryOperator { Precedence::Assignment, 1, true, operation };
+    };
+
+    switch (kind) {
+    case TokenKind::MULT_OP:
+        return binary(Precedence::Multiplicative, BinaryOperation::Mult);
+    case TokenKind::DIV_OP:
+        return binary(Precedence::Multiplicative, BinaryOperation::Div);
+    case TokenKind::MOD_OP:
+        return binary(Precedence::Multiplicative, BinaryOperation::Modulo);
+    case TokenKind::PLUS_OP:
+        return binary(Precedence::Additive, BinaryOperation::Sum);
+    case TokenKind::MINUS_OP:
+        return binary(Precedence::Additive, BinaryOperation::Subtraction);
+    case TokenKind::LOWER_OP:
+        if (nextKind == TokenKind::LOWER_OP) {
+            return BinaryOperator { Precedence::Shift, 2, false, BinaryOperation::BitshiftLeft };
+        }
+        return binary(Precedence::Relational, BinaryOperation::LessThan);
+    case TokenKind::GREATER_OP:
+        if (nextKind == TokenKind::GREATER_OP) {
+            return BinaryOperator { Precedence::Shift, 2, false, BinaryOperation::BitshiftRight };
+        }
+        return binary(Precedence::Relational, BinaryOperation::GreaterThan);
+    case TokenKind::LOWER_EQUAL_OP:
+        return binary(Precedence::Relational, BinaryOperation::LessOrEqual);
+    case TokenKind::GREATER_EQUAL_OP:
+        return binary(Precedence::Relational, BinaryOperation::GreaterOrEqual);
+    case TokenKind::BITWISE_AND:
+        return binary(Precedence::BitwiseAnd, BinaryOperation::BitwiseAnd);
+    case TokenKind::BITWISE_XOR:
+        return binary(Precedence::BitwiseXor, BinaryOperation::BitwiseXor);
+    case TokenKind::BITWISE_OR:
+        return binary(Precedence::BitwiseOr, BinaryOperation::BitwiseOr);
+    case TokenKind::EQUAL_OP:
+        return binary(Precedence::Equality, BinaryOperation::Equals);
+    case TokenKind::NOT_EQUAL_OP:
+        return binary(Precedence::Equality, BinaryOperation::NotEquals);
+    case TokenKind::LOGICAL_AND_OP:
+        return binary(Precedence::LogicalAnd, BinaryOperation::LogicalAnd);
+    case TokenKind::LOGICAL_OR_OP:
+        return binary(Precedence::LogicalOr, BinaryOperation::LogicalOr);
+    case TokenKind::ASSIGN_OP:
+        return assignment(std::nullopt);
+    case TokenKind::PLUS_ASSIGN_OP:
+        return assignment(BinaryOperation::Sum);
+    case TokenKind::MINUS_ASSIGN_OP:
+        return assignment(BinaryOperation::Subtraction);
+    case TokenKind::MULT_ASSIGN_OP:
+        return assignment(BinaryOperation::Mult);
+    case TokenKind::DIV_ASSIGN_OP:
+        return assignment(BinaryOperation::Div);
+    case TokenKind::BITWISE_AND_ASSIGN_OP:
+        return assignment(BinaryOperation::BitwiseAnd);
+    case TokenKind::BITWISE_OR_ASSIGN_OP:
+        return assignment(BinaryOperation::BitwiseOr);
+    case TokenKind::BITWISE_XOR_ASSIGN_OP:
+        return assignment(BinaryOperation::BitwiseXor);
+    case TokenKind::BITWISE_RIGHT_SHIFT_ASSIGN_OP:
+        return assignment(BinaryOperation::BitshiftRight);
+    case TokenKind::BITWISE_LEFT_SHIFT_ASSIGN_OP:
+        return assignment(BinaryOperation::BitshiftLeft);
+    case TokenKind::MOD_ASSIGN_OP:
+        return assignment(BinaryOperation::Modulo);
+    default:
+        return std::nullopt;
+    }
+}
+
+// FIRST set of assignmentExpression
+static bool canStartExpression(TokenKind kind)
+{
+    switch (kind) {
+    case TokenKind::OPEN_PARENS:
+    case TokenKind::IDENTIFIER:
+    case TokenKind::DEC_LITERAL:
+    case TokenKind::HEX_LITERAL:
+    case TokenKind::OCT_LITERAL:
+    case TokenKind::BIN_LITERAL:
+    case TokenKind::FLOAT_LITERAL:
+    case TokenKind::HEX_FLOAT_LITERAL:
+    case TokenKind::BOOL_LITERAL:
+    case TokenKind::CAST:
+    case TokenKind::PLUS_OP:
+    case TokenKind::MINUS_OP:
+    case TokenKind::UNARY_PLUS_PLUS_OP:
+    case TokenKind::UNARY_MINUS_MINUS_OP:
+    case TokenKind::BITWISE_NOT:
+    case TokenKind::LOGICAL_NOT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// FIRST set of type
+static bool canStartType(TokenKind kind)
+{
+    switch (kind) {
+    case TokenKind::IDENTIFIER:
+    case TokenKind::INTEGER_LITERAL_SUFFIX:
+    case TokenKind::FLOAT_LITERAL_SUFFIX:
+    case TokenKind::BOOL:
+    case TokenKind::UNIT_TYPE:
+    case TokenKind::FN:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Parser::Parser(std::vector<Lexer::Token> const& tokens, llvm::StringRef source, unsigned fileId)
+    : tokens(tokens)
+    , source(source)
+    , fileStartOffset(SourceManager::get().getFileStartOffset(fileId))
+    , arena(std::make_unique<AST::ASTArena>())
+{
+    ASSERT(!tokens.empty() && tokens.back().kind == TokenKind::EndOfFile);
+}
+
+Token const& Parser::peek(size_t lookahead) const
+{
+    // Note: Looking past the end keeps returning the EndOfFile token
+    return tokens[std::min(current + lookahead, tokens.size() - 1)];
+}
+
+bool Parser::check(TokenKind kind, size_t lookahead) const { return peek(lookahead).kind == kind; }
+
+Token const& Parser::consume()
+{
+    auto const& token = peek();
+    if (token.kind != TokenKind::EndOfFile) {
+        current++;
+    }
+    return token;
+}
+
+bool Parser::consumeIf(TokenKind kind)
+{
+    if (!check(kind)) {
+        return false;
+    }
+    consume();
+    return true;
+}
+
+Token const& Parser::expect(TokenKind kind)
+{
+    if (!check(kind)) {
+        reportMismatchedInput(Lexer::getTokenKindDisplayName(kind));
+    }
+    return consume();
+}
+
+void Parser::reportMismatchedInput(llvm::StringRef expected)
+{
+    auto const& token = peek();
+    auto text = token.kind == TokenKind::EndOfFile ? llvm::StringRef("<EOF>") : getText(token);
+
+    // Note: As the ANTLR parser, point to the start of the offending token
+    Diagnostics::report(llvm::SMLoc::getFromPointer(source.data() + token.offset), Diag::parse_mismatched_input,
+        text.str(), expected.str());
+    throw ParseException();
+}
+
+void Parser::synchronizeStatement()
+{
+    // Skip to the end of the statement, which is either a ';' or the end of a block, ignoring nested blocks
+    unsigned depth = 0;
+    while (!check(TokenKind::EndOfFile)) {
+        auto kind = peek().kind;
+        if (kind == TokenKind::SEMICOLON && depth == 0) {
+            consume();
+            return;
+        } else if (kind == TokenKind::OPEN_BRACES) {
+            depth++;
+        } else if (kind == TokenKind::CLOSE_BRACES) {
+            if (depth == 0) {
+                // End of the enclosing block
+                return;
+            }
+
+            consume();
+            if (--depth == 0) {
+                return;
+            }
+            continue;
+        }
+        consume();
+    }
+}
+
+void Parser::synchronizeGlobalDeclaration()
+{
+    // Skip to the next token that starts a global declaration, ignoring the contents of blocks
+    unsigned depth = 0;
+    while (!check(TokenKind::EndOfFile)) {
+        auto kind = peek().kind;
+        if (depth == 0
+            && (kind == TokenKind::FN || kind == TokenKind::PUB || kind == TokenKind::EXTERN || kind == TokenKind::VAR
+                || kind == TokenKind::CONSTANT || kind == TokenKind::HASH)) {
+            return;
+        } else if (kind == TokenKind::OPEN_BRACES) {
+            depth++;
+        } else if (kind == TokenKind::CLOSE_BRACES && depth > 0) {
+            depth--;
+        }
+        consume();
+    }
+}
+
+llvm::StringRef Parser::getText(Token const& token) const { return source.substr(token.offset, token.length); }
+
+SourceSpan Parser::getSourceSpan(Token const& token) const { return getSourceSpan(token, token); }
+
+SourceSpan Parser::getSourceSpan(Token const& first, Token const& last) const
+{
+    // Note: As in ANTLR, the end index is inclusive
+    return { fileStartOffset + first.offset, fileStartOffset + last.offset + last.length - 1 };
+}
+
+SourceSpan Parser::getSourceSpanFrom(size_t firstTokenIndex) const
+{
+    ASSERT(current > firstTokenIndex);
+    return getSourceSpan(tokens[firstTokenIndex], tokens[current - 1]);
+}
+
+std::unique_ptr<CompilationUnit> Parser::parseCompilationUnit()
+{
+    std::vector<FunctionDefinition*> functionDefinitions;
+    std::vector<FunctionDeclaration*> functionDeclarations;
+    std::vector<VariableDeclaration*> variableDeclarations;
+
+    // Note: Once the error limit is reached, the rest of the file is skipped, as its errors would not be printed
+    while (!check(TokenKind::EndOfFile) && !Diagnostics::hasReachedErrorLimit()) {
+        size_t start = current;
+        try {
+            bool hasAttributes = check(TokenKind::HASH);
+            std::vector<Attribute> attributes;
+            if (hasAttributes) {
+                attributes = parseAttributes();
+            }
+
+            bool isPublic = consumeIf(TokenKind::PUB);
+
+            if (check(TokenKind::FN)) {
+                // globalFunctionDefinition: attributes? PUB? functionDefinition
+                auto functionAttributes = createAttributes<FunctionAttributes>(attributes);
+                auto functionDefinition = parseFunctionDefinition();
+                functionDefinition->attributes = functionAttributes;
+                functionDefinition->visibility = isPublic ? FunctionVisibility::Public : FunctionVisibility::Private;
+                functionDefinition->sourceSpan = getSourceSpanFrom(start);
+                functionDefinitions.push_back(functionDefinition);
+            } else if (hasAttributes) {
+                reportMismatchedInput(isPublic ? "'fn'" : "{'pub', 'fn'}");
+            } else if (check(TokenKind::VAR) || check(TokenKind::CONSTANT)) {
+                // globalVarDeclaration: PUB? varDeclaration SEMICOLON
+                auto variableDeclaration = parseVariableDeclaration();
+                expect(TokenKind::SEMICOLON);
+                variableDeclaration->visibility
+                    = isPublic ? Typing::VariableVisibility::Public : Typing::VariableVisibility::Private;
+                variableDeclaration->scope = VariableScope::Global;
+                variableDeclaration->sourceSpan = getSourceSpanFrom(start);
+                variableDeclarations.push_back(variableDeclaration);
+            } else if (!isPublic && check(TokenKind::EXTERN)) {
+                functionDeclarations.push_back(parseExternFunctionDeclaration());
+            } else {
+                reportMismatchedInput(
+                    isPublic ? "{'fn', 'var', 'const'}" : "{'pub', 'extern', 'fn', 'var', 'const', '#'}");
+            }
+        } catch (ParseException&) {
+            synchronizeGlobalDeclaration();
+        }
+    }
+
+    return std::make_unique<CompilationUnit>(getSourceSpan(tokens.front(), tokens.back()), std::move(arena),
+        std::move(functionDefinitions), std::move(functionDeclarations), std::move(variableDeclarations));
+}
+
+FunctionDefinition* Parser::parseFunctionDefinition()
+{
+    // functionDefinition: FN IDENTIFIER OPEN_PARENS formalParameters? CLOSE_PARENS type? block
+    size_t start = current;
+    expect(TokenKind::FN);
+
+    auto const& identifier = expect(TokenKind::IDENTIFIER);
+    auto parameters = parseFormalParameters();
+
+    Type* returnType = VoidType::get();
+    SourceSpan returnTypeSourceSpan = SourceSpan::createInvalidSpan();
+    if (canStartType(peek().kind)) {
+        size_t typeStart = current;
+        returnType = parseType();
+        returnTypeSourceSpan = getSourceSpanFrom(typeStart);
+    }
+
+    auto block = parseBlock();
+
+    return arena->create<FunctionDefinition>(getSourceSpanFrom(start), FunctionVisibility::Private,
+        Symbol::get(getText(identifier)), std::move(parameters), returnType, block, returnTypeSourceSpan,
+        getSourceSpan(identifier));
+}
+
+FunctionDeclaration* Parser::parseExternFunctionDeclaration()
+{
+    // externFunDeclaration: EXTERN FN IDENTIFIER OPEN_PARENS formalParameters? CLOSE_PARENS type? SEMICOLON
+    size_t start = current;
+    expect(TokenKind::EXTERN);
+    expect(TokenKind::FN);
+
+    auto const& identifier = expect(TokenKind::IDENTIFIER);
+    auto parameters = parseFormalParameters();
+
+    Type* returnType = VoidType::get();
+    SourceSpan returnTypeSourceSpan = SourceSpan::createInvalidSpan();
+    if (canStartType(peek().kind)) {
+        size_t typeStart = current;
+        returnType = parseType();
+        returnTypeSourceSpan = getSourceSpanFrom(typeStart);
+    }
+
+    expect(TokenKind::SEMICOLON);
+
+    return arena->create<FunctionDeclaration>(getSourceSpanFrom(start), FunctionVisibility::Extern,
+        Symbol::get(getText(identifier)), std::move(parameters), returnType, returnTypeSourceSpan,
+        getSourceSpan(identifier));
+}
+
+std::vector<FunctionParameter> Parser::parseFormalParameters()
+{
+    // OPEN_PARENS (parameter (COMMA parameter)*)? CLOSE_PARENS
+    expect(TokenKind::OPEN_PARENS);
+
+    std::vector<FunctionParameter> parameters;
+    if (consumeIf(TokenKind::CLOSE_PARENS)) {
+        return parameters;
+    }
+
+    do {
+        // parameter: VAR? IDENTIFIER COLON type
+        auto constness = consumeIf(TokenKind::VAR) ? Typing::Constness::NonConst : Typing::Constness::Const;
+        auto const& identifier = expect(TokenKind::IDENTIFIER);
+        expect(TokenKind::COLON);
+
+        size_t typeStart = current;
+        Type* type = parseType();
+
+        parameters.emplace_back(
+            type, Symbol::get(getText(identifier)), constness, getSourceSpanFrom(typeStart), getSourceSpan(identifier));
+    } while (consumeIf(TokenKind::COMMA));
+
+    expect(TokenKind::CLOSE_PARENS);
+    return parameters;
+}
+
+BlockStatement* Parser::parseBlock()
+{
+    // block: OPEN_BRACES statement* CLOSE_BRACES
+    size_t start = current;
+    expect(TokenKind::OPEN_BRACES);
+
+    std::vector<Statement*> statements;
+    while (!check(TokenKind::CLOSE_BRACES) && !check(TokenKind::EndOfFile)) {
+        try {
+            auto statement = parseStatement();
+            // Note: the statement can be a nullptr, for empty statements such as ';;'
+            if (statement != nullptr) {
+                statements.push_back(statement);
+            }
+        } catch (ParseException&) {
+            synchronizeStatement();
+        }
+    }
+
+    expect(TokenKind::CLOSE_BRACES);
+    return arena->create<BlockStatement>(getSourceSpanFrom(start), std::move(statements));
+}
+
+Type* Parser::parseType()
+{
+    auto const& token = peek();
+
+    switch (token.kind) {
+    case TokenKind::IDENTIFIER:
+        consume();
+        Diagnostics::report(getSourceSpan(token), Diag::unknown_type, getText(token).str());
+        return ErrorType::get();
+    case TokenKind::INTEGER_LITERAL_SUFFIX:
+        consume();
+        return PrimitiveIntegerType::get(getText(token).str());
+    case TokenKind::FLOAT_LITERAL_SUFFIX:
+        consume();
+        return PrimitiveFloatType::get(getText(token).str());
+    case TokenKind::BOOL:
+        consume();
+        return BoolType::get();
+    case TokenKind::UNIT_TYPE:
+        // How do we handle VOID in variable definitions? And in parameters? How do we instantiate the void unit type?
+        NOT_IMPLEMENTED();
+        return VoidType::get();
+    case TokenKind::FN: {
+        // FN OPEN_PARENS (type (COMMA type)*)? CLOSE_PARENS type?
+        consume();
+        expect(TokenKind::OPEN_PARENS);
+
+        std::vector<Type*> argumentTypes;
+        if (!check(TokenKind::CLOSE_PARENS)) {
+            do {
+                argumentTypes.push_back(parseType());
+            } while (consumeIf(TokenKind::COMMA));
+        }
+        expect(TokenKind::CLOSE_PARENS);
+
+        Type* returnType = VoidType::get();
+        if (canStartType(peek().kind)) {
+            returnType = parseType();
+        }
+
+        return FunctionType::get(returnType, argumentTypes);
+    }
+    default:
+        reportMismatchedInput("type");
+    }
+}
+
+VariableDeclaration* Parser::parseVariableDeclaration()
+{
+    // varDeclaration: (VAR|CONSTANT) IDENTIFIER (COLON type)? (ASSIGN_OP expression)?
+    size_t start = current;
+
+    Typing::Constness constness;
+    if (consumeIf(TokenKind::VAR)) {
+        constness = Typing::Constness::NonConst;
+    } else if (consumeIf(TokenKind::CONSTANT)) {
+        constness = Typing::Constness::Const;
+    } else {
+        reportMismatchedInput("{'var', 'const'}");
+    }
+
+    auto const& identifier = expect(TokenKind::IDENTIFIER);
+
+    Type* type = NotYetInferredType::get(NotYetInferredKind::VariableDeclaration);
+    SourceSpan typeSourceSpan = SourceSpan::createInvalidSpan();
+    if (consumeIf(TokenKind::COLON)) {
+        size_t typeStart = current;
+        type = parseType();
+        typeSourceSpan = getSourceSpanFrom(typeStart);
+    }
+
+    Expression* initializerExpression = nullptr;
+    if (consumeIf(TokenKind::ASSIGN_OP)) {
+        initializerExpression = parseExpression();
+    }
+
+    return arena->create<VariableDeclaration>(getSourceSpanFrom(start), initializerExpression,
+        Typing::VariableVisibility::Private, constness, VariableScope::Local, type, Symbol::get(getText(identifier)),
+        typeSourceSpan, getSourceSpan(identifier));
+}
+
+Statement* Parser::parseStatement()
+{
+    switch (peek().kind) {
+    case TokenKind::VAR:
+    case TokenKind::CONSTANT: {
+        auto variableDeclaration = parseVariableDeclaration();
+        expect(TokenKind::SEMICOLON);
+        return variableDeclaration;
+    }
+    case TokenKind::RETURN: {
+        auto returnStatement = parseReturnStatement();
+        expect(TokenKind::SEMICOLON);
+        return returnStatement;
+    }
+    case TokenKind::FN:
+        return parseFunctionDefinition();
+    case TokenKind::IF:
+        return parseIfStatement();
+    case TokenKind::WHILE:
+        return parseWhileStatement();
+    case TokenKind::FOR:
+        return parseForStatement();
+    case TokenKind::HASH:
+        return parseAttributedStatement();
+    case TokenKind::OPEN_BRACES:
+        return parseBlock();
+    case TokenKind::SEMICOLON:
+        consume();
+        return nullptr;
+    default: {
+        if (!canStartExpression(peek().kind)) {
+            reportMismatchedInput("statement");
+        }
+
+        size_t start = current;
+        auto expression = parseExpression();
+        expect(TokenKind::SEMICOLON);
+        return arena->create<ExpressionStatement>(getSourceSpanFrom(start), expression);
+    }
+    }
+}
+
+Statement* Parser::parseReturnStatement()
+{
+    // returnStatement: RETURN expression?
+    size_t start = current;
+    expect(TokenKind::RETURN);
+
+    Expression* expression = nullptr;
+    if (canStartExpression(peek().kind)) {
+        expression = parseExpression();
+    }
+
+    return arena->create<ReturnStatement>(getSourceSpanFrom(start), expression);
+}
+
+IfStatement* Parser::parseIfStatement()
+{
+    // ifStatement: IF expression block (ELSE (block | ifStatement))?
+    size_t start = current;
+    expect(TokenKind::IF);
+
+    auto condition = parseExpression();
+    auto thenBlock = parseBlock();
+
+    Statement* elseStatement = nullptr;
+    if (consumeIf(TokenKind::ELSE)) {
+        if (check(TokenKind::IF)) {
+            elseStatement = parseIfStatement();
+        } else if (check(TokenKind::OPEN_BRACES)) {
+            elseStatement = parseBlock();
+        } else {
+            reportMismatchedInput("{'if', '{'}");
+        }
+    }
+
+    return arena->create<IfStatement>(getSourceSpanFrom(start), condition, thenBlock, elseStatement);
+}
+
+WhileStatement* Parser::parseWhileStatement()
+{
+    // whileStatement: WHILE expression block
+    size_t start = current;
+    expect(TokenKind::WHILE);
+
+    auto condition = parseExpression();
+    auto body = parseBlock();
+
+    return arena->create<WhileStatement>(getSourceSpanFrom(start), condition, body);
+}
+
+ForStatement* Parser::parseForStatement()
+{
+    // forStatement: FOR (varDeclaration | expression)? SEMICOLON expression? SEMICOLON expression? block
+    size_t start = current;
+    expect(TokenKind::FOR);
+
+    VariableDeclaration* initDeclaration = nullptr;
+    Expression* initExpression = nullptr;
+    if (check(TokenKind::VAR) || check(TokenKind::CONSTANT)) {
+        initDeclaration = parseVariableDeclaration();
+    } else if (canStartExpression(peek().kind)) {
+        initExpression = parseExpression();
+    }
+    expect(TokenKind::SEMICOLON);
+
+    Expression* conditionExpression = nullptr;
+    if (canStartExpression(peek().kind)) {
+        conditionExpression = parseExpression();
+    }
+    expect(TokenKind::SEMICOLON);
+
+    Expression* updateExpression = nullptr;
+    if (canStartExpression(peek().kind)) {
+        updateExpression = parseExpression();
+    }
+
+    auto body = parseBlock();
+
+    return arena->create<ForStatement>(
+        getSourceSpanFrom(start), initDeclaration, initExpression, conditionExpression, updateExpression, body);
+}
+
+Statement* Parser::parseAttributedStatement()
+{
+    // fn_def_statement: attributes functionDefinition
+    // whileStatement: attributes WHILE expression block
+    // forStatement: attributes FOR (varDeclaration | expression)? SEMICOLON expression? SEMICOLON expression? block
+    size_t start = current;
+    auto attributes = parseAttributes();
+
+    if (check(TokenKind::FN)) {
+        auto functionAttributes = createAttributes<FunctionAttributes>(attributes);
+        auto functionDefinition = parseFunctionDefinition();
+        functionDefinition->attributes = functionAttributes;
+        functionDefinition->sourceSpan = getSourceSpanFrom(start);
+        return functionDefinition;
+    }
+
+    if (!check(TokenKind::WHILE) && !check(TokenKind::FOR)) {
+        reportMismatchedInput("{'fn', 'while', 'for'}");
+    }
+
+    auto hints = createAttributes<LoopHints>(attributes);
+    if (check(TokenKind::WHILE)) {
+        auto whileStatement = parseWhileStatement();
+        whileStatement->hints = hints;
+        whileStatement->sourceSpan = getSourceSpanFrom(start);
+        return whileStatement;
+    }
+
+    auto forStatement = parseForStatement();
+    forStatement->hints = hints;
+    forStatement->sourceSpan = getSourceSpanFrom(start);
+    return forStatement;
+}
+
+std::vector<Parser::Attribute> Parser::parseAttributes()
+{
+    // attributes: HASH OPEN_BRACKETS attribute (COMMA attribute)* CLOSE_BRACKETS
+    expect(TokenKind::HASH);
+    expect(TokenKind::OPEN_BRACKETS);
+
+    std::vector<Attribute> attributes;
+    do {
+        // attribute: IDENTIFIER OPEN_PARENS (DEC_LITERAL | IDENTIFIER) CLOSE_PARENS
+        auto const& name = expect(TokenKind::IDENTIFIER);
+        expect(TokenKind::OPEN_PARENS);
+        if (!check(TokenKind::DEC_LITERAL) && !check(TokenKind::IDENTIFIER)) {
+            reportMismatchedInput("{DEC_LITERAL, IDENTIFIER}");
+        }
+        auto const& argument = consume();
+        expect(TokenKind::CLOSE_PARENS);
+
+        attributes.push_back({ &name, &argument });
+    } while (consumeIf(TokenKind::COMMA));
+
+    expect(TokenKind::CLOSE_BRACKETS);
+    return attributes;
+}
+
+template<class T> T Parser::createAttributes(std::vector<Attribute> const& attributes) const
+{
+    T result;
+    for (auto const& attribute : attributes) {
+        result.add(getText(*attribute.name), getSourceSpan(*attribute.name), getText(*attribute.argument),
+            getSourceSpan(*attribute.argument));
+    }
+    return result;
+}
+
+Expression* Parser::parseExpression()
+{
+    // expression: assignmentExpression (COMMA assignmentExpression)*
+    size_t start = current;
+    auto first = parseAssignmentExpression();
+    if (!check(TokenKind::COMMA)) {
+        return first;
+    }
+
+    std::vector<Expression*> expressions;
+    expressions.push_back(first);
+    while (consumeIf(TokenKind::COMMA)) {
+        expressions.push_back(parseAssignmentExpression());
+    }
+
+    return arena->create<CommaExpression>(getSourceSpanFrom(start), std::move(expressions));
+}
+
+Expression* Parser::parseAssignmentExpression(Precedence minPrecedence)
+{
+    // Note: The span of an operation starts where its leftmost operand starts, which is where this call started
+    size_t start = current;
+    auto expression = parseUnaryExpression();
+
+    while (true) {
+        auto const& token = peek();
+
+        // Postfix operators bind the tightest, so they always apply
+        if (token.kind == TokenKind::UNARY_PLUS_PLUS_OP || token.kind == TokenKind::UNARY_MINUS_MINUS_OP) {
+            consume();
+            auto op = token.kind == TokenKind::UNARY_PLUS_PLUS_OP ? PostfixOp::PostfixIncrement
+                                                                  : PostfixOp::PostfixDecrement;
+            expression
+                = arena->create<PostfixExpression>(getSourceSpanFrom(start), op, expression, getSourceSpan(token));
+            continue;
+        }
+
+        auto binaryOperator = getBinaryOperator(token.kind, peek(1).kind);
+        if (!binaryOperator.has_value() || binaryOperator->precedence < minPrecedence) {
+            break;
+        }
+
+        auto const& firstOperatorToken = consume();
+        auto const& lastOperatorToken = binaryOperator->numTokens == 2 ? consume() : firstOperatorToken;
+        auto operatorSourceSpan = getSourceSpan(firstOperatorToken, lastOperatorToken);
+
+        if (binaryOperator->isAssignment) {
+            // Assignments are right associative
+            auto rhs = parseAssignmentExpression(binaryOperator->precedence);
+            expression = arena->create<AssignmentExpression>(
+                getSourceSpanFrom(start), binaryOperator->operation, expression, rhs, operatorSourceSpan);
+        } else {
+            auto rhs = parseAssignmentExpression((Precedence)((int)binaryOperator->precedence + 1));
+            expression = arena->create<BinaryOperationExpression>(
+                getSourceSpanFrom(start), expression, rhs, *binaryOperator->operation, operatorSourceSpan);
+        }
+    }
+
+    return expression;
+}
+
+Expression* Parser::parseUnaryExpression()
+{
+    size_t start = current;
+    auto const& token = peek();
+
+    switch (token.kind) {
+    case TokenKind::PLUS_OP:
+    case TokenKind::MINUS_OP:
+    case TokenKind::UNARY_PLUS_PLUS_OP:
+    case TokenKind::UNARY_MINUS_MINUS_OP:
+    case TokenKind::BITWISE_NOT:
+    case TokenKind::LOGICAL_NOT: {
+        consume();
+
+        PrefixOp op;
+        switch (token.kind) {
+        case TokenKind::PLUS_OP:
+            op = PrefixOp::UnaryPlus;
+            break;
+        case TokenKind::MINUS_OP:
+            op = PrefixOp::UnaryMinus;
+            break;
+        case TokenKind::UNARY_PLUS_PLUS_OP:
+            op = PrefixOp::PrefixIncrement;
+            break;
+        case TokenKind::UNARY_MINUS_MINUS_OP:
+            op = PrefixOp::PrefixDecrement;
+            break;
+        case TokenKind::BITWISE_NOT:
+            op = PrefixOp::UnaryBitwiseNot;
+            break;
+        default:
+            op = PrefixOp::UnaryLogicalNot;
+            break;
+        }
+
+        auto operand = parseAssignmentExpression(Precedence::Prefix);
+        return arena->create<PrefixExpression>(getSourceSpanFrom(start), op, operand, getSourceSpan(token));
+    }
+    case TokenKind::CAST: {
+        // CAST '<' type '>' OPEN_PARENS expression CLOSE_PARENS
+        consume();
+        expect(TokenKind::LOWER_OP);
+        Type* destinationType = parseType();
+        expect(TokenKind::GREATER_OP);
+        expect(TokenKind::OPEN_PARENS);
+        auto expression = parseExpression();
+        expect(TokenKind::CLOSE_PARENS);
+
+        return arena->create<CastExpression>(getSourceSpanFrom(start), expression, destinationType);
+    }
+    case TokenKind::IDENTIFIER:
+        if (check(TokenKind::OPEN_PARENS, 1)) {
+            return parseFunctionCall();
+        }
+        consume();
+        return arena->create<IdentifierExpression>(getSourceSpan(token), Symbol::get(getText(token)));
+    case TokenKind::OPEN_PARENS: {
+        // Note: The parentheses are not part of the span of the expression
+        consume();
+        auto expression = parseExpression();
+        expect(TokenKind::CLOSE_PARENS);
+        return expression;
+    }
+    case TokenKind::DEC_LITERAL:
+        if (check(TokenKind::FLOAT_LITERAL_SUFFIX, 1)) {
+            return parseFloatLiteral();
+        }
+        return parseIntLiteral();
+    case TokenKind::HEX_LITERAL:
+    case TokenKind::OCT_LITERAL:
+    case TokenKind::BIN_LITERAL:
+        return parseIntLiteral();
+    case TokenKind::FLOAT_LITERAL:
+    case TokenKind::HEX_FLOAT_LITERAL:
+        return parseFloatLiteral();
+    case TokenKind::BOOL_LITERAL: {
+        consume();
+        auto value = getText(token) == "true" ? BoolLiteralValue::True : BoolLiteralValue::False;
+        return arena->create<BoolLiteralExpression>(getSourceSpan(token), value);
+    }
+    default:
+        reportMismatchedInput("expression");
+    }
+}
+
+Expression* Parser::parseFunctionCall()
+{
+    // functionCall: IDENTIFIER OPEN_PARENS (assignmentExpression (COMMA assignmentExpression)*)? CLOSE_PARENS
+    size_t start = current;
+    auto const& identifier = expect(TokenKind::IDENTIFIER);
+    expect(TokenKind::OPEN_PARENS);
+
+    std::vector<Expression*> arguments;
+    if (!check(TokenKind::CLOSE_PARENS)) {
+        do {
+            arguments.push_back(parseAssignmentExpression());
+        } while (consumeIf(TokenKind::COMMA));
+    }
+    expect(TokenKind::CLOSE_PARENS);
+
+    auto* identifierExpression
+        = arena->create<IdentifierExpression>(getSourceSpan(identifier), Symbol::get(getText(identifier)));
+    return arena->create<FunctionCallExpression>(getSourceSpanFrom(start), identifierExpression, std::move(arguments));
+}
+
+Expression* Parser::parseIntLiteral()
+{
+    // intLiteral: (DEC_LITERAL | HEX_LITERAL | OCT_LITERAL | BIN_LITERAL) INTEGER_LITERAL_SUFFIX?
+    size_t start = current;
+    auto const& literal = consume();
+
+    IntLiteralBase base;
+    auto text = getText(literal);
+    switch (literal.kind) {
+    case TokenKind::DEC_LITERAL:
+        base = IntLiteralBase::Dec;
+        break;
+    case TokenKind::HEX_LITERAL:
+        base = IntLiteralBase::Hex;
+        text = text.drop_front(2);
+        break;
+    case TokenKind::OCT_LITERAL:
+        base = IntLiteralBase::Oct;
+        text = text.drop_front(2);
+        break;
+    case TokenKind::BIN_LITERAL:
+        base = IntLiteralBase::Bin;
+        text = text.drop_front(2);
+        break;
+    default:
+        NOT_IMPLEMENTED();
+    }
+
+    Type* type = NotYetInferredType::get(NotYetInferredKind::IntegerLiteral);
+    if (check(TokenKind::INTEGER_LITERAL_SUFFIX)) {
+        type = PrimitiveIntegerType::get(getText(consume()).str());
+    }
+
+    return arena->create<IntLiteralExpression>(getSourceSpanFrom(start), base, type, text.str());
+}
+
+Expression* Parser::parseFloatLiteral()
+{
+    // floatLiteral: FLOAT_LITERAL FLOAT_LITERAL_SUFFIX? | DEC_LITERAL FLOAT_LITERAL_SUFFIX
+    //             | HEX_FLOAT_LITERAL FLOAT_LITERAL_SUFFIX?
+    size_t start = current;
+    auto const& literal = consume();
+
+    FloatLiteralBase base;
+    auto text = getText(literal);
+    switch (literal.kind) {
+    case TokenKind::FLOAT_LITERAL:
+    case TokenKind::DEC_LITERAL:
+        base = FloatLiteralBase::Dec;
+        break;
+    case TokenKind::HEX_FLOAT_LITERAL:
+        base = FloatLiteralBase::Hex;
+        text = text.drop_front(2);
+        break;
+    default:
+        NOT_IMPLEMENTED();
+    }
+
+    Type* type = NotYetInferredType::get(NotYetInferredKind::FloatLiteral);
+    if (check(TokenKind::FLOAT_LITERAL_SUFFIX)) {
+        type = PrimitiveFloatType::get(getText(consume()).str());
+    }
+
+    return arena->create<FloatLiteralExpression>(getSourceSpanFrom(start), base, type, text.str());
+}
+
+} // namespace Ceres::Parser
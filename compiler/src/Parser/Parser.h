@@ -0,0 +1,121 @@
+#ifndef COMPILER_PARSER_H
+#define COMPILER_PARSER_H
+
+#include "../AST/ASTArena.h"
+#include "../AST/FunctionAttributes.h"
+#include "../AST/FunctionParameter.h"
+#include "../AST/LoopHints.h"
+#include "../AST/nodes/CompilationUnit.h"
+#include "../Lexer/Lexer.h"
+#include "../utils/SourceSpan.h"
+#include <llvm/ADT/StringRef.h>
+#include <memory>
+#include <vector>
+
+namespace Ceres::AST {
+class BlockStatement;
+class Expression;
+class ForStatement;
+class FunctionDeclaration;
+class FunctionDefinition;
+class IfStatement;
+class Statement;
+class VariableDeclaration;
+class WhileStatement;
+} // namespace Ceres::AST
+
+namespace Ceres::Parser {
+
+// Binding power of the operators of assignmentExpression, from the loosest to the tightest. The order is the inverse of
+// the order of the alternatives in syntax/CeresParser.g4
+enum class Precedence {
+    Assignment,
+    LogicalOr,
+    LogicalAnd,
+    Equality,
+    BitwiseOr,
+    BitwiseXor,
+    BitwiseAnd,
+    Relational,
+    Shift,
+    Additive,
+    Multiplicative,
+    Prefix,
+    Postfix
+};
+
+// Recursive descent parser that builds the AST directly from the tokens of the hand-written lexer. It accepts the
+// same language as syntax/CeresParser.g4, and the AST nodes get the same source spans as the ones built by
+// AntlrASTGeneratorVisitor. Expressions are parsed with precedence climbing.
+// On a syntax error, the error is reported and the enclosing statement or global declaration is dropped from the AST
+class Parser {
+    std::vector<Lexer::Token> const& tokens;
+    llvm::StringRef source;
+    // Global offset of the source, added to the token offsets to build the source spans
+    uint32_t fileStartOffset;
+
+    // Index of the next token to consume
+    size_t current = 0;
+
+    // Arena in which the nodes are allocated, moved to the CompilationUnit once it is built
+    std::unique_ptr<AST::ASTArena> arena;
+
+    Lexer::Token const& peek(size_t lookahead = 0) const;
+    bool check(Lexer::TokenKind kind, size_t lookahead = 0) const;
+    Lexer::Token const& consume();
+    bool consumeIf(Lexer::TokenKind kind);
+    Lexer::Token const& expect(Lexer::TokenKind kind);
+
+    [[noreturn]] void reportMismatchedInput(llvm::StringRef expected);
+
+    // Skip tokens until a point where parsing can resume after an error
+    void synchronizeStatement();
+    void synchronizeGlobalDeclaration();
+
+    llvm::StringRef getText(Lexer::Token const& token) const;
+    SourceSpan getSourceSpan(Lexer::Token const& token) const;
+    SourceSpan getSourceSpan(Lexer::Token const& first, Lexer::Token const& last) const;
+    // Span from the token at the given index to the last consumed token
+    SourceSpan getSourceSpanFrom(size_t firstTokenIndex) const;
+
+    AST::FunctionDefinition* parseFunctionDefinition();
+    AST::FunctionDeclaration* parseExternFunctionDeclaration();
+    std::vector<AST::FunctionParameter> parseFormalParameters();
+    AST::BlockStatement* parseBlock();
+    Type* parseType();
+    AST::VariableDeclaration* parseVariableDeclaration();
+
+    AST::Statement* parseStatement();
+    AST::Statement* parseReturnStatement();
+    AST::IfStatement* parseIfStatement();
+    AST::WhileStatement* parseWhileStatement();
+    AST::ForStatement* parseForStatement();
+    // A function definition, while or for statement preceded by attributes
+    AST::Statement* parseAttributedStatement();
+
+    // Attribute `name(argument)`, before knowing whether it belongs to a function or to a loop
+    struct Attribute {
+        Lexer::Token const* name;
+        Lexer::Token const* argument;
+    };
+    std::vector<Attribute> parseAttributes();
+    // Builds the AST::FunctionAttributes or AST::LoopHints, which reports the invalid attributes
+    template<class T> T createAttributes(std::vector<Attribute> const& attributes) const;
+
+    AST::Expression* parseExpression();
+    AST::Expression* parseAssignmentExpression(Precedence minPrecedence = Precedence::Assignment);
+    AST::Expression* parseUnaryExpression();
+    AST::Expression* parseFunctionCall();
+    AST::Expression* parseIntLiteral();
+    AST::Expression* parseFloatLiteral();
+
+public:
+    // Note: The last token must be EndOfFile
+    Parser(std::vector<Lexer::Token> const& tokens, llvm::StringRef source, unsigned fileId);
+
+    std::unique_ptr<AST::CompilationUnit> parseCompilationUnit();
+};
+
+} // namespace Ceres::Parser
+
+#endif // COMPILER_PARSER_H
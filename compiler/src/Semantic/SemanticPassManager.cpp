@@ -0,0 +1,212 @@
+#include "SemanticPassManager.h"
+#include "../Binding/BindingVisitor.h"
+#include "../Flow/FlowCheckVisitor.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "../Typing/ConstantEvaluationVisitor.h"
+#include "../Typing/TypeCheckVisitor.h"
+#include "../utils/log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ThreadPool.h>
+#include <vector>
+
+namespace Ceres::Semantic {
+
+static constexpr uint32_t functionsAndGlobals
+    = nodeKindMask(AST::NodeKind::FunctionDefinition) | nodeKindMask(AST::NodeKind::VariableDeclaration);
+
+static constexpr std::array<PassInfo, numPasses> passInfos = { {
+    { PassId::Binding, "binding", "Binding", 0, functionsAndGlobals },
+    { PassId::TypeCheck, "typecheck", "Type checking", passMask(PassId::Binding), functionsAndGlobals },
+    // Only looks at the statements and the declared return type, so it doesn't need the other passes
+    { PassId::FlowCheck, "flowcheck", "Flow checking", 0, nodeKindMask(AST::NodeKind::FunctionDefinition) },
+    { PassId::ConstantEvaluation, "consteval", "Constant evaluation", passMask(PassId::TypeCheck),
+        functionsAndGlobals },
+} };
+
+PassInfo const& getPassInfo(PassId pass)
+{
+    auto const& info = passInfos[static_cast<size_t>(pass)];
+    ASSERT(info.id == pass);
+    return info;
+}
+
+std::optional<PassId> getPassByName(llvm::StringRef name)
+{
+    for (auto const& info : passInfos) {
+        if (name == info.name) {
+            return info.id;
+        }
+    }
+    return {};
+}
+
+SemanticPassManager::SemanticPassManager(llvm::TimerGroup* timerGroup)
+{
+    enabledPasses.fill(true);
+
+    if (timerGroup != nullptr) {
+        for (auto const& info : passInfos) {
+            timers[static_cast<size_t>(info.id)]
+                = std::make_unique<llvm::Timer>(info.name, info.description, *timerGroup);
+        }
+        parallelTimer = std::make_unique<llvm::Timer>(
+            "semantic-parallel", "Semantic passes of the functions, in parallel", *timerGroup);
+    }
+}
+
+void SemanticPassManager::setEnabled(PassId pass, bool enabled) { enabledPasses[static_cast<size_t>(pass)] = enabled; }
+
+bool SemanticPassManager::isEnabled(PassId pass) const
+{
+    if (!enabledPasses[static_cast<size_t>(pass)]) {
+        return false;
+    }
+
+    for (auto const& info : passInfos) {
+        if ((getPassInfo(pass).dependencies & passMask(info.id)) != 0) {
+            // Dependencies always come first, so this doesn't recurse forever
+            ASSERT(info.id < pass);
+            if (!isEnabled(info.id)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Runs the passes on the declarations of one thread
+class PassRunner {
+    SemanticPassManager const& manager;
+    std::optional<Binding::BindingVisitor> bindingVisitor;
+    Typing::TypeCheckVisitor typeCheckVisitor;
+    Typing::FlowCheckVisitor flowCheckVisitor;
+    Typing::ConstantEvaluationVisitor constantEvaluationVisitor;
+
+    void runPass(PassId pass, AST::Node& declaration)
+    {
+        switch (pass) {
+        case PassId::Binding:
+            if (auto* def = llvm::dyn_cast<AST::FunctionDefinition>(&declaration)) {
+                bindingVisitor->bindFunctionBody(*def);
+            } else {
+                bindingVisitor->bindGlobalVariable(llvm::cast<AST::VariableDeclaration>(declaration));
+            }
+            return;
+        case PassId::TypeCheck:
+            typeCheckVisitor.visit(declaration);
+            return;
+        case PassId::FlowCheck:
+            flowCheckVisitor.visit(declaration);
+            return;
+        case PassId::ConstantEvaluation:
+            constantEvaluationVisitor.visit(declaration);
+            return;
+        }
+        ASSERT_NOT_REACHED();
+    }
+
+public:
+    // globals is null if binding is disabled
+    PassRunner(SemanticPassManager const& manager, Binding::SymbolTable const* globals)
+        : manager(manager)
+        , constantEvaluationVisitor(manager.getDefaultOverflowMode())
+    {
+        if (globals != nullptr) {
+            bindingVisitor.emplace(*globals);
+        }
+    }
+
+    // Runs every enabled pass on all the declarations, which have the same kind, before running the next one. If
+    // timers is not null, the time of each pass is added to its timer
+    template<class T>
+    void runBatch(
+        llvm::ArrayRef<T*> declarations, std::array<std::unique_ptr<llvm::Timer>, numPasses> const* timers = nullptr)
+    {
+        ASSERT(!declarations.empty());
+
+        for (auto const& info : passInfos) {
+            if (!manager.isEnabled(info.id) || (info.nodeKinds & nodeKindMask(declarations.front()->getKind())) == 0) {
+                continue;
+            }
+
+            llvm::TimeRegion region(timers != nullptr ? (*timers)[static_cast<size_t>(info.id)].get() : nullptr);
+            for (auto* declaration : declarations) {
+                runPass(info.id, *declaration);
+            }
+        }
+    }
+};
+
+void SemanticPassManager::run(AST::CompilationUnit& unit)
+{
+    // Note: Each file is a separate translation unit, which uses the functions of the other ones through their extern
+    // declarations, so only the global declarations of this unit are visible in it
+    Binding::SymbolTable const* globals = nullptr;
+    if (isEnabled(PassId::Binding)) {
+        llvm::TimeRegion region(timers[static_cast<size_t>(PassId::Binding)].get());
+        unit.scope.emplace();
+        Binding::collectGlobalDeclarations(unit, unit.scope.value());
+        globals = &unit.scope.value();
+    }
+
+    // Same order as the children of the unit. Function declarations have no body, so there is nothing to check on them
+    if (threadPool != nullptr && unit.functionDefinitions.size() > batchSize) {
+        runInParallel(unit.functionDefinitions, globals);
+    } else {
+        PassRunner runner(*this, globals);
+        llvm::ArrayRef<AST::FunctionDefinition*> functions = unit.functionDefinitions;
+        for (size_t begin = 0; begin < functions.size() && !Diagnostics::hasReachedErrorLimit(); begin += batchSize) {
+            runner.runBatch(functions.slice(begin, std::min(batchSize, functions.size() - begin)), &timers);
+        }
+    }
+
+    // Note: The global variables are checked after the functions, and on a single thread, like in the serial path
+    PassRunner runner(*this, globals);
+    llvm::ArrayRef<AST::VariableDeclaration*> variables = unit.globalVariableDeclarations;
+    for (size_t begin = 0; begin < variables.size() && !Diagnostics::hasReachedErrorLimit(); begin += batchSize) {
+        runner.runBatch(variables.slice(begin, std::min(batchSize, variables.size() - begin)), &timers);
+    }
+}
+
+void SemanticPassManager::runInParallel(
+    llvm::ArrayRef<AST::FunctionDefinition*> functions, Binding::SymbolTable const* globals)
+{
+    ASSERT(threadPool != nullptr);
+    llvm::TimeRegion region(parallelTimer.get());
+
+    auto numBatches = (functions.size() + batchSize - 1) / batchSize;
+    std::atomic<size_t> nextBatch = 0;
+
+    // Instead of having a task per batch, each thread takes the next unchecked batch whenever it finishes one, so all
+    // of them are kept busy even if the functions have very different sizes. The diagnostics of every thread go to the
+    // same buffer as the ones of the caller, which prints them sorted by location, in the same order as when checking
+    // on a single thread. The error limit is checked before taking a batch, and a batch taken is always checked, so the
+    // batches checked are the first ones, like on a single thread, and the errors printed are the same
+    auto* capture = Diagnostics::getCurrentCapture();
+    auto checkBatches = [&]() {
+        DiagnosticsRedirect redirect(capture);
+        PassRunner runner(*this, globals);
+        while (!Diagnostics::hasReachedErrorLimit()) {
+            auto batch = nextBatch++;
+            if (batch >= numBatches) {
+                break;
+            }
+            auto begin = batch * batchSize;
+            runner.runBatch(functions.slice(begin, std::min(batchSize, functions.size() - begin)));
+        }
+    };
+
+    std::vector<std::shared_future<void>> workers;
+    for (unsigned i = 0; i < threadPool->getThreadCount(); i++) {
+        workers.push_back(threadPool->async(checkBatches));
+    }
+    checkBatches();
+
+    for (auto& worker : workers) {
+        worker.wait();
+    }
+}
+
+} // namespace Ceres::Semantic
@@ -0,0 +1,95 @@
+#ifndef COMPILER_SEMANTICPASSMANAGER_H
+#define COMPILER_SEMANTICPASSMANAGER_H
+
+#include "../AST/FunctionAttributes.h"
+#include "../AST/nodes/CompilationUnit.h"
+#include "../AST/nodes/Node.h"
+#include <array>
+#include <cstdint>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Timer.h>
+#include <memory>
+#include <optional>
+
+namespace llvm {
+class ThreadPool;
+}
+
+namespace Ceres::Binding {
+class SymbolTable;
+}
+
+namespace Ceres::Semantic {
+
+// Semantic passes, ordered so that every pass comes after the ones it depends on
+enum class PassId : uint8_t {
+    Binding,
+    TypeCheck,
+    FlowCheck,
+    ConstantEvaluation,
+};
+
+constexpr size_t numPasses = 4;
+
+constexpr uint32_t passMask(PassId pass) { return 1U << static_cast<unsigned>(pass); }
+constexpr uint32_t nodeKindMask(AST::NodeKind kind) { return 1U << static_cast<unsigned>(kind); }
+
+struct PassInfo {
+    PassId id;
+    // Name of the pass, used for -disable-semantic-pass and for the time report
+    char const* name;
+    char const* description;
+    // Mask of the passes that must have run on a declaration before this one runs on it
+    uint32_t dependencies;
+    // Mask of the kinds of top-level declarations the pass runs on
+    uint32_t nodeKinds;
+};
+
+PassInfo const& getPassInfo(PassId pass);
+std::optional<PassId> getPassByName(llvm::StringRef name);
+
+// Runs the semantic passes on a compilation unit. All of the passes work on one top-level declaration at a time, and
+// only depend on the global declarations of the unit besides that, so instead of walking the whole tree once per pass
+// they are fused: every enabled pass runs on a small batch of declarations before moving on to the next batch, while
+// the nodes of the batch are still in the cache. Since the batches of functions are independent of each other, they can
+// also be checked in parallel
+class SemanticPassManager {
+private:
+    std::array<bool, numPasses> enabledPasses;
+    std::array<std::unique_ptr<llvm::Timer>, numPasses> timers;
+    // The passes of different batches overlap when running in parallel, so they can't be timed separately
+    std::unique_ptr<llvm::Timer> parallelTimer;
+
+    llvm::ThreadPool* threadPool = nullptr;
+    AST::OverflowMode defaultOverflowMode = AST::OverflowMode::Wrap;
+
+    // Number of declarations in each batch. A batch of a single declaration keeps the most locality, but then the
+    // per-pass timers would have to be started and stopped around every declaration, which costs as much as binding
+    // a small function
+    static constexpr size_t batchSize = 16;
+
+    void runInParallel(llvm::ArrayRef<AST::FunctionDefinition*> functions, Binding::SymbolTable const* globals);
+
+public:
+    // If timerGroup is not null, each pass gets a timer in it
+    explicit SemanticPassManager(llvm::TimerGroup* timerGroup = nullptr);
+
+    // Disabling a pass also disables the passes that depend on it
+    void setEnabled(PassId pass, bool enabled);
+    bool isEnabled(PassId pass) const;
+
+    // Checks the functions on the threads of the pool, besides the calling one. The diagnostics are reported to the
+    // buffer of the caller. The pool must not be the one running the caller
+    void setThreadPool(llvm::ThreadPool* pool) { threadPool = pool; }
+
+    // Overflow mode given with -foverflow, which constant evaluation folds with in the functions without an attribute
+    void setDefaultOverflowMode(AST::OverflowMode mode) { defaultOverflowMode = mode; }
+    AST::OverflowMode getDefaultOverflowMode() const { return defaultOverflowMode; }
+
+    void run(AST::CompilationUnit& unit);
+};
+
+} // namespace Ceres::Semantic
+
+#endif // COMPILER_SEMANTICPASSMANAGER_H
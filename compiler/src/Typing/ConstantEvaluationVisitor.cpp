@@ -0,0 +1,325 @@
+#include "ConstantEvaluationVisitor.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "Type.h"
+#include <llvm/ADT/APSInt.h>
+#include <llvm/Support/Casting.h>
+
+namespace Ceres::Typing {
+
+static llvm::fltSemantics const& getFloatSemantics(PrimitiveFloatType const* type)
+{
+    switch (type->kind) {
+    case PrimitiveFloatKind::F32:
+        return llvm::APFloat::IEEEsingle();
+    case PrimitiveFloatKind::F64:
+        return llvm::APFloat::IEEEdouble();
+    default:
+        NOT_IMPLEMENTED();
+    }
+}
+
+void ConstantEvaluationVisitor::visitFunctionDefinition(AST::FunctionDefinition& def)
+{
+    // Nested functions don't inherit the attributes of the enclosing one
+    auto oldOverflowMode = overflowMode;
+    overflowMode = def.attributes.overflowMode.value_or(defaultOverflowMode);
+    visitChildren(def);
+    overflowMode = oldOverflowMode;
+}
+
+void ConstantEvaluationVisitor::visitBinaryOperationExpression(AST::BinaryOperationExpression& expr)
+{
+    visit(*expr.left);
+    visit(*expr.right);
+
+    auto const& left = expr.left->constantValue;
+    auto const& right = expr.right->constantValue;
+    if (!left.has_value() || llvm::isa<ErrorType>(expr.type)) {
+        return;
+    }
+
+    // The right side of && and || is not evaluated when the left one decides the result, so it doesn't matter whether
+    // it's constant
+    if (expr.op.kind == BinaryOperation::LogicalAnd || expr.op.kind == BinaryOperation::LogicalOr) {
+        bool leftValue = std::get<llvm::APInt>(*left).getBoolValue();
+        if (leftValue == (expr.op.kind == BinaryOperation::LogicalOr)) {
+            expr.constantValue = llvm::APInt(1, leftValue);
+            return;
+        }
+    }
+
+    if (!right.has_value()) {
+        return;
+    }
+
+    if (llvm::isa<PrimitiveFloatType>(expr.left->type)) {
+        expr.constantValue
+            = foldFloatOperation(expr.op, std::get<llvm::APFloat>(*left), std::get<llvm::APFloat>(*right));
+        return;
+    }
+
+    auto const& leftInt = std::get<llvm::APInt>(*left);
+    auto const& rightInt = std::get<llvm::APInt>(*right);
+    auto result = llvm::isa<BoolType>(expr.left->type)
+        ? foldBoolOperation(expr.op, leftInt.getBoolValue(), rightInt.getBoolValue())
+        : foldIntegerOperation(expr.op, leftInt, rightInt, expr);
+    if (result.has_value()) {
+        expr.constantValue = std::move(*result);
+    }
+}
+
+std::optional<llvm::APInt> ConstantEvaluationVisitor::foldIntegerOperation(
+    BinaryOperation op, llvm::APInt const& left, llvm::APInt const& right, AST::BinaryOperationExpression& expr)
+{
+    auto* type = llvm::cast<PrimitiveIntegerType>(expr.left->type);
+    bool isSigned = type->isSigned();
+    bool overflow = false;
+
+    switch (op.kind) {
+    case BinaryOperation::Sum: {
+        auto result = isSigned ? left.sadd_ov(right, overflow) : left.uadd_ov(right, overflow);
+        return overflow ? handleOverflow(result, expr) : result;
+    }
+    case BinaryOperation::Subtraction: {
+        auto result = isSigned ? left.ssub_ov(right, overflow) : left.usub_ov(right, overflow);
+        return overflow ? handleOverflow(result, expr) : result;
+    }
+    case BinaryOperation::Mult: {
+        auto result = isSigned ? left.smul_ov(right, overflow) : left.umul_ov(right, overflow);
+        return overflow ? handleOverflow(result, expr) : result;
+    }
+    case BinaryOperation::Div:
+    case BinaryOperation::Modulo: {
+        if (right.isZero()) {
+            Diagnostics::report(expr.sourceSpan, Diag::constant_division_by_zero);
+            return {};
+        }
+        if (!isSigned) {
+            return op.kind == BinaryOperation::Div ? left.udiv(right) : left.urem(right);
+        }
+
+        // Note: MIN / -1 and MIN % -1 are never folded, they trap with -foverflow=trap and are undefined otherwise
+        auto quotient = left.sdiv_ov(right, overflow);
+        if (overflow) {
+            Diagnostics::report(expr.sourceSpan, Diag::constant_overflow, type->toString());
+            return {};
+        }
+        return op.kind == BinaryOperation::Div ? quotient : left.srem(right);
+    }
+    case BinaryOperation::BitwiseAnd:
+        return left & right;
+    case BinaryOperation::BitwiseOr:
+        return left | right;
+    case BinaryOperation::BitwiseXor:
+        return left ^ right;
+    case BinaryOperation::Equals:
+        return llvm::APInt(1, left == right);
+    case BinaryOperation::NotEquals:
+        return llvm::APInt(1, left != right);
+    case BinaryOperation::LessOrEqual:
+        return llvm::APInt(1, isSigned ? left.sle(right) : left.ule(right));
+    case BinaryOperation::GreaterOrEqual:
+        return llvm::APInt(1, isSigned ? left.sge(right) : left.uge(right));
+    case BinaryOperation::GreaterThan:
+        return llvm::APInt(1, isSigned ? left.sgt(right) : left.ugt(right));
+    case BinaryOperation::LessThan:
+        return llvm::APInt(1, isSigned ? left.slt(right) : left.ult(right));
+    default:
+        // TODO: Fold the shifts once their semantics for signed integers and out of range amounts are decided
+        return {};
+    }
+}
+
+std::optional<llvm::APInt> ConstantEvaluationVisitor::handleOverflow(llvm::APInt const& wrapped, AST::Expression& expr)
+{
+    if (overflowMode == AST::OverflowMode::Wrap) {
+        return wrapped;
+    }
+
+    // Note: Folding it would change the behavior with -foverflow=trap
+    Diagnostics::report(expr.sourceSpan, Diag::constant_overflow, expr.type->toString());
+    return {};
+}
+
+std::optional<llvm::APInt> ConstantEvaluationVisitor::foldBoolOperation(BinaryOperation op, bool left, bool right)
+{
+    switch (op.kind) {
+    case BinaryOperation::Equals:
+        return llvm::APInt(1, left == right);
+    case BinaryOperation::NotEquals:
+        return llvm::APInt(1, left != right);
+    case BinaryOperation::LogicalAnd:
+        return llvm::APInt(1, left && right);
+    case BinaryOperation::LogicalOr:
+        return llvm::APInt(1, left || right);
+    default:
+        return {};
+    }
+}
+
+std::optional<AST::ConstantValue> ConstantEvaluationVisitor::foldFloatOperation(
+    BinaryOperation op, llvm::APFloat const& left, llvm::APFloat const& right)
+{
+    // Note: The results are the ones of IEEE 754, which fast-math also allows, so the folding doesn't depend on it
+    auto rounding = llvm::APFloat::rmNearestTiesToEven;
+    llvm::APFloat result = left;
+    auto comparison = left.compare(right);
+
+    // The comparisons are ordered, as in codegen: they are false if any of the operands is NaN
+    switch (op.kind) {
+    case BinaryOperation::Sum:
+        result.add(right, rounding);
+        return result;
+    case BinaryOperation::Subtraction:
+        result.subtract(right, rounding);
+        return result;
+    case BinaryOperation::Mult:
+        result.multiply(right, rounding);
+        return result;
+    case BinaryOperation::Div:
+        result.divide(right, rounding);
+        return result;
+    case BinaryOperation::Modulo:
+        result.mod(right);
+        return result;
+    case BinaryOperation::Equals:
+        return llvm::APInt(1, comparison == llvm::APFloat::cmpEqual);
+    case BinaryOperation::NotEquals:
+        return llvm::APInt(1, comparison == llvm::APFloat::cmpLessThan || comparison == llvm::APFloat::cmpGreaterThan);
+    case BinaryOperation::LessOrEqual:
+        return llvm::APInt(1, comparison == llvm::APFloat::cmpLessThan || comparison == llvm::APFloat::cmpEqual);
+    case BinaryOperation::GreaterOrEqual:
+        return llvm::APInt(1, comparison == llvm::APFloat::cmpGreaterThan || comparison == llvm::APFloat::cmpEqual);
+    case BinaryOperation::GreaterThan:
+        return llvm::APInt(1, comparison == llvm::APFloat::cmpGreaterThan);
+    case BinaryOperation::LessThan:
+        return llvm::APInt(1, comparison == llvm::APFloat::cmpLessThan);
+    default:
+        return {};
+    }
+}
+
+void ConstantEvaluationVisitor::visitBoolLiteralExpression(AST::BoolLiteralExpression& expr)
+{
+    expr.constantValue = llvm::APInt(1, expr.getLiteralBool());
+}
+
+void ConstantEvaluationVisitor::visitCastExpression(AST::CastExpression& expr)
+{
+    visit(*expr.expr);
+    if (!expr.expr->constantValue.has_value()) {
+        return;
+    }
+
+    auto const& value = *expr.expr->constantValue;
+    auto* fromInt = llvm::dyn_cast<PrimitiveIntegerType>(expr.expr->type);
+    auto* fromFloat = llvm::dyn_cast<PrimitiveFloatType>(expr.expr->type);
+
+    if (auto* toInt = llvm::dyn_cast<PrimitiveIntegerType>(expr.destinationType)) {
+        if (fromInt != nullptr) {
+            auto const& intValue = std::get<llvm::APInt>(value);
+            expr.constantValue = fromInt->isSigned() ? intValue.sextOrTrunc(toInt->getNumBits())
+                                                     : intValue.zextOrTrunc(toInt->getNumBits());
+        } else if (fromFloat != nullptr) {
+            // Floats that are out of the range of the integer type are left to run time
+            llvm::APSInt result(toInt->getNumBits(), !toInt->isSigned());
+            bool isExact;
+            auto status
+                = std::get<llvm::APFloat>(value).convertToInteger(result, llvm::APFloat::rmTowardZero, &isExact);
+            if ((status & llvm::APFloat::opInvalidOp) == 0) {
+                expr.constantValue = llvm::APInt(result);
+            }
+        }
+    } else if (auto* toFloat = llvm::dyn_cast<PrimitiveFloatType>(expr.destinationType)) {
+        llvm::APFloat result(getFloatSemantics(toFloat));
+        if (fromInt != nullptr) {
+            result.convertFromAPInt(
+                std::get<llvm::APInt>(value), fromInt->isSigned(), llvm::APFloat::rmNearestTiesToEven);
+            expr.constantValue = result;
+        } else if (fromFloat != nullptr) {
+            result = std::get<llvm::APFloat>(value);
+            bool losesInfo;
+            result.convert(getFloatSemantics(toFloat), llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+            expr.constantValue = result;
+        }
+    }
+}
+
+void ConstantEvaluationVisitor::visitFloatLiteralExpression(AST::FloatLiteralExpression& expr)
+{
+    // TODO: Fold hexadecimal float literals once FloatLiteralExpression can parse them
+    if (llvm::isa<PrimitiveFloatType>(expr.type) && expr.base == AST::FloatLiteralBase::Dec) {
+        expr.constantValue = expr.getLLVMAPFloat();
+    }
+}
+
+void ConstantEvaluationVisitor::visitIdentifierExpression(AST::IdentifierExpression& expr)
+{
+    // Note: Global variables are evaluated after the functions, so only local constants can be folded here
+    if (!expr.decl.has_value() || expr.decl->getKind() != Binding::SymbolDeclarationKind::LocalVariableDeclaration) {
+        return;
+    }
+
+    auto* decl = expr.decl->getVarDecl();
+    if (decl->isCompileTimeConstant()) {
+        expr.constantValue = decl->initializerExpression->constantValue;
+    }
+}
+
+void ConstantEvaluationVisitor::visitIntLiteralExpression(AST::IntLiteralExpression& expr)
+{
+    // Note: The type checker reports the literals that don't fit in their type
+    if (!llvm::isa<PrimitiveIntegerType>(expr.type) || !expr.doesLiteralFitInsideType()) {
+        return;
+    }
+    expr.constantValue = expr.getLLVMAPInt();
+}
+
+void ConstantEvaluationVisitor::visitPrefixExpression(AST::PrefixExpression& expr)
+{
+    visit(*expr.expr);
+
+    if (!expr.expr->constantValue.has_value() || llvm::isa<ErrorType>(expr.type)) {
+        return;
+    }
+    auto const& value = *expr.expr->constantValue;
+
+    switch (expr.op) {
+    case AST::PrefixOp::UnaryPlus:
+        expr.constantValue = value;
+        return;
+    case AST::PrefixOp::UnaryMinus: {
+        if (auto const* floatValue = std::get_if<llvm::APFloat>(&value)) {
+            expr.constantValue = llvm::neg(*floatValue);
+            return;
+        }
+
+        // Same as subtracting from zero. Negating an unsigned integer always wraps, so only signed ones can overflow
+        auto const& intValue = std::get<llvm::APInt>(value);
+        if (!llvm::cast<PrimitiveIntegerType>(expr.type)->isSigned()) {
+            expr.constantValue = -intValue;
+            return;
+        }
+        bool overflow = false;
+        auto result = llvm::APInt::getZero(intValue.getBitWidth()).ssub_ov(intValue, overflow);
+        auto maybeResult = overflow ? handleOverflow(result, expr) : result;
+        if (maybeResult.has_value()) {
+            expr.constantValue = std::move(*maybeResult);
+        }
+        return;
+    }
+    case AST::PrefixOp::UnaryLogicalNot:
+        expr.constantValue = llvm::APInt(1, !std::get<llvm::APInt>(value).getBoolValue());
+        return;
+    case AST::PrefixOp::UnaryBitwiseNot:
+        expr.constantValue = ~std::get<llvm::APInt>(value);
+        return;
+    case AST::PrefixOp::PrefixIncrement:
+    case AST::PrefixOp::PrefixDecrement:
+        // They modify a variable, which can't be const
+        return;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+} // namespace Ceres::Typing
@@ -0,0 +1,50 @@
+#ifndef COMPILER_CONSTANTEVALUATIONVISITOR_H
+#define COMPILER_CONSTANTEVALUATIONVISITOR_H
+
+#include "../AST/StaticASTVisitor.hpp"
+#include "../AST/FunctionAttributes.h"
+#include "BinaryOperation.h"
+#include <optional>
+
+namespace Ceres::Typing {
+
+// Evaluates at compile time the expressions made of literals and const variables, after type checking, and stores
+// their values in Expression::constantValue, so codegen emits them as constants. Operations that overflow are folded to
+// the wrapped value if the overflow mode wraps. Otherwise, and if they divide by zero, they are reported and left to run
+// time, where they behave as the overflow mode of the function says
+class ConstantEvaluationVisitor : public AST::StaticASTVisitor<ConstantEvaluationVisitor> {
+    // Overflow mode given with -foverflow, used in the functions without an overflow attribute
+    AST::OverflowMode defaultOverflowMode;
+    // Overflow mode of the current function
+    AST::OverflowMode overflowMode;
+
+    std::optional<llvm::APInt> foldIntegerOperation(
+        BinaryOperation op, llvm::APInt const& left, llvm::APInt const& right, AST::BinaryOperationExpression& expr);
+    static std::optional<llvm::APInt> foldBoolOperation(BinaryOperation op, bool left, bool right);
+    static std::optional<AST::ConstantValue> foldFloatOperation(
+        BinaryOperation op, llvm::APFloat const& left, llvm::APFloat const& right);
+
+    // Value of an integer operation that overflowed, or none if it has to be left to run time
+    std::optional<llvm::APInt> handleOverflow(llvm::APInt const& wrapped, AST::Expression& expr);
+
+public:
+    explicit ConstantEvaluationVisitor(AST::OverflowMode defaultOverflowMode = AST::OverflowMode::Wrap)
+        : defaultOverflowMode(defaultOverflowMode)
+        , overflowMode(defaultOverflowMode)
+    {
+    }
+
+    void visitFunctionDefinition(AST::FunctionDefinition& def);
+
+    void visitBinaryOperationExpression(AST::BinaryOperationExpression& expr);
+    void visitBoolLiteralExpression(AST::BoolLiteralExpression& expr);
+    void visitCastExpression(AST::CastExpression& expr);
+    void visitFloatLiteralExpression(AST::FloatLiteralExpression& expr);
+    void visitIdentifierExpression(AST::IdentifierExpression& expr);
+    void visitIntLiteralExpression(AST::IntLiteralExpression& expr);
+    void visitPrefixExpression(AST::PrefixExpression& expr);
+};
+
+} // namespace Ceres::Typing
+
+#endif // COMPILER_CONSTANTEVALUATIONVISITOR_H
@@ -1,5 +1,5 @@
 #include "Type.h"
-#include "../utils/InitCeres.h"
+#include "TypeContext.h"
 #include "TypeVisitor.h"
 #include "llvm/IR/DerivedTypes.h"
 #include <cstdint>
@@ -7,31 +7,13 @@
 
 namespace Ceres {
 
-std::unique_ptr<VoidType> VoidType::instance = nullptr;
-std::unordered_map<std::string, std::unique_ptr<UnresolvedType>> UnresolvedType::instances;
-std::unordered_map<NotYetInferredKind, std::unique_ptr<NotYetInferredType>> NotYetInferredType::instances;
-std::unordered_map<PrimitiveIntegerKind, std::unique_ptr<PrimitiveIntegerType>> PrimitiveIntegerType::instances;
-std::unordered_map<PrimitiveFloatKind, std::unique_ptr<PrimitiveFloatType>> PrimitiveFloatType::instances;
-std::unordered_map<std::pair<Type*, std::vector<Type*>>, std::unique_ptr<FunctionType>, FunctionSignatureHash>
-    FunctionType::instances;
-std::unique_ptr<ErrorType> ErrorType::instance = nullptr;
-std::unique_ptr<BoolType> BoolType::instance = nullptr;
-
 std::string VoidType::toString() const { return "void"; }
 
-VoidType* VoidType::get()
-{
-    if (instance != nullptr) {
-        return instance.get();
-    }
-
-    instance.reset(new VoidType);
-    return instance.get();
-}
+VoidType* VoidType::get() { return TypeContext::global().getVoidType(); }
 
 void VoidType::accept(Typing::TypeVisitor& visitor) { visitor.visitUnitVoidType(this); }
 
-llvm::Type* VoidType::doGetLLVMType() const { return llvm::Type::getVoidTy(*InitCeres::getLLVMContext()); }
+llvm::Type* VoidType::doGetLLVMType(llvm::LLVMContext& context) const { return llvm::Type::getVoidTy(context); }
 
 PrimitiveIntegerType::PrimitiveIntegerType(PrimitiveIntegerKind kind)
     : kind(kind)
@@ -94,33 +76,28 @@ PrimitiveIntegerType* PrimitiveIntegerType::get(std::string_view str)
 
 PrimitiveIntegerType* PrimitiveIntegerType::get(PrimitiveIntegerKind kind)
 {
-    auto& ptr = instances[kind];
-    if (ptr == nullptr) {
-        ptr.reset(new PrimitiveIntegerType(kind));
-    }
-    return ptr.get();
+    return TypeContext::global().getPrimitiveIntegerType(kind);
 }
 
 void PrimitiveIntegerType::accept(Typing::TypeVisitor& visitor) { visitor.visitPrimitiveIntegerType(this); }
 
-llvm::Type* PrimitiveIntegerType::doGetLLVMType() const
+llvm::Type* PrimitiveIntegerType::doGetLLVMType(llvm::LLVMContext& context) const
 {
     // Note: LLVM does not have unsigned types, they are represented as signed integers too
 
-    llvm::LLVMContext& ctx = *InitCeres::getLLVMContext();
     switch (kind) {
     case PrimitiveIntegerKind::I8:
     case PrimitiveIntegerKind::U8:
-        return llvm::Type::getInt8Ty(ctx);
+        return llvm::Type::getInt8Ty(context);
     case PrimitiveIntegerKind::U16:
     case PrimitiveIntegerKind::I16:
-        return llvm::Type::getInt16Ty(ctx);
+        return llvm::Type::getInt16Ty(context);
     case PrimitiveIntegerKind::U32:
     case PrimitiveIntegerKind::I32:
-        return llvm::Type::getInt32Ty(ctx);
+        return llvm::Type::getInt32Ty(context);
     case PrimitiveIntegerKind::I64:
     case PrimitiveIntegerKind::U64:
-        return llvm::Type::getInt64Ty(ctx);
+        return llvm::Type::getInt64Ty(context);
     default:
         NOT_IMPLEMENTED();
     }
@@ -180,11 +157,7 @@ std::string NotYetInferredType::toString() const
 
 NotYetInferredType* NotYetInferredType::get(NotYetInferredKind kind)
 {
-    auto& ptr = instances[kind];
-    if (ptr == nullptr) {
-        ptr.reset(new NotYetInferredType(kind));
-    }
-    return ptr.get();
+    return TypeContext::global().getNotYetInferredType(kind);
 }
 
 void NotYetInferredType::accept(Typing::TypeVisitor& visitor) { visitor.visitNotYetInferredType(this); }
@@ -202,7 +175,7 @@ std::optional<Type*> NotYetInferredType::getDefaultType() const
         return {};
     }
 }
-llvm::Type* NotYetInferredType::doGetLLVMType() const { ASSERT_NOT_REACHED(); }
+llvm::Type* NotYetInferredType::doGetLLVMType(llvm::LLVMContext& context) const { ASSERT_NOT_REACHED(); }
 
 UnresolvedType::UnresolvedType(std::string typeIdentifier)
     : typeIdentifier(std::move(typeIdentifier))
@@ -212,35 +185,24 @@ UnresolvedType::UnresolvedType(std::string typeIdentifier)
 
 std::string UnresolvedType::toString() const { return typeIdentifier; }
 
-UnresolvedType* UnresolvedType::get(std::string const& str)
-{
-    auto& ptr = instances[str];
-    if (ptr == nullptr) {
-        ptr.reset(new UnresolvedType(str));
-    }
-    return ptr.get();
-}
+UnresolvedType* UnresolvedType::get(std::string const& str) { return TypeContext::global().getUnresolvedType(str); }
 
 void UnresolvedType::accept(Typing::TypeVisitor& visitor) { visitor.visitUnresolvedType(this); }
 
-llvm::Type* UnresolvedType::doGetLLVMType() const { ASSERT_NOT_REACHED(); }
+llvm::Type* UnresolvedType::doGetLLVMType(llvm::LLVMContext& context) const { ASSERT_NOT_REACHED(); }
 
 void FunctionType::accept(Typing::TypeVisitor& visitor) { visitor.visitFunctionType(this); }
 
-FunctionType::FunctionType(Type* returnType, std::vector<Type*> argumentTypes)
+FunctionType::FunctionType(Type* returnType, llvm::ArrayRef<Type*> argumentTypes)
     : returnType(returnType)
-    , argumentTypes(std::move(argumentTypes))
+    , argumentTypes(argumentTypes)
     , Type(TypeKind::FunctionType)
 {
 }
 
-FunctionType* FunctionType::get(Type* returnType, std::vector<Type*> const& argumentTypes)
+FunctionType* FunctionType::get(Type* returnType, llvm::ArrayRef<Type*> argumentTypes)
 {
-    auto& ptr = instances[std::make_pair(returnType, argumentTypes)];
-    if (ptr == nullptr) {
-        ptr.reset(new FunctionType(returnType, argumentTypes));
-    }
-    return ptr.get();
+    return TypeContext::global().getFunctionType(returnType, argumentTypes);
 }
 
 std::string FunctionType::toString() const
@@ -259,54 +221,23 @@ std::string FunctionType::toString() const
     return fmt::format("fn ({}) {}", arguments, returnType->toString());
 }
 
-llvm::Type* FunctionType::doGetLLVMType() const
+llvm::Type* FunctionType::doGetLLVMType(llvm::LLVMContext& context) const
 {
     std::vector<llvm::Type*> argumentLLVMTypes;
     std::transform(argumentTypes.begin(), argumentTypes.end(), std::back_inserter(argumentLLVMTypes),
-        [](Type* type) { return type->getLLVMType(); });
+        [&](Type* type) { return type->getLLVMType(context); });
 
     // TODO: Update when supporting vararg
-    return llvm::FunctionType::get(returnType->getLLVMType(), argumentLLVMTypes, false);
-}
-
-template<class T> inline void hash_combine(std::size_t& seed, T const& v)
-{
-    std::hash<T> hasher;
-    seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-}
-
-size_t FunctionSignatureHash::operator()(std::pair<Type*, std::vector<Type*>> const& p) const
-{
-    auto const& vec = p.second;
-    Type* t = p.first;
-
-    size_t seed = vec.size();
-    hash_combine(seed, (uintptr_t)t);
-    for (auto ptr : vec) {
-        auto x = (uintptr_t)ptr;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = (x >> 16) ^ x;
-        seed ^= x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    }
-    return seed;
+    return llvm::FunctionType::get(returnType->getLLVMType(context), argumentLLVMTypes, false);
 }
 
 void ErrorType::accept(Typing::TypeVisitor& visitor) { visitor.visitErrorType(this); }
 
-ErrorType* ErrorType::get()
-{
-    if (instance != nullptr) {
-        return instance.get();
-    }
-
-    instance.reset(new ErrorType);
-    return instance.get();
-}
+ErrorType* ErrorType::get() { return TypeContext::global().getErrorType(); }
 
 std::string ErrorType::toString() const { return "<ErrorType>"; }
 
-llvm::Type* ErrorType::doGetLLVMType() const { ASSERT_NOT_REACHED(); }
+llvm::Type* ErrorType::doGetLLVMType(llvm::LLVMContext& context) const { ASSERT_NOT_REACHED(); }
 
 // Return ErrorType if the coercion is not possible
 Type* Type::getImplicitlyCoercedType(Type* a, Type* b)
@@ -369,13 +300,7 @@ Type* Type::getImplicitlyCoercedType(Type* a, Type* b)
     NOT_IMPLEMENTED();
 }
 
-llvm::Type* Type::getLLVMType() const
-{
-    if (llvmType == nullptr) {
-        llvmType = doGetLLVMType();
-    }
-    return llvmType;
-}
+llvm::Type* Type::getLLVMType(llvm::LLVMContext& context) const { return doGetLLVMType(context); }
 
 BoolType::BoolType()
     : Type(TypeKind::Bool)
@@ -384,19 +309,11 @@ BoolType::BoolType()
 
 std::string BoolType::toString() const { return "bool"; }
 
-BoolType* BoolType::get()
-{
-    if (instance != nullptr) {
-        return instance.get();
-    }
-
-    instance.reset(new BoolType);
-    return instance.get();
-}
+BoolType* BoolType::get() { return TypeContext::global().getBoolType(); }
 
 void BoolType::accept(Typing::TypeVisitor& visitor) { visitor.visitBoolType(this); }
 
-llvm::Type* BoolType::doGetLLVMType() const { return llvm::Type::getInt1Ty(*InitCeres::getLLVMContext()); }
+llvm::Type* BoolType::doGetLLVMType(llvm::LLVMContext& context) const { return llvm::Type::getInt1Ty(context); }
 
 PrimitiveFloatType::PrimitiveFloatType(PrimitiveFloatKind kind)
     : Type(TypeKind::PrimitiveFloatType)
@@ -418,11 +335,7 @@ std::string PrimitiveFloatType::toString() const
 }
 PrimitiveFloatType* PrimitiveFloatType::get(PrimitiveFloatKind kind)
 {
-    auto& ptr = instances[kind];
-    if (ptr == nullptr) {
-        ptr.reset(new PrimitiveFloatType(kind));
-    }
-    return ptr.get();
+    return TypeContext::global().getPrimitiveFloatType(kind);
 }
 
 PrimitiveFloatType* PrimitiveFloatType::get(std::string_view str)
@@ -441,14 +354,13 @@ PrimitiveFloatKind PrimitiveFloatType::primitiveFloatKindFromString(std::string_
     }
 }
 
-llvm::Type* PrimitiveFloatType::doGetLLVMType() const
+llvm::Type* PrimitiveFloatType::doGetLLVMType(llvm::LLVMContext& context) const
 {
-    llvm::LLVMContext& ctx = *InitCeres::getLLVMContext();
     switch (kind) {
     case PrimitiveFloatKind::F32:
-        return llvm::Type::getFloatTy(ctx);
+        return llvm::Type::getFloatTy(context);
     case PrimitiveFloatKind::F64:
-        return llvm::Type::getDoubleTy(ctx);
+        return llvm::Type::getDoubleTy(context);
     default:
         NOT_IMPLEMENTED();
     }
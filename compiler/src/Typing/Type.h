@@ -2,12 +2,12 @@
 #define COMPILER_TYPE_H
 
 #include "../utils/log.hpp"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/Casting.h"
 #include <llvm/IR/Type.h>
 #include <optional>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 
 namespace Ceres {
 
@@ -15,9 +15,11 @@ namespace Typing {
 class TypeVisitor;
 }
 
-// Note: Types are cached. There is only a unique instance per type. Types
+class TypeContext;
+
+// Note: Types are interned by TypeContext. There is only a unique instance per type. Types
 // should have a private constructor and have a get() function that performs the
-// cache lookup
+// lookup in the TypeContext
 class Type {
 public:
     /// Discriminator for LLVM-style RTTI (dyn_cast<> et al.)
@@ -41,10 +43,8 @@ public:
 private:
     const TypeKind kind;
 
-    mutable llvm::Type* llvmType = nullptr;
-
 protected:
-    virtual llvm::Type* doGetLLVMType() const = 0;
+    virtual llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const = 0;
 
 public:
     explicit Type(TypeKind kind)
@@ -53,7 +53,9 @@ public:
     }
     [[nodiscard]] TypeKind getKind() const { return kind; }
 
-    [[nodiscard]] llvm::Type* getLLVMType() const;
+    // Note: Types are shared between the threads compiling different files, each one of them with their own LLVM
+    // context, so the LLVM type is not cached here. See LLVMTypeCache
+    [[nodiscard]] llvm::Type* getLLVMType(llvm::LLVMContext& context) const;
 
     virtual void accept(Typing::TypeVisitor& visitor) = 0;
     [[nodiscard]] virtual std::string toString() const = 0;
@@ -64,14 +66,14 @@ public:
 
 class VoidType : public Type {
 private:
-    static std::unique_ptr<VoidType> instance;
+    friend class TypeContext;
     VoidType()
         : Type(TypeKind::UnitVoidType)
     {
     }
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -85,14 +87,14 @@ public:
 
 class ErrorType : public Type {
 private:
-    static std::unique_ptr<ErrorType> instance;
+    friend class TypeContext;
     ErrorType()
         : Type(TypeKind::ErrorType)
     {
     }
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -110,11 +112,11 @@ public:
 //  type.
 class UnresolvedType : public Type {
 private:
-    static std::unordered_map<std::string, std::unique_ptr<UnresolvedType>> instances;
+    friend class TypeContext;
     explicit UnresolvedType(std::string typeIdentifier);
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -146,7 +148,7 @@ enum class NotYetInferredKind {
 
 class NotYetInferredType : public Type {
 private:
-    static std::unordered_map<NotYetInferredKind, std::unique_ptr<NotYetInferredType>> instances;
+    friend class TypeContext;
     explicit NotYetInferredType(NotYetInferredKind kind)
         : kind(kind)
         , Type(TypeKind::NotYetInferredType)
@@ -154,7 +156,7 @@ private:
     }
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -185,11 +187,11 @@ enum class PrimitiveIntegerKind {
 
 class PrimitiveIntegerType : public Type {
 private:
-    static std::unordered_map<PrimitiveIntegerKind, std::unique_ptr<PrimitiveIntegerType>> instances;
+    friend class TypeContext;
     explicit PrimitiveIntegerType(PrimitiveIntegerKind kind);
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -216,11 +218,11 @@ enum class PrimitiveFloatKind {
 };
 
 class PrimitiveFloatType : public Type {
-    static std::unordered_map<PrimitiveFloatKind, std::unique_ptr<PrimitiveFloatType>> instances;
+    friend class TypeContext;
     explicit PrimitiveFloatType(PrimitiveFloatKind kind);
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -238,20 +240,15 @@ public:
     [[nodiscard]] std::string toString() const override;
 };
 
-struct FunctionSignatureHash {
-    size_t operator()(std::pair<Type*, std::vector<Type*>> const& p) const;
-};
-
 class FunctionType : public Type {
 private:
-    static std::unordered_map<std::pair<Type*, std::vector<Type*>>, std::unique_ptr<FunctionType>,
-        FunctionSignatureHash>
-        instances;
+    friend class TypeContext;
 
-    explicit FunctionType(Type* returnType, std::vector<Type*> argumentTypes);
+    // Note: argumentTypes must point to storage owned by the TypeContext
+    explicit FunctionType(Type* returnType, llvm::ArrayRef<Type*> argumentTypes);
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
@@ -261,21 +258,21 @@ public:
 
     // Ours
     Type* returnType;
-    std::vector<Type*> argumentTypes;
+    llvm::ArrayRef<Type*> argumentTypes;
 
-    static FunctionType* get(Type* returnType, std::vector<Type*> const& argumentTypes);
+    static FunctionType* get(Type* returnType, llvm::ArrayRef<Type*> argumentTypes);
 
     [[nodiscard]] std::string toString() const override;
 };
 
 class BoolType : public Type {
 private:
-    static std::unique_ptr<BoolType> instance;
+    friend class TypeContext;
 
     BoolType();
 
 protected:
-    llvm::Type* doGetLLVMType() const override;
+    llvm::Type* doGetLLVMType(llvm::LLVMContext& context) const override;
 
 public:
     // Static function needed for fast LLVM RTTI
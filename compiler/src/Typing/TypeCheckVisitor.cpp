@@ -3,7 +3,6 @@
 #include "../Diagnostics/Diagnostics.h"
 #include "BinaryOperation.h"
 #include "Type.h"
-#include <cassert>
 #include <charconv>
 #include <cstddef>
 #include <llvm/Support/Casting.h>
@@ -13,17 +12,33 @@
 namespace Ceres::Typing {
 
 // TODO: do this right, when we implement inference
+// Literals have no type until the context coerces them to one. Gives the coerced type to the literals of the expression,
+// however nested, and to the expressions made only of literals. Integer literals that don't fit in it are reported
 void expandCoercion(Type* coerced, AST::Expression& lhs)
 {
-    // TODO: Check if integer literals will fit using IntLiteralExpression::doesLiteralFitInsideType()
-
-    // Assign variable type to all members of expression
-    if (lhs.type != coerced) {
-        lhs.type = coerced;
-        for (auto* const e : lhs.getChildren()) {
-            auto* ee = dynamic_cast<AST::Expression*>(e);
-            assert(ee != nullptr);
-            ee->type = coerced;
+    if (lhs.type == coerced || !llvm::isa<NotYetInferredType>(lhs.type)) {
+        return;
+    }
+    lhs.type = coerced;
+
+    if (auto* literal = llvm::dyn_cast<AST::IntLiteralExpression>(&lhs)) {
+        if (llvm::isa<PrimitiveIntegerType>(coerced) && !literal->doesLiteralFitInsideType()) {
+            Diagnostics::report(literal->sourceSpan, Diag::int_literal_out_of_range, coerced->toString());
+        }
+        return;
+    }
+
+    for (auto* child : lhs.getChildren()) {
+        expandCoercion(coerced, *llvm::cast<AST::Expression>(child));
+    }
+}
+
+// Literals whose value is not used as any type, such as the ones operated with each other, take their default type
+static void expandDefaultType(AST::Expression& expr)
+{
+    if (auto* notYetInferredType = llvm::dyn_cast<NotYetInferredType>(expr.type)) {
+        if (auto maybeType = notYetInferredType->getDefaultType()) {
+            expandCoercion(maybeType.value(), expr);
         }
     }
 }
@@ -99,7 +114,7 @@ void TypeCheckVisitor::visitAssignmentExpression(AST::AssignmentExpression& expr
     ASSERT(expr.expressionRHS != nullptr);
 
     // TODO: Here in the future we will have to check if is LHS
-    auto* identifier = dynamic_cast<AST::IdentifierExpression*>(expr.expressionLHS.get());
+    auto* identifier = llvm::dyn_cast<AST::IdentifierExpression>(expr.expressionLHS);
     if (identifier == nullptr) {
         Log::panic("LHS of an expression is not an identifier");
     }
@@ -158,6 +173,9 @@ void TypeCheckVisitor::visitBinaryOperationExpression(AST::BinaryOperationExpres
         if (coerced != ErrorType::get()) {
             expandCoercion(coerced, *expr.left);
             expandCoercion(coerced, *expr.right);
+            // Note: If both are literals, the operation is done in their default type, which is also the one resTy gives
+            expandDefaultType(*expr.left);
+            expandDefaultType(*expr.right);
         } else {
             Diagnostics::report(
                 expr.sourceSpan, Diag::mismatched_expr, expr.left->type->toString(), expr.right->type->toString());
@@ -266,6 +284,12 @@ void TypeCheckVisitor::visitReturnStatement(AST::ReturnStatement& stm)
     }
 }
 
+void TypeCheckVisitor::visitExpressionStatement(AST::ExpressionStatement& stm)
+{
+    visitChildren(stm);
+    expandDefaultType(*stm.expression);
+}
+
 void TypeCheckVisitor::visitIfStatement(AST::IfStatement& stm)
 {
     visitChildren(stm);
@@ -316,6 +340,11 @@ void TypeCheckVisitor::visitCommaExpression(AST::CommaExpression& expr)
 {
     visitChildren(expr);
 
+    // Only the value of the last expression is used, it gets its type from the context
+    for (size_t i = 0; i + 1 < expr.expressions.size(); i++) {
+        expandDefaultType(*expr.expressions[i]);
+    }
+
     expr.type = expr.expressions.back()->type;
 }
 
@@ -397,7 +426,23 @@ void TypeCheckVisitor::visitCastExpression(AST::CastExpression& expr)
 {
     visitChildren(expr);
 
-    NOT_IMPLEMENTED();
+    // The operand of a cast can be of any type, so literals keep their default type
+    expandDefaultType(*expr.expr);
+
+    if (llvm::isa<ErrorType>(expr.expr->type) || llvm::isa<ErrorType>(expr.destinationType)) {
+        expr.type = ErrorType::get();
+        return;
+    }
+
+    auto isNumeric = [](Type* type) { return llvm::isa<PrimitiveIntegerType, PrimitiveFloatType>(type); };
+    if (!isNumeric(expr.expr->type) || !isNumeric(expr.destinationType)) {
+        Diagnostics::report(
+            expr.sourceSpan, Diag::invalid_cast, expr.expr->type->toString(), expr.destinationType->toString());
+        expr.type = ErrorType::get();
+        return;
+    }
+
+    expr.type = expr.destinationType;
 }
 
 } // namespace Ceres::Typing
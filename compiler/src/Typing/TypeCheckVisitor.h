@@ -1,29 +1,30 @@
 #ifndef COMPILER_TYPECHECKVISITOR_H
 #define COMPILER_TYPECHECKVISITOR_H
 
-#include "../AST/ASTVisitor.h"
+#include "../AST/StaticASTVisitor.hpp"
 #include "../Binding/Scope.h"
 
 namespace Ceres::Typing {
 
-class TypeCheckVisitor : public AST::ASTVisitor {
+class TypeCheckVisitor : public AST::StaticASTVisitor<TypeCheckVisitor> {
 public:
     // Type check
-    void visitVariableDeclaration(AST::VariableDeclaration& decl) override;
-    void visitAssignmentExpression(AST::AssignmentExpression& expr) override;
-    void visitBinaryOperationExpression(AST::BinaryOperationExpression& expr) override;
-    void visitFunctionCallExpression(AST::FunctionCallExpression& expr) override;
-    void visitIdentifierExpression(AST::IdentifierExpression& expr) override;
-    void visitPostfixExpression(AST::PostfixExpression& expr) override;
-    void visitPrefixExpression(AST::PrefixExpression& expr) override;
-    void visitCommaExpression(AST::CommaExpression& expr) override;
-    void visitCastExpression(AST::CastExpression& expr) override;
+    void visitVariableDeclaration(AST::VariableDeclaration& decl);
+    void visitAssignmentExpression(AST::AssignmentExpression& expr);
+    void visitBinaryOperationExpression(AST::BinaryOperationExpression& expr);
+    void visitFunctionCallExpression(AST::FunctionCallExpression& expr);
+    void visitIdentifierExpression(AST::IdentifierExpression& expr);
+    void visitPostfixExpression(AST::PostfixExpression& expr);
+    void visitPrefixExpression(AST::PrefixExpression& expr);
+    void visitCommaExpression(AST::CommaExpression& expr);
+    void visitCastExpression(AST::CastExpression& expr);
 
     // Statements
-    void visitReturnStatement(AST::ReturnStatement& stm) override;
-    void visitIfStatement(AST::IfStatement& stm) override;
-    void visitForStatement(AST::ForStatement& stm) override;
-    void visitWhileStatement(AST::WhileStatement& stm) override;
+    void visitExpressionStatement(AST::ExpressionStatement& stm);
+    void visitReturnStatement(AST::ReturnStatement& stm);
+    void visitIfStatement(AST::IfStatement& stm);
+    void visitForStatement(AST::ForStatement& stm);
+    void visitWhileStatement(AST::WhileStatement& stm);
 };
 } // namespace Ceres::Typing
 
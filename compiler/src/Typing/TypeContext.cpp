@@ -0,0 +1,183 @@
+#include "TypeContext.h"
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/Hashing.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/MathExtras.h>
+#include <algorithm>
+#include <climits>
+
+namespace Ceres {
+
+// DenseSet traits that allow looking up a function type from its signature, without having to create it
+struct FunctionTypeKeyInfo {
+    struct KeyTy {
+        Type* returnType;
+        llvm::ArrayRef<Type*> argumentTypes;
+
+        KeyTy(Type* returnType, llvm::ArrayRef<Type*> argumentTypes)
+            : returnType(returnType)
+            , argumentTypes(argumentTypes)
+        {
+        }
+
+        explicit KeyTy(FunctionType const* type)
+            : returnType(type->returnType)
+            , argumentTypes(type->argumentTypes)
+        {
+        }
+
+        bool operator==(KeyTy const& other) const
+        {
+            return returnType == other.returnType && argumentTypes == other.argumentTypes;
+        }
+    };
+
+    static FunctionType* getEmptyKey() { return llvm::DenseMapInfo<FunctionType*>::getEmptyKey(); }
+    static FunctionType* getTombstoneKey() { return llvm::DenseMapInfo<FunctionType*>::getTombstoneKey(); }
+
+    static unsigned getHashValue(KeyTy const& key)
+    {
+        return llvm::hash_combine(
+            key.returnType, llvm::hash_combine_range(key.argumentTypes.begin(), key.argumentTypes.end()));
+    }
+    static unsigned getHashValue(FunctionType const* type) { return getHashValue(KeyTy(type)); }
+
+    static bool isEqual(KeyTy const& lhs, FunctionType const* rhs)
+    {
+        if (rhs == getEmptyKey() || rhs == getTombstoneKey()) {
+            return false;
+        }
+        return lhs == KeyTy(rhs);
+    }
+    static bool isEqual(FunctionType const* lhs, FunctionType const* rhs) { return lhs == rhs; }
+};
+
+struct TypeContext::Shard {
+    std::mutex mutex;
+    llvm::BumpPtrAllocator allocator;
+    std::vector<Type*> types;
+
+    llvm::DenseSet<FunctionType*, FunctionTypeKeyInfo> functionTypes;
+    llvm::StringMap<UnresolvedType*> unresolvedTypes;
+
+    template<typename T, typename... Args> T* create(Args&&... args)
+    {
+        auto* type = new (allocator.Allocate<T>()) T(std::forward<Args>(args)...);
+        types.push_back(type);
+        return type;
+    }
+};
+
+TypeContext::TypeContext()
+    : shards(new Shard[numShards])
+{
+    voidType = createFixedType<VoidType>();
+    errorType = createFixedType<ErrorType>();
+    boolType = createFixedType<BoolType>();
+
+    for (auto kind : { PrimitiveIntegerKind::I8, PrimitiveIntegerKind::I16, PrimitiveIntegerKind::I32,
+             PrimitiveIntegerKind::I64, PrimitiveIntegerKind::U8, PrimitiveIntegerKind::U16, PrimitiveIntegerKind::U32,
+             PrimitiveIntegerKind::U64 }) {
+        primitiveIntegerTypes[(size_t)kind] = createFixedType<PrimitiveIntegerType>(kind);
+    }
+
+    for (auto kind : { PrimitiveFloatKind::F32, PrimitiveFloatKind::F64 }) {
+        primitiveFloatTypes[(size_t)kind] = createFixedType<PrimitiveFloatType>(kind);
+    }
+
+    for (auto kind : { NotYetInferredKind::IntegerLiteral, NotYetInferredKind::FloatLiteral,
+             NotYetInferredKind::VariableDeclaration, NotYetInferredKind::Expression }) {
+        notYetInferredTypes[(size_t)kind] = createFixedType<NotYetInferredType>(kind);
+    }
+}
+
+TypeContext::~TypeContext()
+{
+    // Note: The arenas release the memory, but the destructors still have to be run
+    for (auto* type : fixedTypes) {
+        type->~Type();
+    }
+
+    for (unsigned i = 0; i < numShards; i++) {
+        for (auto* type : shards[i].types) {
+            type->~Type();
+        }
+    }
+}
+
+template<typename T, typename... Args> T* TypeContext::createFixedType(Args&&... args)
+{
+    auto* type = new (allocator.Allocate<T>()) T(std::forward<Args>(args)...);
+    fixedTypes.push_back(type);
+    return type;
+}
+
+TypeContext& TypeContext::global()
+{
+    static TypeContext context;
+    return context;
+}
+
+PrimitiveIntegerType* TypeContext::getPrimitiveIntegerType(PrimitiveIntegerKind kind) const
+{
+    ASSERT((size_t)kind < primitiveIntegerTypes.size());
+    return primitiveIntegerTypes[(size_t)kind];
+}
+
+PrimitiveFloatType* TypeContext::getPrimitiveFloatType(PrimitiveFloatKind kind) const
+{
+    ASSERT((size_t)kind < primitiveFloatTypes.size());
+    return primitiveFloatTypes[(size_t)kind];
+}
+
+NotYetInferredType* TypeContext::getNotYetInferredType(NotYetInferredKind kind) const
+{
+    ASSERT((size_t)kind < notYetInferredTypes.size());
+    return notYetInferredTypes[(size_t)kind];
+}
+
+UnresolvedType* TypeContext::getUnresolvedType(llvm::StringRef typeIdentifier)
+{
+    auto& shard = shards[llvm::hash_value(typeIdentifier) % numShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto& type = shard.unresolvedTypes[typeIdentifier];
+    if (type == nullptr) {
+        type = shard.create<UnresolvedType>(typeIdentifier.str());
+    }
+    return type;
+}
+
+FunctionType* TypeContext::getFunctionType(Type* returnType, llvm::ArrayRef<Type*> argumentTypes)
+{
+    // Note: The shard is chosen with the highest bits of the hash, the lowest ones are the bucket in the shard's DenseSet
+    static_assert(llvm::isPowerOf2_32(numShards));
+    unsigned shardShift = sizeof(unsigned) * CHAR_BIT - llvm::Log2_32(numShards);
+    FunctionTypeKeyInfo::KeyTy key(returnType, argumentTypes);
+    auto& shard = shards[FunctionTypeKeyInfo::getHashValue(key) >> shardShift];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.functionTypes.find_as(key);
+    if (it != shard.functionTypes.end()) {
+        return *it;
+    }
+
+    // The argument types are copied to the arena, so they live as long as the function type
+    auto* arguments = shard.allocator.Allocate<Type*>(argumentTypes.size());
+    std::uninitialized_copy(argumentTypes.begin(), argumentTypes.end(), arguments);
+
+    auto* type = shard.create<FunctionType>(returnType, llvm::makeArrayRef(arguments, argumentTypes.size()));
+    shard.functionTypes.insert(type);
+    return type;
+}
+
+llvm::Type* LLVMTypeCache::get(Type const* type)
+{
+    auto& llvmType = llvmTypes[type];
+    if (llvmType == nullptr) {
+        llvmType = type->getLLVMType(context);
+    }
+    return llvmType;
+}
+
+} // namespace Ceres
@@ -0,0 +1,82 @@
+#ifndef COMPILER_TYPECONTEXT_H
+#define COMPILER_TYPECONTEXT_H
+
+#include "Type.h"
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ceres {
+
+// Interns all the types used by the compiler, storing them in an arena. It can be used concurrently by the threads
+// compiling different files:
+//  - Types with a fixed set of instances (void, bool, primitives...) are created when the context is created, so
+//    looking them up doesn't need any synchronization
+//  - Types with an unbounded set of instances (functions, unresolved types) are distributed in shards by their hash,
+//    each one with its own lock and arena, so threads only contend when they look up types in the same shard
+class TypeContext {
+    struct Shard;
+    static constexpr unsigned numShards = 16;
+
+    // Arena for the fixed types
+    llvm::BumpPtrAllocator allocator;
+    std::vector<Type*> fixedTypes;
+
+    VoidType* voidType;
+    ErrorType* errorType;
+    BoolType* boolType;
+    std::array<PrimitiveIntegerType*, 8> primitiveIntegerTypes {};
+    std::array<PrimitiveFloatType*, 2> primitiveFloatTypes {};
+    std::array<NotYetInferredType*, 4> notYetInferredTypes {};
+
+    std::unique_ptr<Shard[]> shards;
+
+    template<typename T, typename... Args> T* createFixedType(Args&&... args);
+
+    TypeContext();
+
+public:
+    ~TypeContext();
+
+    TypeContext(TypeContext const&) = delete;
+    TypeContext& operator=(TypeContext const&) = delete;
+
+    // Context shared by the whole compiler
+    static TypeContext& global();
+
+    VoidType* getVoidType() const { return voidType; }
+    ErrorType* getErrorType() const { return errorType; }
+    BoolType* getBoolType() const { return boolType; }
+    PrimitiveIntegerType* getPrimitiveIntegerType(PrimitiveIntegerKind kind) const;
+    PrimitiveFloatType* getPrimitiveFloatType(PrimitiveFloatKind kind) const;
+    NotYetInferredType* getNotYetInferredType(NotYetInferredKind kind) const;
+
+    UnresolvedType* getUnresolvedType(llvm::StringRef typeIdentifier);
+
+    // Note: Looking up an existing function type doesn't allocate
+    FunctionType* getFunctionType(Type* returnType, llvm::ArrayRef<Type*> argumentTypes);
+};
+
+// Caches the LLVM representation of types for a single LLVM context. Types are shared between threads, but an LLVM
+// context is only used by one of them at a time, so each code generator owns the cache for its context
+class LLVMTypeCache {
+    llvm::LLVMContext& context;
+    llvm::DenseMap<Type const*, llvm::Type*> llvmTypes;
+
+public:
+    explicit LLVMTypeCache(llvm::LLVMContext& context)
+        : context(context)
+    {
+    }
+
+    llvm::Type* get(Type const* type);
+};
+
+} // namespace Ceres
+
+#endif // COMPILER_TYPECONTEXT_H
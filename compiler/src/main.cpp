@@ -1,9 +1,9 @@
 #include <iostream>
+#include <optional>
 #include <string>
 
 #include "CeresLexer.h"
 #include "CeresParser.h"
-#include "Flow/FlowCheckVisitor.h"
 #include "Typing/TypeVisitor.h"
 #include "antlr4-runtime.h"
 
@@ -12,17 +12,25 @@
 #include "llvm/IR/Function.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/Pass.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Timer.h"
 
 #include "AST/ASTStringifierVisitor.h"
-#include "AST/ASTVisitor.h"
 #include "AST/AntlrASTGeneratorVisitor.h"
 #include "AST/nodes/CompilationUnit.h"
-#include "Binding/BindingVisitor.h"
 #include "Codegen/CodeGenerator.h"
 #include "Diagnostics/Diagnostics.h"
 #include "Diagnostics/ParserErrorListener.h"
-#include "Typing/TypeCheckVisitor.h"
+#include "Lexer/AntlrTokenSource.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/SemanticPassManager.h"
 #include "utils/InitCeres.h"
 #include "utils/SourceManager.h"
 #include "utils/log.hpp"
@@ -31,69 +39,330 @@ using namespace antlrgenerated;
 using namespace antlr4;
 using namespace Ceres;
 
-int main(int argc, char const* argv[])
+static llvm::cl::OptionCategory ceresCategory("Ceres compiler options");
+
+static llvm::cl::list<std::string> inputFilenames(
+    llvm::cl::Positional, llvm::cl::desc("<input files>"), llvm::cl::OneOrMore, llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<unsigned> numThreads("j",
+    llvm::cl::desc("Number of files to compile in parallel (default: number of hardware threads)"),
+    llvm::cl::value_desc("N"), llvm::cl::init(0), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> parallelSemanticPasses("fparallel-semantic-passes",
+    llvm::cl::desc("Bind and check the functions of each file on several threads (-j in total)"),
+    llvm::cl::init(false), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<unsigned> errorLimit("ferror-limit",
+    llvm::cl::desc("Stop reporting errors in a file after N of them (default: 0, no limit)"), llvm::cl::value_desc("N"),
+    llvm::cl::init(0), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<Codegen::OptimizationLevel> optimizationLevel(llvm::cl::desc("Optimization level:"),
+    llvm::cl::values(clEnumValN(Codegen::OptimizationLevel::O0, "O0", "No optimizations (default)"),
+        clEnumValN(Codegen::OptimizationLevel::O1, "O1", "Enable basic optimizations"),
+        clEnumValN(Codegen::OptimizationLevel::O2, "O2", "Enable default optimizations"),
+        clEnumValN(Codegen::OptimizationLevel::O3, "O3", "Enable aggressive optimizations"),
+        clEnumValN(Codegen::OptimizationLevel::Os, "Os", "Optimize for code size")),
+    llvm::cl::init(Codegen::OptimizationLevel::O0), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> directSSA("fdirect-ssa",
+    llvm::cl::desc("Build SSA form directly for local variables instead of relying on mem2reg"), llvm::cl::init(false),
+    llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<AST::OverflowMode> overflowMode("foverflow",
+    llvm::cl::desc("What integer overflow does, in the functions without an overflow attribute:"),
+    llvm::cl::values(clEnumValN(AST::OverflowMode::Wrap, "wrap", "Wrap around in two's complement (default)"),
+        clEnumValN(AST::OverflowMode::Trap, "trap", "Abort the program"),
+        clEnumValN(AST::OverflowMode::Undefined, "undefined", "Assume it never happens, to optimize better")),
+    llvm::cl::init(AST::OverflowMode::Wrap), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> fastMath("ffast-math",
+    llvm::cl::desc("Enable every floating point optimization that can change the results, and -ffp-contract=fast"),
+    llvm::cl::init(false), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> associativeMath("fassociative-math",
+    llvm::cl::desc("Allow reordering floating point operations, for example to vectorize reductions"),
+    llvm::cl::init(false), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> noHonorNaNs("fno-honor-nans",
+    llvm::cl::desc("Assume that floating point operands and results are never NaN"), llvm::cl::init(false),
+    llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> noHonorInfinities("fno-honor-infinities",
+    llvm::cl::desc("Assume that floating point operands and results are never infinite"), llvm::cl::init(false),
+    llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> noSignedZeros("fno-signed-zeros",
+    llvm::cl::desc("Ignore the sign of floating point zeros"), llvm::cl::init(false), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> reciprocalMath("freciprocal-math",
+    llvm::cl::desc("Allow computing x / y as x * (1 / y)"), llvm::cl::init(false), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<Codegen::FPContractMode> fpContract("ffp-contract",
+    llvm::cl::desc("Fuse floating point multiplications and additions:"),
+    llvm::cl::values(clEnumValN(Codegen::FPContractMode::Off, "off", "Never"),
+        clEnumValN(Codegen::FPContractMode::On, "on", "When they are in the same expression (default)"),
+        clEnumValN(Codegen::FPContractMode::Fast, "fast", "Whenever possible (default with -ffast-math)")),
+    llvm::cl::init(Codegen::FPContractMode::On), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<std::string> targetArch("march",
+    llvm::cl::desc("Target architecture, only 'native' (the host CPU and its features) is supported. An explicit -mcpu "
+                   "overrides the CPU"),
+    llvm::cl::value_desc("arch"), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<std::string> targetCPU("mcpu",
+    llvm::cl::desc("Target a specific CPU type ('native' for the host CPU)"), llvm::cl::value_desc("cpu-name"),
+    llvm::cl::init("generic"), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<std::string> targetFeatures("mattr",
+    llvm::cl::desc("Target specific attributes, appended to the ones implied by -march"),
+    llvm::cl::value_desc("+a1,-a2,..."), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> runJIT("run",
+    llvm::cl::desc("Execute the program in-process using the JIT, instead of emitting an object file"),
+    llvm::cl::init(false), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> timeReport("ftime-report",
+    llvm::cl::desc("Report the time spent in each compilation phase and LLVM pass"), llvm::cl::init(false),
+    llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> twoStageParsing("ftwo-stage-parse",
+    llvm::cl::desc("With the ANTLR parser, parse with SLL prediction first, and only fall back to full LL "
+                   "prediction on a syntax error (default: true)"),
+    llvm::cl::init(true), llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> antlrLexer("fantlr-lexer",
+    llvm::cl::desc("Use the ANTLR generated lexer instead of the hand-written one"), llvm::cl::init(false),
+    llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> antlrParser("fantlr-parser",
+    llvm::cl::desc("Use the ANTLR generated parser instead of the hand-written one"), llvm::cl::init(false),
+    llvm::cl::cat(ceresCategory));
+
+static llvm::cl::list<std::string> disabledSemanticPasses("disable-semantic-pass",
+    llvm::cl::desc(
+        "Don't run a semantic pass (binding, typecheck, flowcheck or consteval), nor the passes that depend on it"),
+    llvm::cl::value_desc("pass"), llvm::cl::CommaSeparated, llvm::cl::Hidden, llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> dumpTokens("dump-tokens", llvm::cl::desc("Print the tokens of the input files and exit"),
+    llvm::cl::init(false), llvm::cl::Hidden, llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> dumpAST("dump-ast", llvm::cl::desc("Print the AST of the input files and exit"),
+    llvm::cl::init(false), llvm::cl::Hidden, llvm::cl::cat(ceresCategory));
+
+static llvm::cl::opt<bool> dumpIR("dump-ir",
+    llvm::cl::desc("Print the LLVM-IR generated for the input files, before optimizing it"), llvm::cl::init(false),
+    llvm::cl::Hidden, llvm::cl::cat(ceresCategory));
+
+// Parses a compilation unit. In two-stage mode, the input is first parsed with the faster SLL prediction mode, bailing
+// out on the first syntax error. Only if that fails, it is parsed again with full LL prediction, which is guaranteed to
+// succeed on valid input and reports and recovers from syntax errors
+static CeresParser::CompilationUnitContext* parseCompilationUnit(
+    CeresParser& parser, ParserErrorListener* parserErrorListener)
 {
-    // Performs initialization and destruction on scope end
-    Ceres::InitCeres ceres;
-    llvm::InitLLVM X(argc, argv);
+    parser.removeErrorListeners();
 
-    if (argc < 2) {
-        std::cout << "Not enough arguments" << std::endl;
-        std::cout << "Usage: '" << argv[0] << "' [filename]" << std::endl;
-        return 1;
+    if (twoStageParsing) {
+        parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::SLL);
+        parser.setErrorHandler(std::make_shared<BailErrorStrategy>());
+
+        try {
+            return parser.compilationUnit();
+        } catch (ParseCancellationException&) {
+            // Either the input has a syntax error, or SLL is not powerful enough for it. Retry in LL mode
+        }
+
+        // Note: This also rewinds the token stream
+        parser.reset();
+        parser.setErrorHandler(std::make_shared<DefaultErrorStrategy>());
+        parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::LL);
     }
 
-    auto& sourceManager = SourceManager::get();
-    unsigned fileId = sourceManager.addSourceFileOrExit(argv[1]);
+    parser.addErrorListener(parserErrorListener);
+    return parser.compilationUnit();
+}
 
-    try {
-        auto const* memoryBuffer = sourceManager.getMemoryBuffer(fileId);
-        ANTLRInputStream input(memoryBuffer->getBufferStart(), memoryBuffer->getBufferSize());
-        CeresLexer lexer(&input);
-        CommonTokenStream tokens(&lexer);
+// When compiling several files, each object file is named after its source file
+static std::string getObjectFilename(std::string const& inputFilename)
+{
+    llvm::SmallString<128> path(inputFilename);
+    llvm::sys::path::replace_extension(path, "o");
+    return std::string(path);
+}
+
+// Lexes a file with the reference ANTLR lexer, converting its tokens to the ones of the hand-written lexer
+static std::vector<Ceres::Lexer::Token> lexWithAntlr(llvm::MemoryBuffer const& memoryBuffer)
+{
+    ANTLRInputStream input(memoryBuffer.getBufferStart(), memoryBuffer.getBufferSize());
+    CeresLexer lexer(&input);
+
+    std::vector<Ceres::Lexer::Token> tokens;
+    for (auto const& token : lexer.getAllTokens()) {
+        // Note: The stop index is inclusive
+        tokens.push_back({ (Ceres::Lexer::TokenKind)token->getType(), (uint32_t)token->getStartIndex(),
+            (uint32_t)(token->getStopIndex() - token->getStartIndex() + 1), (uint32_t)token->getLine(),
+            (uint32_t)token->getCharPositionInLine() });
+    }
+
+    // getAllTokens() doesn't return the EOF token
+    tokens.push_back({ Ceres::Lexer::TokenKind::EndOfFile, (uint32_t)memoryBuffer.getBufferSize(), 0,
+        (uint32_t)lexer.getLine(), (uint32_t)lexer.getCharPositionInLine() });
+    return tokens;
+}
+
+// Prints one token per line, in the same format for both lexers, so their output can be compared
+static void printTokens(std::vector<Ceres::Lexer::Token> const& tokens, llvm::StringRef source)
+{
+    for (auto const& token : tokens) {
+        auto text = token.kind == Ceres::Lexer::TokenKind::EndOfFile ? llvm::StringRef("<EOF>")
+                                                                      : source.substr(token.offset, token.length);
+        llvm::outs() << Ceres::Lexer::getTokenKindName(token.kind) << " '" << text << "' " << token.line << ":"
+                     << token.column << "\n";
+    }
+}
+
+// Prints the source span of each node as offsets into its file, indented by its depth in the tree
+static void printSourceSpans(AST::Node const& node, uint32_t fileStartOffset, unsigned depth = 0)
+{
+    llvm::outs().indent(depth * 2) << node.sourceSpan.startOffset - fileStartOffset << "-"
+                                   << node.sourceSpan.endOffset - fileStartOffset << "\n";
+    for (auto const* child : node.getChildren()) {
+        printSourceSpans(*child, fileStartOffset, depth + 1);
+    }
+}
+
+// Builds the AST with the reference ANTLR parser
+static std::unique_ptr<AST::CompilationUnit> parseWithAntlr(std::vector<Ceres::Lexer::Token> tokens, unsigned fileId,
+    llvm::function_ref<llvm::Timer*(char const*, char const*)> phaseTimer)
+{
+    auto const* memoryBuffer = SourceManager::get().getMemoryBuffer(fileId);
+    Ceres::Lexer::AntlrTokenSource tokenSource(
+        std::move(tokens), memoryBuffer->getBuffer(), memoryBuffer->getBufferIdentifier().str());
+    CommonTokenStream tokenStream(&tokenSource);
+
+    CeresParser parser(&tokenStream);
+    std::unique_ptr<ParserErrorListener> parserErrorListener = std::make_unique<ParserErrorListener>(fileId);
+
+    tree::ParseTree* tree;
+    {
+        llvm::TimeRegion region(phaseTimer("parse", "Parsing"));
+        tokenStream.fill();
+        tree = parseCompilationUnit(parser, parserErrorListener.get());
+    }
+
+    AST::AntlrASTGeneratorVisitor visitor { fileId };
+
+    AST::CompilationUnit* res;
+    {
+        llvm::TimeRegion region(phaseTimer("ast", "AST generation"));
+        res = std::any_cast<AST::CompilationUnit*>(tree->accept(&visitor));
+    }
+    ASSERT(res != nullptr);
 
-        CeresParser parser(&tokens);
-        parser.removeErrorListeners();
+    return std::unique_ptr<AST::CompilationUnit>(res);
+}
+
+// Runs all the compiler phases on a single source file, returning the exit code for it. numFileThreads is the number of
+// threads the file can be checked on with -fparallel-semantic-passes, including the calling one
+static int compileFile(unsigned fileId, Codegen::CodegenOptions const& codegenOptions, unsigned numFileThreads)
+{
+    auto const* memoryBuffer = SourceManager::get().getMemoryBuffer(fileId);
+
+    // Note: Each file has its own timer group, so files compiled in parallel don't share timers
+    llvm::TimerGroup timerGroup("ceres", ("Ceres time report for " + memoryBuffer->getBufferIdentifier()).str());
+    std::vector<std::unique_ptr<llvm::Timer>> timers;
+    auto phaseTimer = [&](char const* name, char const* description) -> llvm::Timer* {
+        if (!timeReport) {
+            return nullptr;
+        }
+        timers.push_back(std::make_unique<llvm::Timer>(name, description, timerGroup));
+        return timers.back().get();
+    };
 
-        std::unique_ptr<ParserErrorListener> parserErrorListener = std::make_unique<ParserErrorListener>(fileId);
-        parser.addErrorListener(parserErrorListener.get());
+    auto printTimeReport = llvm::make_scope_exit([&]() {
+        if (timeReport) {
+            timerGroup.print(Diagnostics::getOutputStream(), true);
+        }
+    });
 
-        tree::ParseTree* tree = parser.compilationUnit();
+    // Note: Declared after the time report, so the diagnostics are printed before it
+    auto flushDiagnostics = llvm::make_scope_exit([]() { Diagnostics::flush(); });
 
-        auto s = tree->toStringTree(&parser);
-        //        Log::debug("Parse tree: {}", s);
+    try {
+        // Note: The ANTLR lexer and parser are kept as reference implementations, for differential testing
+        std::vector<Ceres::Lexer::Token> tokens;
+        {
+            // Lex the whole file upfront, so lexing is not measured as part of parsing
+            llvm::TimeRegion region(phaseTimer("lex", "Lexing"));
+            tokens = antlrLexer ? lexWithAntlr(*memoryBuffer)
+                                : Ceres::Lexer::Lexer(memoryBuffer->getBuffer(), fileId).lex();
+        }
 
-        AST::AntlrASTGeneratorVisitor visitor { fileId };
+        if (dumpTokens) {
+            printTokens(tokens, memoryBuffer->getBuffer());
+            return Diagnostics::getNumErrors() != 0 ? 1 : 0;
+        }
 
-        auto* res = std::any_cast<AST::CompilationUnit*>(tree->accept(&visitor));
-        ASSERT(res != nullptr);
+        std::unique_ptr<AST::CompilationUnit> AST;
+        if (antlrParser) {
+            AST = parseWithAntlr(std::move(tokens), fileId, phaseTimer);
+        } else {
+            llvm::TimeRegion region(phaseTimer("parse", "Parsing"));
+            AST = Ceres::Parser::Parser(tokens, memoryBuffer->getBuffer(), fileId).parseCompilationUnit();
+        }
 
-        auto AST = std::unique_ptr<AST::CompilationUnit>(res);
+        if (dumpAST) {
+            // Note: The stringifier shows the structure of the tree, but not where each node comes from
+            AST::ASTStringifierVisitor stringifierVisitor;
+            llvm::outs() << stringifierVisitor.visit(*AST) << "\n";
+            printSourceSpans(*AST, SourceManager::get().getFileStartOffset(fileId));
+            return Diagnostics::getNumErrors() != 0 ? 1 : 0;
+        }
 
-        Binding::BindingVisitor bindingVisitor;
-        bindingVisitor.visit(*AST);
-        //        Log::info("Binding visitor run!");
+        // Note: Binding, type checking and flow checking are fused into a single walk, each one has its own timer
+        Semantic::SemanticPassManager semanticPassManager(timeReport ? &timerGroup : nullptr);
+        semanticPassManager.setDefaultOverflowMode(codegenOptions.overflowMode);
+        for (auto const& passName : disabledSemanticPasses) {
+            semanticPassManager.setEnabled(*Semantic::getPassByName(passName), false);
+        }
 
-        Typing::TypeCheckVisitor typeCheckVisitor;
-        typeCheckVisitor.visit(*AST);
-        //        Log::info("Type check visitor run!");
+        // Note: The pool can't be the one compiling files in parallel, as this may be running on one of its threads.
+        // The calling thread checks functions too, so the pool only has the rest of the threads of the file
+        std::optional<llvm::ThreadPool> semanticThreadPool;
+        if (parallelSemanticPasses && numFileThreads > 1) {
+            semanticThreadPool.emplace(llvm::hardware_concurrency(numFileThreads - 1));
+            semanticPassManager.setThreadPool(&semanticThreadPool.value());
+        }
+        semanticPassManager.run(*AST);
 
-        Typing::FlowCheckVisitor flowCheckVisitor;
-        flowCheckVisitor.visit(*AST);
-        //        Log::info("Flow check visitor run!");
+        // Print the diagnostics found so far before anything that code generation may print
+        Diagnostics::flush();
 
         // If there's any errors, bail out
         if (Diagnostics::getNumErrors() != 0) {
             return 1;
         }
 
-        // Codegen::CodeGenerator codeGenerator(InitCeres::getLLVMContext());
-        // codeGenerator.generateCode(*AST);
-        //        Log::info("Code generation run!");
+        // Code generation needs the declarations and types found by binding and type checking
+        if (!semanticPassManager.isEnabled(Semantic::PassId::Binding)
+            || !semanticPassManager.isEnabled(Semantic::PassId::TypeCheck)) {
+            return 0;
+        }
+
+        // Note: Each file gets its own LLVM context, so files can be compiled in parallel
+        Codegen::CodeGenerator codeGenerator(
+            llvm::orc::ThreadSafeContext(std::make_unique<llvm::LLVMContext>()), codegenOptions,
+            timeReport ? &timerGroup : nullptr);
+        if (runJIT) {
+            return codeGenerator.runJIT(*AST);
+        }
 
-        // AST::ASTStringifierVisitor stringifierVisitor;
-        // auto str = stringifierVisitor.visit(*AST);
-        // Log::info("AST: {}", str);
+        codeGenerator.generateCode(*AST);
+
+        {
+            // Note: All the nodes are in the arena of the compilation unit, so this is a single release
+            llvm::TimeRegion region(phaseTimer("free-ast", "Freeing the AST"));
+            AST.reset();
+        }
 
         //        class Test : public Ceres::AST::ASTVisitor {
         //            void visitFunctionDefinition(AST::FunctionDefinition &def)
@@ -120,6 +389,121 @@ int main(int argc, char const* argv[])
         //    std::endl;
     } catch (std::exception& e) {
         Log::critical("Uncaught Exception: {}", e.what());
+        return 1;
     }
     return 0;
 }
+
+int main(int argc, char const* argv[])
+{
+    // Performs initialization and destruction on scope end
+    Ceres::InitCeres ceres;
+    llvm::InitLLVM X(argc, argv);
+
+    llvm::cl::HideUnrelatedOptions(ceresCategory);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Ceres compiler\n");
+
+    if (!targetArch.empty() && targetArch != "native") {
+        Log::error("Unsupported target architecture '{}', only -march=native is supported", targetArch.getValue());
+        return 1;
+    }
+
+    for (auto const& passName : disabledSemanticPasses) {
+        if (!Semantic::getPassByName(passName).has_value()) {
+            Log::error("Unknown semantic pass '{}'", passName);
+            return 1;
+        }
+    }
+
+    Diagnostics::setErrorLimit(errorLimit);
+
+    if (runJIT && inputFilenames.size() != 1) {
+        Log::error("--run requires exactly one input file");
+        return 1;
+    }
+
+    Codegen::CodegenOptions codegenOptions;
+    codegenOptions.optimizationLevel = optimizationLevel;
+    codegenOptions.directSSA = directSSA;
+    codegenOptions.overflowMode = overflowMode;
+
+    if (fastMath) {
+        codegenOptions.fastMath = Codegen::FastMathOptions::getFast();
+    }
+    codegenOptions.fastMath.associativeMath |= associativeMath;
+    codegenOptions.fastMath.noNaNs |= noHonorNaNs;
+    codegenOptions.fastMath.noInfinities |= noHonorInfinities;
+    codegenOptions.fastMath.noSignedZeros |= noSignedZeros;
+    codegenOptions.fastMath.reciprocalMath |= reciprocalMath;
+    if (fpContract.getNumOccurrences() > 0) {
+        codegenOptions.fastMath.contract = fpContract;
+    }
+    codegenOptions.timePasses = timeReport;
+    codegenOptions.dumpIR = dumpIR;
+
+    if (targetArch == "native" || targetCPU == "native") {
+        // An explicit -mcpu still chooses the CPU with -march=native, which then only gives the host features
+        bool isExplicitCPU = targetCPU.getNumOccurrences() > 0 && targetCPU != "native";
+        codegenOptions.targetCPU = isExplicitCPU ? targetCPU.getValue() : Codegen::CodeGenerator::getHostCPUName();
+        codegenOptions.targetFeatures = Codegen::CodeGenerator::getHostCPUFeatures();
+    } else {
+        codegenOptions.targetCPU = targetCPU;
+    }
+
+    if (!targetFeatures.empty()) {
+        if (!codegenOptions.targetFeatures.empty()) {
+            codegenOptions.targetFeatures += ",";
+        }
+        codegenOptions.targetFeatures += targetFeatures;
+    }
+
+    // Add all source files before starting to compile them, the source manager is not modified after this point
+    auto& sourceManager = SourceManager::get();
+    std::vector<unsigned> fileIds;
+    for (auto const& inputFilename : inputFilenames) {
+        fileIds.push_back(sourceManager.addSourceFileOrExit(inputFilename));
+    }
+
+    unsigned numAvailableThreads = llvm::hardware_concurrency(numThreads).compute_thread_count();
+    if (fileIds.size() == 1) {
+        // Enables the pass timers of the legacy pass manager, which is still used for emitting object files. They are
+        // global, so with several files the emission passes are only timed as a whole, by the timer group of each file
+        llvm::TimePassesIsEnabled = timeReport;
+        return compileFile(fileIds.front(), codegenOptions, numAvailableThreads);
+    }
+
+    struct FileResult {
+        std::string diagnostics;
+        int exitCode;
+    };
+
+    llvm::ThreadPool threadPool(llvm::hardware_concurrency(numThreads));
+    std::vector<std::shared_future<FileResult>> results;
+
+    // The threads are split among the files compiled at the same time, so checking their functions in parallel doesn't
+    // start more threads than -j says
+    unsigned numFileThreads = numAvailableThreads / std::min<unsigned>(fileIds.size(), numAvailableThreads);
+
+    for (size_t i = 0; i < fileIds.size(); i++) {
+        auto fileOptions = codegenOptions;
+        fileOptions.outputFilename = getObjectFilename(inputFilenames[i]);
+
+        results.push_back(threadPool.async([fileId = fileIds[i], fileOptions, numFileThreads]() {
+            DiagnosticsCapture capture;
+            int exitCode = compileFile(fileId, fileOptions, numFileThreads);
+            return FileResult { capture.getOutput(), exitCode };
+        }));
+    }
+
+    // Print the diagnostics in the order files were given, as soon as each one of them has been compiled
+    int exitCode = 0;
+    for (auto& result : results) {
+        auto const& fileResult = result.get();
+        llvm::errs() << fileResult.diagnostics;
+        if (fileResult.exitCode != 0) {
+            exitCode = 1;
+        }
+    }
+
+    return exitCode;
+}
@@ -1,6 +1,10 @@
 #include "InitCeres.h"
+#include "../Diagnostics/Diagnostics.h"
 #include "log.hpp"
+#include <cstdlib>
 #include <iostream>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
 
 namespace Ceres {
 
@@ -13,16 +17,20 @@ InitCeres::InitCeres()
     }
 
     instance = this;
-    LLVMContext = std::make_unique<llvm::LLVMContext>();
     Log::setupLogging();
-}
 
-InitCeres::~InitCeres() { instance = nullptr; }
+    // Diagnostics are buffered until the end of each file, so print the ones reported before a panic exits the
+    // compiler. errs() is created before registering it, so that it's destroyed after it runs
+    llvm::errs();
+    std::atexit([]() { Diagnostics::flush(); });
 
-llvm::LLVMContext* InitCeres::getLLVMContext()
-{
-    ASSERT(instance != nullptr);
-    return instance->LLVMContext.get();
+    // Register the native target for emitting code. The target registry is global, so this is done once, before any
+    // thread creates a target machine
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmParser();
+    llvm::InitializeNativeTargetAsmPrinter();
 }
 
+InitCeres::~InitCeres() { instance = nullptr; }
+
 } // namespace Ceres
\ No newline at end of file
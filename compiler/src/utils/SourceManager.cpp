@@ -1,4 +1,7 @@
 #include "SourceManager.h"
+#include "SourceSpan.h"
+#include "log.hpp"
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/Support/WithColor.h>
 #include <llvm/Support/raw_ostream.h>
 
@@ -24,6 +27,19 @@ unsigned SourceManager::addSourceFileOrExit(std::string const& fileName)
         exit(1);
     }
 
+    uint32_t startOffset = SourceSpan::invalidOffset + 1;
+    if (!fileStartOffsets.empty()) {
+        auto const* lastBuffer = sourceMgr.getMemoryBuffer(fileStartOffsets.size());
+        startOffset = fileStartOffsets.back() + lastBuffer->getBufferSize() + 1;
+    }
+
+    // Note: All the offsets of the file, including the one past its end, must fit in 32 bits
+    if (fileOrError.get()->getBufferSize() >= UINT32_MAX - startOffset) {
+        llvm::WithColor::error(llvm::errs()) << "couldn't open " << fileName << ": the input files are too large\n";
+        exit(1);
+    }
+
+    fileStartOffsets.push_back(startOffset);
     return sourceMgr.AddNewSourceBuffer(std::move(fileOrError.get()), llvm::SMLoc {});
 }
 llvm::MemoryBuffer const* SourceManager::getMemoryBuffer(unsigned int fileId)
@@ -32,4 +48,32 @@ llvm::MemoryBuffer const* SourceManager::getMemoryBuffer(unsigned int fileId)
 }
 llvm::SourceMgr& SourceManager::getLLVMSourceMgr() { return sourceMgr; }
 
+uint32_t SourceManager::getFileStartOffset(unsigned fileId) const
+{
+    ASSERT(fileId >= 1 && fileId <= fileStartOffsets.size());
+    return fileStartOffsets[fileId - 1];
+}
+
+unsigned SourceManager::getFileId(uint32_t offset) const
+{
+    ASSERT(offset != SourceSpan::invalidOffset);
+    // Note: The files are numbered from 1, in the order of fileStartOffsets
+    return llvm::upper_bound(fileStartOffsets, offset) - fileStartOffsets.begin();
+}
+
+llvm::SMLoc SourceManager::getSMLoc(uint32_t offset) const
+{
+    unsigned fileId = getFileId(offset);
+    char const* bufferStart = sourceMgr.getMemoryBuffer(fileId)->getBufferStart();
+    return llvm::SMLoc::getFromPointer(bufferStart + (offset - getFileStartOffset(fileId)));
+}
+
+uint32_t SourceManager::getOffset(llvm::SMLoc loc) const
+{
+    unsigned fileId = sourceMgr.FindBufferContainingLoc(loc);
+    ASSERT(fileId != 0);
+    char const* bufferStart = sourceMgr.getMemoryBuffer(fileId)->getBufferStart();
+    return getFileStartOffset(fileId) + (loc.getPointer() - bufferStart);
+}
+
 } // namespace Ceres
\ No newline at end of file
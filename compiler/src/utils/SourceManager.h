@@ -2,6 +2,8 @@
 #define COMPILER_SOURCEMANAGER_H
 
 #include "llvm/Support/SourceMgr.h"
+#include <cstdint>
+#include <vector>
 
 namespace Ceres {
 /* Singleton class */
@@ -11,6 +13,11 @@ protected:
 
     static std::unique_ptr<SourceManager> singletonInstance;
 
+    // Global offset of the first character of each file, indexed by fileId - 1. The offsets of a file go from its start
+    // offset to the offset one past its last character, so that the end of the file is a valid location too, and the
+    // next file starts after that. Offset 0 is SourceSpan::invalidOffset and isn't assigned to any file
+    std::vector<uint32_t> fileStartOffsets;
+
 public:
     llvm::SourceMgr sourceMgr;
 
@@ -24,6 +31,20 @@ public:
     unsigned addSourceFileOrExit(std::string const& fileName);
 
     llvm::MemoryBuffer const* getMemoryBuffer(unsigned fileId);
+
+    // Global offset of the first character of the file, to which the offsets inside the file are added to get the ones
+    // of a SourceSpan
+    uint32_t getFileStartOffset(unsigned fileId) const;
+
+    // File containing the given global offset
+    unsigned getFileId(uint32_t offset) const;
+
+    // Location in the buffer of its file of the given global offset
+    llvm::SMLoc getSMLoc(uint32_t offset) const;
+
+    // Global offset of a location in the buffer of one of the files
+    uint32_t getOffset(llvm::SMLoc loc) const;
+
     llvm::SourceMgr& getLLVMSourceMgr();
 };
 } // namespace Ceres
@@ -2,17 +2,11 @@
 
 namespace Ceres {
 
-SourceSpan::SourceSpan(bool isSpanValid)
-    : isSpanValid(isSpanValid)
-{
-}
+SourceSpan SourceSpan::createInvalidSpan() { return SourceSpan {}; }
 
-SourceSpan SourceSpan::createInvalidSpan() { return SourceSpan { false }; }
-SourceSpan::SourceSpan(unsigned int fileId, size_t startCharacterIndex, size_t endCharacterIndex)
-    : fileId(fileId)
-    , startCharacterIndex(startCharacterIndex)
-    , endCharacterIndex(endCharacterIndex)
-    , isSpanValid(true)
+SourceSpan::SourceSpan(uint32_t startOffset, uint32_t endOffset)
+    : startOffset(startOffset)
+    , endOffset(endOffset)
 {
 }
-} // namespace Ceres
\ No newline at end of file
+} // namespace Ceres
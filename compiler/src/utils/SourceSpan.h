@@ -1,31 +1,36 @@
 #ifndef COMPILER_SOURCESPAN_H
 #define COMPILER_SOURCESPAN_H
 
-#include <cstddef>
+#include <cstdint>
 
 namespace Ceres {
 
+// Range of characters of a source file, encoded as two offsets into the global offset space of SourceManager, in which
+// every file is given a contiguous range of offsets. A span is only 8 bytes; the file, line and column of its ends are
+// computed by SourceManager when a diagnostic needs them
 struct SourceSpan {
 
 private:
-    explicit SourceSpan(bool isSpanValid);
+    SourceSpan() = default;
 
 public:
-    // fileId index as managed by SourceManager
-    unsigned fileId = 0;
+    // Offset 0 doesn't belong to any file, and marks the span as invalid
+    static constexpr uint32_t invalidOffset = 0;
 
-    // startCharacterIndex and endCharacterIndex start at 0. They represent the
-    // index into the source char* pointer both ends are inclusive, that is, the
-    // range is represented by [startCharacterIndex, endCharacterIndex]
-    size_t startCharacterIndex = 0, endCharacterIndex = 0;
+    // Global offsets of the first and the last character. Both ends are inclusive, that is, the range is represented by
+    // [startOffset, endOffset]
+    uint32_t startOffset = invalidOffset, endOffset = invalidOffset;
 
-    // Does the span contain valid data? Maybe it doesn't
-    bool isSpanValid;
-
-    SourceSpan(unsigned int fileId, size_t startCharacterIndex, size_t endCharacterIndex);
+    SourceSpan(uint32_t startOffset, uint32_t endOffset);
 
     static SourceSpan createInvalidSpan();
+
+    // Does the span contain valid data? Maybe it doesn't
+    bool isValid() const { return startOffset != invalidOffset; }
 };
+
+static_assert(sizeof(SourceSpan) == 8, "SourceSpan is embedded in every AST node and should be kept small");
+
 } // namespace Ceres
 
 #endif // COMPILER_SOURCESPAN_H
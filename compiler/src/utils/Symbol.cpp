@@ -0,0 +1,92 @@
+#include "Symbol.h"
+#include "log.hpp"
+#include <llvm/ADT/Hashing.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/MathExtras.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace Ceres {
+
+// Global table of the interned identifiers. Like TypeContext, it is split in shards by the hash of the text, each one
+// with its own lock and arena, so threads compiling different files only contend when they intern identifiers that
+// fall in the same shard. A symbol is the index of its text in the shard, followed by the shard number
+class SymbolTable {
+    static constexpr unsigned numShardBits = 4;
+    static constexpr unsigned numShards = 1 << numShardBits;
+
+    // The texts of a shard are stored in chunks of growing size (chunk k holds firstChunkSize << k texts). Chunks
+    // never move, so the text of a symbol can be read without taking the lock.
+    // Note: The indices stay below 2^28 - 256, so the largest ids are free for the DenseMap empty and tombstone keys
+    static constexpr unsigned firstChunkSizeBits = 8;
+    static constexpr unsigned maxChunks = 32 - numShardBits - firstChunkSizeBits;
+
+    struct Shard {
+        std::mutex mutex;
+        // Owns the texts, in its arena
+        llvm::StringMap<uint32_t, llvm::BumpPtrAllocator> indices;
+        std::array<std::atomic<llvm::StringRef*>, maxChunks> chunks {};
+        uint32_t size = 0;
+    };
+
+    std::array<Shard, numShards> shards;
+
+    // Returns the chunk of an index, and the position in it
+    static std::pair<unsigned, uint32_t> locate(uint32_t index)
+    {
+        uint64_t biased = (uint64_t)index + (1U << firstChunkSizeBits);
+        unsigned chunk = llvm::Log2_64(biased) - firstChunkSizeBits;
+        return { chunk, (uint32_t)(biased - (1ULL << (chunk + firstChunkSizeBits))) };
+    }
+
+public:
+    static SymbolTable& global()
+    {
+        static SymbolTable table;
+        return table;
+    }
+
+    ~SymbolTable()
+    {
+        for (auto& shard : shards) {
+            for (auto& chunk : shard.chunks) {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    uint32_t intern(llvm::StringRef text)
+    {
+        unsigned shardIndex = llvm::hash_value(text) % numShards;
+        auto& shard = shards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto [it, inserted] = shard.indices.try_emplace(text, shard.size);
+        if (inserted) {
+            auto [chunk, position] = locate(shard.size);
+            ASSERT(chunk < maxChunks);
+            if (position == 0) {
+                shard.chunks[chunk].store(
+                    new llvm::StringRef[(size_t)1 << (chunk + firstChunkSizeBits)], std::memory_order_release);
+            }
+            shard.chunks[chunk].load(std::memory_order_relaxed)[position] = it->getKey();
+            shard.size++;
+        }
+        return (it->getValue() << numShardBits) | shardIndex;
+    }
+
+    llvm::StringRef getText(uint32_t id) const
+    {
+        auto const& shard = shards[id & (numShards - 1)];
+        auto [chunk, position] = locate(id >> numShardBits);
+        return shard.chunks[chunk].load(std::memory_order_acquire)[position];
+    }
+};
+
+Symbol Symbol::get(llvm::StringRef text) { return Symbol(SymbolTable::global().intern(text)); }
+
+llvm::StringRef Symbol::getText() const { return SymbolTable::global().getText(id); }
+
+} // namespace Ceres
@@ -0,0 +1,55 @@
+#ifndef COMPILER_SYMBOL_H
+#define COMPILER_SYMBOL_H
+
+#include "spdlog/fmt/fmt.h"
+#include <llvm/ADT/DenseMapInfo.h>
+#include <llvm/ADT/StringRef.h>
+#include <cstdint>
+
+namespace Ceres {
+
+// Handle to an interned identifier. Identifiers are interned in a global table when the AST is built, so equal
+// identifiers get the same 32-bit handle: looking them up is an integer compare, and their text is stored only once.
+// Interning is thread-safe, and the text lives until the program exits
+class Symbol {
+    uint32_t id;
+
+    explicit Symbol(uint32_t id)
+        : id(id)
+    {
+    }
+
+    friend struct llvm::DenseMapInfo<Symbol>;
+
+public:
+    static Symbol get(llvm::StringRef text);
+
+    llvm::StringRef getText() const;
+
+    bool operator==(Symbol other) const { return id == other.id; }
+    bool operator!=(Symbol other) const { return id != other.id; }
+};
+
+} // namespace Ceres
+
+namespace llvm {
+
+template<> struct DenseMapInfo<Ceres::Symbol> {
+    static Ceres::Symbol getEmptyKey() { return Ceres::Symbol(~0U); }
+    static Ceres::Symbol getTombstoneKey() { return Ceres::Symbol(~0U - 1); }
+    static unsigned getHashValue(Ceres::Symbol symbol) { return DenseMapInfo<uint32_t>::getHashValue(symbol.id); }
+    static bool isEqual(Ceres::Symbol lhs, Ceres::Symbol rhs) { return lhs == rhs; }
+};
+
+} // namespace llvm
+
+// Allows passing symbols directly to diagnostics and logs
+template<> struct fmt::formatter<Ceres::Symbol> : fmt::formatter<fmt::string_view> {
+    template<typename FormatContext> auto format(Ceres::Symbol symbol, FormatContext& context) const
+    {
+        auto text = symbol.getText();
+        return fmt::formatter<fmt::string_view>::format(fmt::string_view(text.data(), text.size()), context);
+    }
+};
+
+#endif // COMPILER_SYMBOL_H
@@ -118,6 +118,7 @@ OPEN_BRACKETS : '[';
 CLOSE_BRACKETS : ']';
 OPEN_PARENS : '(';
 CLOSE_PARENS : ')';
+HASH : '#';
 
 // Whitespaces
 
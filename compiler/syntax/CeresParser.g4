@@ -12,7 +12,7 @@ globalVarDeclaration
     ;
 
 globalFunctionDefinition
-    : PUB? functionDefinition
+    : attributes? PUB? functionDefinition
     ;
 
 externFunDeclaration
@@ -49,15 +49,15 @@ varDeclaration
     ;
 
 statement
-    : varDeclaration SEMICOLON      # var_decl_statement
-    | returnStatement SEMICOLON     # return_statement
-    | expression SEMICOLON          # expr_statement
-    | functionDefinition            # fn_def_statement
-    | ifStatement                   # if_statement
-    | whileStatement                # while_statement
-    | forStatement                  # for_statement
-    | block                         # block_statement
-    | SEMICOLON                     # empty_statement
+    : varDeclaration SEMICOLON       # var_decl_statement
+    | returnStatement SEMICOLON      # return_statement
+    | expression SEMICOLON           # expr_statement
+    | attributes? functionDefinition # fn_def_statement
+    | ifStatement                    # if_statement
+    | whileStatement                 # while_statement
+    | forStatement                   # for_statement
+    | block                          # block_statement
+    | SEMICOLON                      # empty_statement
     ;
 
 returnStatement
@@ -70,11 +70,20 @@ ifStatement
     ;
 
 whileStatement
-    : WHILE expression block
+    : attributes? WHILE expression block
     ;
 
 forStatement
-    : FOR (varDeclaration | decl_expr=expression)? SEMICOLON (cond_expr=expression)? SEMICOLON (update_expr=expression)? block
+    : attributes? FOR (varDeclaration | decl_expr=expression)? SEMICOLON (cond_expr=expression)? SEMICOLON (update_expr=expression)? block
+    ;
+
+// Attributes of the function or loop that follows, such as #[overflow(trap)] or #[unroll(4), vectorize(disable)]
+attributes
+    : HASH OPEN_BRACKETS attribute (COMMA attribute)* CLOSE_BRACKETS
+    ;
+
+attribute
+    : name=IDENTIFIER OPEN_PARENS argument=(DEC_LITERAL | IDENTIFIER) CLOSE_PARENS
     ;
 
 // Implicit rule precedence (the first that matches)
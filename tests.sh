@@ -1,2 +1,13 @@
 #!/bin/bash
-diff <(./compiler/cmake-build/compiler tests/parser/001.functions.crs) tests/parser/001.functions.out
+# Runs every test script, each one with every test file it applies to, and fails if any of them fails.
+# Usage: ./tests.sh [compiler binary]
+source tests/common.sh
+
+for SCRIPT in tests/lexer/*.sh tests/parser/*.sh tests/typing/*.sh tests/codegen/*.sh; do
+    echo "Running $SCRIPT"
+    if ! "$SCRIPT" "$COMPILER"; then
+        fail "$SCRIPT failed"
+    fi
+done
+
+exit $STATUS
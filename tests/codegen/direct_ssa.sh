@@ -0,0 +1,16 @@
+#!/bin/bash
+# Runs every codegen test with -fdirect-ssa, which builds SSA values for local variables instead of allocas, and checks
+# that the tests that reassign variables in loops and branches don't keep any of them in memory.
+# Usage: tests/codegen/direct_ssa.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests/codegen/pass); do
+    # Note: The IR is printed before optimizing it, so any alloca left would have been generated by the compiler
+    if ! OUTPUT=$("$COMPILER" -fdirect-ssa -dump-ir --run "$FILE"); then
+        fail "$FILE: failed with -fdirect-ssa"
+    elif [[ "$FILE" == */reassign*.crs ]] && grep -q alloca <<< "$OUTPUT"; then
+        fail "$FILE: local variables are allocated in memory with -fdirect-ssa"
+    fi
+done
+
+exit $STATUS
@@ -0,0 +1,18 @@
+#!/bin/bash
+# Runs every codegen test without the constant evaluation pass, so the literals and constant expressions are generated
+# as they are instead of being folded, and checks that the literals that don't fit in their type are still reported.
+# Usage: tests/codegen/disable_constant_evaluation.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests/codegen/pass); do
+    if ! "$COMPILER" -disable-semantic-pass=consteval --run "$FILE" > /dev/null; then
+        fail "$FILE: failed with -disable-semantic-pass=consteval"
+    fi
+done
+
+FILE=tests/typing/fail/int_literal_out_of_range.crs
+if "$COMPILER" -disable-semantic-pass=consteval "$FILE" > /dev/null 2>&1; then
+    fail "$FILE: passed with -disable-semantic-pass=consteval"
+fi
+
+exit $STATUS
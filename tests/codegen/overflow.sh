@@ -0,0 +1,31 @@
+#!/bin/bash
+# Runs every codegen test with each -foverflow mode, and checks that the tests in tests/codegen/trap, whose integer
+# operations overflow, are aborted by a trap with -foverflow=trap. Constant expressions that overflow must be folded
+# without any warning with -foverflow=wrap.
+# Usage: tests/codegen/overflow.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests/codegen/pass); do
+    for MODE in wrap trap undefined; do
+        if ! "$COMPILER" -foverflow="$MODE" --run "$FILE" > /dev/null; then
+            fail "$FILE: failed with -foverflow=$MODE"
+        fi
+    done
+done
+
+for FILE in $(find_tests tests/codegen/trap); do
+    # Note: llvm.trap raises SIGILL on x86 and SIGTRAP on other targets. Other signals don't count, as a division that
+    # overflows without being checked raises SIGFPE on x86
+    "$COMPILER" -foverflow=trap --run "$FILE" > /dev/null 2>&1
+    EXIT_CODE=$?
+    if [ $EXIT_CODE -ne $((128 + 4)) ] && [ $EXIT_CODE -ne $((128 + 5)) ]; then
+        fail "$FILE: exited with $EXIT_CODE instead of trapping with -foverflow=trap"
+    fi
+done
+
+FILE=tests/codegen/trap/constant_overflow.crs
+if ! OUTPUT=$("$COMPILER" -foverflow=wrap --run "$FILE" 2>&1 > /dev/null) || grep -q "warning:" <<< "$OUTPUT"; then
+    fail "$FILE: the constant overflow is not folded silently with -foverflow=wrap"
+fi
+
+exit $STATUS
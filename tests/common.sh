@@ -0,0 +1,14 @@
+# Shared setup of the test scripts, which source it with their arguments: the compiler binary to test is the first one.
+# The scripts report failures with fail and exit with $STATUS
+COMPILER=${1:-./compiler/cmake-build/compiler}
+STATUS=0
+
+# Prints the .crs files found with the given find arguments, sorted so the output is the same on every machine
+find_tests() { find "$@" -name '*.crs' | sort; }
+
+# Prints the message and makes the script fail, without stopping it
+fail()
+{
+    echo "$1" >&2
+    STATUS=1
+}
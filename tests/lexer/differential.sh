@@ -0,0 +1,14 @@
+#!/bin/bash
+# Checks that the hand-written lexer produces the same tokens as the reference ANTLR lexer for every test file.
+# Usage: tests/lexer/differential.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests); do
+    if ! diff -u --label "antlr: $FILE" --label "ceres: $FILE" \
+        <("$COMPILER" -dump-tokens -fantlr-lexer "$FILE" 2> /dev/null) \
+        <("$COMPILER" -dump-tokens "$FILE" 2> /dev/null); then
+        STATUS=1
+    fi
+done
+
+exit $STATUS
@@ -0,0 +1,15 @@
+#!/bin/bash
+# Checks that the hand-written parser builds the same AST, with the same source spans, as the reference ANTLR parser
+# for every test file without syntax errors.
+# Usage: tests/parser/differential.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests -not -path 'tests/parser/fail/*'); do
+    if ! diff -u --label "antlr: $FILE" --label "ceres: $FILE" \
+        <("$COMPILER" -dump-ast -fantlr-parser "$FILE" 2> /dev/null) \
+        <("$COMPILER" -dump-ast "$FILE" 2> /dev/null); then
+        STATUS=1
+    fi
+done
+
+exit $STATUS
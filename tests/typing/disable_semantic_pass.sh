@@ -0,0 +1,25 @@
+#!/bin/bash
+# Checks that -disable-semantic-pass turns off a pass and the passes that depend on it. For every type checking test,
+# disabling type checking must drop some of its errors without reporting new ones, and disabling binding, which type
+# checking depends on, must drop all of them.
+# Usage: tests/typing/disable_semantic_pass.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests/typing/fail); do
+    ERRORS=$("$COMPILER" "$FILE" 2>&1 > /dev/null | grep ": error: ")
+    if [ -z "$ERRORS" ]; then
+        continue
+    fi
+
+    TYPECHECK_DISABLED_ERRORS=$("$COMPILER" -disable-semantic-pass=typecheck "$FILE" 2>&1 > /dev/null | grep ": error: ")
+    if [ "$TYPECHECK_DISABLED_ERRORS" == "$ERRORS" ] \
+        || [ -n "$(comm -13 <(sort <<< "$ERRORS") <(sort <<< "$TYPECHECK_DISABLED_ERRORS"))" ]; then
+        fail "$FILE: -disable-semantic-pass=typecheck doesn't drop only type checking errors"
+    fi
+
+    if "$COMPILER" -disable-semantic-pass=binding "$FILE" 2>&1 > /dev/null | grep -q ": error: "; then
+        fail "$FILE: errors reported with -disable-semantic-pass=binding"
+    fi
+done
+
+exit $STATUS
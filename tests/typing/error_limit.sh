@@ -0,0 +1,24 @@
+#!/bin/bash
+# Checks that -ferror-limit=N prints the first N errors in source order, with their notes, but not the notes of the
+# errors dropped, both when checking the functions on a single thread and in parallel. The output must be the one
+# without a limit, cut before the first dropped error, followed by the message saying that the limit was reached.
+# Usage: tests/typing/error_limit.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+FILE=tests/typing/fail/many_functions.crs
+
+FULL_OUTPUT=$("$COMPILER" "$FILE" 2>&1 > /dev/null)
+
+# Note: The error 5 of the file has a note, so the limits around it check that the note goes with its error
+for LIMIT in 1 4 5 20; do
+    EXPECTED=$(awk -v limit="$LIMIT" '/: error: / && ++errors > limit { exit } { print }' <<< "$FULL_OUTPUT")
+    EXPECTED+=$'\n'"error: too many errors emitted, stopping now [-ferror-limit=$LIMIT]"
+
+    for FLAGS in "" "-j4 -fparallel-semantic-passes"; do
+        if ! diff -u --label "expected: -ferror-limit=$LIMIT $FLAGS" --label "ceres: -ferror-limit=$LIMIT $FLAGS" \
+            <(echo "$EXPECTED") <("$COMPILER" $FLAGS -ferror-limit="$LIMIT" "$FILE" 2>&1 > /dev/null); then
+            STATUS=1
+        fi
+    done
+done
+
+exit $STATUS
@@ -0,0 +1,20 @@
+#!/bin/bash
+# Checks that checking the functions in parallel with -fparallel-semantic-passes prints the same diagnostics, byte for
+# byte, as checking them on a single thread, for every semantic test that fails. Only the files with more functions
+# than a batch, such as tests/typing/fail/many_functions.crs, are actually checked on several threads.
+# Usage: tests/typing/parallel_semantic_passes.sh [compiler binary]
+source "$(dirname "$0")/../common.sh"
+
+for FILE in $(find_tests tests/binding tests/typing tests/control_flow -path '*/fail/*'); do
+    # Note: Repeated, as a difference caused by the scheduling of the threads may not show up on every run
+    for RUN in 1 2 3; do
+        if ! diff -u --label "serial: $FILE" --label "parallel: $FILE" \
+            <("$COMPILER" "$FILE" 2>&1 > /dev/null) \
+            <("$COMPILER" -j4 -fparallel-semantic-passes "$FILE" 2>&1 > /dev/null); then
+            STATUS=1
+            break
+        fi
+    done
+done
+
+exit $STATUS